@@ -6,8 +6,8 @@
  * Student IDs:     S10241866, S10241549
  *
  * Features Highlight:
- *   - Safe string copy using strncpy_s.
- *   - Properly implemented copy constructor and copy assignment.
+ *   - Name stored as a handle into the shared StringArena.
+ *   - Copy constructor and copy assignment copy the handle only.
  *   - Age calculation based on birth year.
  *   - Display function showing actor details including rating.
  ***************************************************************************/
@@ -24,12 +24,11 @@
   * - birthYear = 0
   * - age = 0
   * - rating = 0
-  * - name set to an empty string.
+  * - name and its collation key set to an empty string.
   */
 Actor::Actor()
-    : id(0), birthYear(0), age(0), rating(0)
+    : name(StringArena::shared().intern("")), nameKey(name), id(0), birthYear(0), age(0), rating(0)
 {
-    name[0] = '\0';
 }
 
 /**
@@ -44,37 +43,47 @@ Actor::Actor()
  * @param aid   The actor's unique identifier.
  */
 Actor::Actor(const char* nm, int birth, int aid)
-    : id(aid), birthYear(birth), rating(0)
+    : name(StringArena::shared().intern(nm)), nameKey(makeCollationKey(nm)), id(aid), birthYear(birth), rating(0)
 {
-    if (nm) {
-        strncpy_s(name, sizeof(name), nm, _TRUNCATE);
-    }
-    else {
-        name[0] = '\0';
-    }
-    age = 2025 - birthYear;
+    age = ageForBirthYear(birthYear);
+}
+
+/**
+ * @brief Constructs an Actor from pre-interned name and key handles.
+ *
+ * @param nm   Handle to the name in the shared StringArena.
+ * @param key  Handle to the name's collation key.
+ * @param birth The actor's birth year.
+ * @param aid   The actor's unique identifier.
+ */
+Actor::Actor(StringHandle nm, StringHandle key, int birth, int aid)
+    : name(nm), nameKey(key), id(aid), birthYear(birth), rating(0)
+{
+    age = ageForBirthYear(birthYear);
 }
 
 /**
  * @brief Copy constructor.
  *
- * Creates a new Actor object as a deep copy of an existing Actor object.
+ * Creates a new Actor object from an existing one. The name and key handles are shared,
+ * since interned text is immutable.
  *
  * @param other The Actor object to copy from.
  */
 Actor::Actor(const Actor& other)
-    : id(other.id),
+    : name(other.name),
+    nameKey(other.nameKey),
+    id(other.id),
     birthYear(other.birthYear),
     age(other.age),
     rating(other.rating)
 {
-    strncpy_s(name, sizeof(name), other.name, _TRUNCATE);
 }
 
 /**
  * @brief Copy assignment operator.
  *
- * Assigns the values from one Actor object to this object (deep copy).
+ * Assigns the values from one Actor object to this object, sharing the name handles.
  * Checks for self-assignment before copying.
  *
  * @param other The Actor object to copy from.
@@ -86,7 +95,8 @@ Actor& Actor::operator=(const Actor& other) {
         birthYear = other.birthYear;
         age = other.age;
         rating = other.rating;
-        strncpy_s(name, sizeof(name), other.name, _TRUNCATE);
+        name = other.name;
+        nameKey = other.nameKey;
     }
     return *this;
 }
@@ -115,19 +125,38 @@ void Actor::setId(int newId) {
  * @return A C-string containing the actor's name.
  */
 const char* Actor::getName() const {
+    return StringArena::shared().resolve(name);
+}
+
+/**
+ * @brief Retrieves the handle of the actor's name.
+ *
+ * @return The name handle in the shared StringArena.
+ */
+StringHandle Actor::getNameHandle() const {
     return name;
 }
 
+/**
+ * @brief Retrieves the collation key of the actor's name.
+ *
+ * @return The case-folded key handle.
+ */
+StringHandle Actor::getNameKey() const {
+    return nameKey;
+}
+
 /**
  * @brief Updates the actor's name.
  *
- * Safely updates the actor's name using strncpy_s.
+ * Interns the new name in the shared StringArena and rebuilds its collation key.
  *
  * @param newName A C-string containing the new name.
  */
 void Actor::setName(const char* newName) {
     if (newName) {
-        strncpy_s(name, sizeof(name), newName, _TRUNCATE);
+        name = StringArena::shared().intern(newName);
+        nameKey = makeCollationKey(newName);
     }
 }
 
@@ -149,7 +178,7 @@ int Actor::getBirthYear() const {
  */
 void Actor::setBirthYear(int newYearOfBirth) {
     birthYear = newYearOfBirth;
-    age = 2025 - birthYear;
+    age = ageForBirthYear(birthYear);
 }
 
 /**
@@ -161,6 +190,16 @@ int Actor::getAge() const {
     return age;
 }
 
+/**
+ * @brief Computes the age of an actor born in the given year.
+ *
+ * @param birth The birth year.
+ * @return The age, assuming the current year is 2025.
+ */
+int Actor::ageForBirthYear(int birth) {
+    return 2025 - birth;
+}
+
 /**
  * @brief Displays the actor's details.
  *
@@ -168,7 +207,7 @@ int Actor::getAge() const {
  */
 void Actor::displayDetails() const {
     std::cout << "Actor ID: " << id
-        << ", Name: " << name
+        << ", Name: " << getName()
         << ", Birth Year: " << birthYear
         << ", Age: " << age
         << ", Rating: " << rating
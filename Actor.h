@@ -1,6 +1,8 @@
 #ifndef ACTOR_H
 #define ACTOR_H
 
+#include "StringArena.h"
+#include "Collation.h"
 #include <cstring>
 #include <iostream>
 
@@ -12,8 +14,10 @@
  * Student IDs:     S10241866, S10241549
  *
  * Features Highlight:
- *   - Represents an actor with a fixed-size name buffer, birth year, age, and rating.
- *   - Provides safe copying and assignment operations.
+ *   - Represents an actor with an interned name, birth year, age, and rating.
+ *   - Copying an actor copies a StringHandle, not the name text.
+ *   - Keeps a case-folded collation key for its name, built once whenever
+ *     the name is set.
  *   - Includes functions to get and set actor properties as well as display details.
  *
  ***************************************************************************/
@@ -23,7 +27,8 @@
   */
 class Actor {
 private:
-    char name[100];    ///< Fixed-size buffer for the actor's name
+    StringHandle name; ///< Handle to the actor's name in the shared StringArena
+    StringHandle nameKey; ///< Case-folded collation key of the name
     int id;            ///< Unique identifier for the actor
     int birthYear;     ///< The actor's birth year
     int age;           ///< The actor's age (usually derived from birth year)
@@ -50,6 +55,18 @@ public:
      */
     Actor(const char* nm, int birth, int aid);
 
+    /**
+     * @brief Constructs an Actor from text that is already interned.
+     *
+     * Used by the bulk loaders, which fold and intern names themselves.
+     *
+     * @param nm Handle to the actor's name.
+     * @param key Handle to the name's collation key.
+     * @param birth The actor's birth year.
+     * @param aid The actor's unique identifier.
+     */
+    Actor(StringHandle nm, StringHandle key, int birth, int aid);
+
     /**
      * @brief Copy constructor.
      *
@@ -95,7 +112,23 @@ public:
     const char* getName() const;
 
     /**
-     * @brief Safely updates the actor's name.
+     * @brief Retrieves the handle of the actor's name in the shared StringArena.
+     *
+     * @return The name handle.
+     */
+    StringHandle getNameHandle() const;
+
+    /**
+     * @brief Retrieves the case-folded collation key of the actor's name.
+     *
+     * @return The key handle (see Collation.h).
+     */
+    StringHandle getNameKey() const;
+
+    /**
+     * @brief Updates the actor's name.
+     *
+     * The new text is interned in the shared StringArena.
      *
      * @param newName The new name to assign.
      */
@@ -122,6 +155,14 @@ public:
      */
     int getAge() const;
 
+    /**
+     * @brief Computes the age of an actor born in the given year.
+     *
+     * @param birth The birth year.
+     * @return The age, assuming the current year is 2025.
+     */
+    static int ageForBirthYear(int birth);
+
     /**
      * @brief Displays all details of the actor.
      *
@@ -2,40 +2,23 @@
 #include <cstring>
 #include <iostream>
 #include <cassert>
+#include <limits>
 
 /**
- * @brief Helper function to append an actor ID to a dynamic array.
- *
- * If the array's capacity is reached, its capacity is doubled and the existing
- * elements are copied to a new array.
+ * @brief Constructs an empty BFSQueue.
  *
- * @param arr       Reference to the pointer of the actor IDs array.
- * @param count     Reference to the current count of elements in the array.
- * @param capacity  Reference to the current capacity of the array.
- * @param value     The actor ID value to append.
+ * Initializes the BFS queue with default values: front = 0, rear = -1, and count = 0.
+ * No storage is allocated until the first enqueue.
  */
-static void appendActorId(int*& arr, int& count, int& capacity, int value) {
-    if (count >= capacity) {
-        int newCapacity = capacity * 2;
-        int* newArr = new int[newCapacity];
-        for (int i = 0; i < count; ++i) {
-            newArr[i] = arr[i];
-        }
-        delete[] arr;
-        arr = newArr;
-        capacity = newCapacity;
-    }
-    assert(count < capacity);  // Verify that there is room.
-    arr[count++] = value;
+ActorGraph::BFSQueue::BFSQueue()
+    : data(nullptr), capacity(0), front(0), rear(-1), count(0) {
 }
 
 /**
- * @brief Constructs an empty BFSQueue.
- *
- * Initializes the BFS queue with default values: front = 0, rear = -1, and count = 0.
+ * @brief Destructor.
  */
-ActorGraph::BFSQueue::BFSQueue()
-    : front(0), rear(-1), count(0) {
+ActorGraph::BFSQueue::~BFSQueue() {
+    delete[] data;
 }
 
 /**
@@ -48,33 +31,40 @@ bool ActorGraph::BFSQueue::isEmpty() const {
 }
 
 /**
- * @brief Checks whether the BFS queue is full.
- *
- * The queue is considered full when it reaches a fixed size of 2000 elements.
- *
- * @return true if the queue is full; false otherwise.
+ * @brief Empties the queue without releasing its storage.
  */
-bool ActorGraph::BFSQueue::isFull() const {
-    return (count == 2000);
+void ActorGraph::BFSQueue::clear() {
+    front = 0;
+    rear = -1;
+    count = 0;
 }
 
 /**
  * @brief Enqueues an element into the BFS queue.
  *
  * Adds an element containing an actor index and its BFS depth. If the queue is full,
- * the function returns false.
+ * the buffer is doubled first and the elements are copied to its start in queue order.
  *
  * @param i The actor index to enqueue.
  * @param d The depth associated with the actor.
- * @return true if the element was successfully enqueued; false otherwise.
  */
-bool ActorGraph::BFSQueue::enqueue(int i, int d) {
-    if (isFull()) return false;
-    rear = (rear + 1) % 2000;
+void ActorGraph::BFSQueue::enqueue(int i, int d) {
+    if (count == capacity) {
+        int newCapacity = (capacity > 0) ? capacity * 2 : INITIAL_CAPACITY;
+        Pair* grown = new Pair[newCapacity];
+        for (int k = 0; k < count; ++k) {
+            grown[k] = data[(front + k) % capacity];
+        }
+        delete[] data;
+        data = grown;
+        capacity = newCapacity;
+        front = 0;
+        rear = count - 1;
+    }
+    rear = (rear + 1) % capacity;
     data[rear].idx = i;
     data[rear].depth = d;
     count++;
-    return true;
 }
 
 /**
@@ -88,118 +78,624 @@ bool ActorGraph::BFSQueue::enqueue(int i, int d) {
 bool ActorGraph::BFSQueue::dequeue(Pair& out) {
     if (isEmpty()) return false;
     out = data[front];
-    front = (front + 1) % 2000;
+    front = (front + 1) % capacity;
     count--;
     return true;
 }
 
+/**
+ * @brief Constructs an empty graph.
+ */
+ActorGraph::ActorGraph()
+    : offsets(new long long[1]()),
+    neighbors(nullptr),
+    weights(nullptr),
+    firstYears(nullptr),
+    lastYears(nullptr),
+    trackYears(false),
+    csrVertexCount(0),
+    vertexCount(0),
+    extraEdges(nullptr),
+    extraCounts(nullptr),
+    extraCapacities(nullptr),
+    extraVertexCapacity(0),
+    extraTotal(0),
+    visitStamps(nullptr),
+    discoveredOrder(nullptr),
+    visitCapacity(0),
+    visitEpoch(0),
+    frontierBits(nullptr),
+    frontierWords(0) {
+}
+
+/**
+ * @brief Destructor.
+ */
+ActorGraph::~ActorGraph() {
+    clearExtras();
+    delete[] offsets;
+    delete[] neighbors;
+    delete[] weights;
+    delete[] firstYears;
+    delete[] lastYears;
+    delete[] visitStamps;
+    delete[] discoveredOrder;
+    delete[] frontierBits;
+}
+
+/**
+ * @brief Releases the arrays and leaves an empty graph.
+ */
+void ActorGraph::clear() {
+    clearExtras();
+    delete[] offsets;
+    delete[] neighbors;
+    delete[] weights;
+    delete[] firstYears;
+    delete[] lastYears;
+    offsets = new long long[1]();
+    neighbors = nullptr;
+    weights = nullptr;
+    firstYears = nullptr;
+    lastYears = nullptr;
+    csrVertexCount = 0;
+    vertexCount = 0;
+}
+
+/**
+ * @brief Releases the overflow arrays.
+ */
+void ActorGraph::clearExtras() {
+    for (int v = 0; v < extraVertexCapacity; ++v) {
+        delete[] extraEdges[v];
+    }
+    delete[] extraEdges;
+    delete[] extraCounts;
+    delete[] extraCapacities;
+    extraEdges = nullptr;
+    extraCounts = nullptr;
+    extraCapacities = nullptr;
+    extraVertexCapacity = 0;
+    extraTotal = 0;
+}
+
 /**
  * @brief Builds the actor graph using movie cast information.
  *
- * This function creates a dynamic array of actor IDs and constructs an adjacency list
- * representing the actor graph. Two actors are connected if they have appeared together
- * in a movie.
- *
- * @param actorTable      A hash table containing Actor objects.
- * @param movieTable      A hash table containing Movie objects.
- * @param actorIds        Reference to a pointer that will point to the array of actor IDs.
- * @param actorCount      Reference to an integer that will hold the total number of actors.
- * @param adjacencyLists  Reference to a pointer that will point to the array of adjacency lists.
- */
-void ActorGraph::buildActorGraph(
-    const HashTable<Actor>& actorTable,
-    const HashTable<Movie>& movieTable,
-    int*& actorIds,
-    int& actorCount,
-    List<int>*& adjacencyLists
-) {
-    int capacity = INITIAL_ACTOR_CAPACITY;
-    actorIds = new int[capacity];
-    actorCount = 0;
-
-    // Iterate through each actor in the actor table and store valid actor IDs.
-    actorTable.forEach([&](const Actor& actor) -> bool {
-        if (actor.getId() > 0) {
-            appendActorId(actorIds, actorCount, capacity, actor.getId());
+ * Constructs the CSR arrays indexed by the actor's dense ID in actorTable.
+ * Two actors are connected if they have appeared together in a movie, and
+ * the edge's weight is the number of movies they share.
+ *
+ * @param actorTable      A dense table containing Actor objects.
+ * @param movieTable      A dense table containing Movie objects.
+ * @param withYears       True to record the first and last collaboration year.
+ */
+void ActorGraph::build(const DenseTable<Actor>& actorTable, const DenseTable<Movie>& movieTable, bool withYears) {
+    clear();
+    vertexCount = actorTable.size();
+    csrVertexCount = vertexCount;
+    trackYears = withYears;
+    int movieCount = movieTable.size();
+
+    // Translate every cast into dense IDs once, movie by movie.
+    long long castTotal = 0;
+    for (int m = 0; m < movieCount; ++m) {
+        castTotal += movieTable.at(m).getActors().getSize();
+    }
+    long long* castStart = new long long[movieCount + 1];
+    int* castIds = new int[castTotal > 0 ? castTotal : 1];
+    long long fill = 0;
+    for (int m = 0; m < movieCount; ++m) {
+        castStart[m] = fill;
+        movieTable.at(m).getActors().forEach([&](const Actor& a) {
+            int idx = actorTable.indexOf(a.getId());
+            if (idx != -1) {
+                castIds[fill++] = idx;
+            }
+            return false;
+            });
+    }
+    castStart[movieCount] = fill;
+
+    // Invert the casts into each actor's movies, in movie order. A movie is
+    // listed once per actor even if its cast repeats them.
+    long long* roleStart = new long long[vertexCount + 1]();
+    for (long long i = 0; i < fill; ++i) {
+        ++roleStart[castIds[i] + 1];
+    }
+    for (int v = 0; v < vertexCount; ++v) {
+        roleStart[v + 1] += roleStart[v];
+    }
+    int* roles = new int[fill > 0 ? fill : 1];
+    long long* roleEnd = new long long[vertexCount > 0 ? vertexCount : 1];
+    for (int v = 0; v < vertexCount; ++v) {
+        roleEnd[v] = roleStart[v];
+    }
+    for (int m = 0; m < movieCount; ++m) {
+        for (long long i = castStart[m]; i < castStart[m + 1]; ++i) {
+            int v = castIds[i];
+            if (roleEnd[v] == roleStart[v] || roles[roleEnd[v] - 1] != m) {
+                roles[roleEnd[v]++] = m;
+            }
         }
-        return false;
-        });
+    }
+
+    // seen[u].by == v marks u as already a neighbor of the vertex v being
+    // walked; seen[u].slot is then its entry's position in v's range. The
+    // two are kept side by side so a lookup touches one cache line.
+    struct Seen {
+        int by;
+        int slot;
+    };
+    Seen* seen = new Seen[vertexCount > 0 ? vertexCount : 1];
+
+    // Pass 1: count each vertex's distinct co-stars.
+    delete[] offsets;
+    offsets = new long long[vertexCount + 1];
+    offsets[0] = 0;
+    for (int v = 0; v < vertexCount; ++v) {
+        seen[v].by = -1;
+    }
+    for (int v = 0; v < vertexCount; ++v) {
+        long long degree = 0;
+        for (long long r = roleStart[v]; r < roleEnd[v]; ++r) {
+            int m = roles[r];
+            for (long long i = castStart[m]; i < castStart[m + 1]; ++i) {
+                int u = castIds[i];
+                if (u != v && seen[u].by != v) {
+                    seen[u].by = v;
+                    ++degree;
+                }
+            }
+        }
+        offsets[v + 1] = offsets[v] + degree;
+    }
+
+    // Pass 2: write each co-star at its first shared movie and weight it by
+    // the shared movies that follow.
+    long long neighborTotal = offsets[vertexCount];
+    long long entries = neighborTotal > 0 ? neighborTotal : 1;
+    neighbors = new int[entries];
+    weights = new unsigned short[entries];
+    if (trackYears) {
+        firstYears = new short[entries];
+        lastYears = new short[entries];
+    }
+    for (int v = 0; v < vertexCount; ++v) {
+        seen[v].by = -1;
+    }
+    for (int v = 0; v < vertexCount; ++v) {
+        long long base = offsets[v];
+        int degree = 0;
+        for (long long r = roleStart[v]; r < roleEnd[v]; ++r) {
+            int m = roles[r];
+            short year = trackYears ? static_cast<short>(movieTable.at(m).getReleaseYear()) : 0;
+            for (long long i = castStart[m]; i < castStart[m + 1]; ++i) {
+                int u = castIds[i];
+                if (u == v) {
+                    continue;
+                }
+                if (seen[u].by != v) {
+                    seen[u].by = v;
+                    seen[u].slot = degree;
+                    neighbors[base + degree] = u;
+                    weights[base + degree] = 1;
+                    if (trackYears) {
+                        firstYears[base + degree] = year;
+                        lastYears[base + degree] = year;
+                    }
+                    ++degree;
+                }
+                else {
+                    long long e = base + seen[u].slot;
+                    if (weights[e] < MAX_EDGE_WEIGHT) {
+                        ++weights[e];
+                    }
+                    if (trackYears) {
+                        if (year < firstYears[e]) firstYears[e] = year;
+                        if (year > lastYears[e]) lastYears[e] = year;
+                    }
+                }
+            }
+        }
+    }
+    delete[] seen;
+    delete[] roleEnd;
+    delete[] roles;
+    delete[] roleStart;
+    delete[] castIds;
+    delete[] castStart;
+}
+
+/**
+ * @brief Returns the number of vertices.
+ *
+ * @return int The vertex count.
+ */
+int ActorGraph::getVertexCount() const {
+    return vertexCount;
+}
+
+/**
+ * @brief Returns the number of neighbor entries.
+ *
+ * @return long long The CSR and overflow entries.
+ */
+long long ActorGraph::getNeighborCount() const {
+    return offsets[csrVertexCount] + extraTotal;
+}
 
-    // Initialize adjacency lists for all actors.
-    adjacencyLists = new List<int>[actorCount];
+/**
+ * @brief Returns the memory held by the graph.
+ *
+ * @return unsigned long long Bytes allocated for the CSR and overflow arrays.
+ */
+unsigned long long ActorGraph::getBytes() const {
+    unsigned long long entryBytes = sizeof(int) + sizeof(unsigned short) + (trackYears ? 2 * sizeof(short) : 0);
+    unsigned long long bytes = sizeof(long long) * (static_cast<unsigned long long>(csrVertexCount) + 1)
+        + entryBytes * static_cast<unsigned long long>(offsets[csrVertexCount]);
+    for (int v = 0; v < extraVertexCapacity; ++v) {
+        bytes += sizeof(ExtraEdge) * static_cast<unsigned long long>(extraCapacities[v]);
+    }
+    return bytes + (sizeof(ExtraEdge*) + 2 * sizeof(int)) * static_cast<unsigned long long>(extraVertexCapacity);
+}
 
-    // Build graph edges based on movie cast connections.
-    movieTable.forEach([&](const Movie& mov) -> bool {
-        static const int TEMP_SIZE = 300;
-        int* tmpIdx = new int[TEMP_SIZE];
-        int tmpCount = 0;
+/**
+ * @brief Returns the number of distinct co-stars of a vertex.
+ *
+ * @param v The vertex.
+ * @return int The degree.
+ */
+int ActorGraph::getDegree(int v) const {
+    if (v < 0 || v >= vertexCount) {
+        return 0;
+    }
+    long long degree = (v < csrVertexCount) ? offsets[v + 1] - offsets[v] : 0;
+    if (v < extraVertexCapacity) {
+        degree += extraCounts[v];
+    }
+    return static_cast<int>(degree);
+}
 
-        // For each actor in the movie, find its index in the actorIds array.
-        mov.getActors().forEach([&](const Actor& a) {
-            int idx = findActorIndexInArray(a.getId(), actorIds, actorCount);
-            if (idx != -1 && tmpCount < TEMP_SIZE) {
-                tmpIdx[tmpCount++] = idx;
+/**
+ * @brief Calls a function on each neighbor of a vertex until it returns true.
+ *
+ * @param v The vertex.
+ * @param visit Called for each neighbor; returning true stops the walk.
+ * @return bool True if the walk was stopped.
+ */
+template <typename Visit>
+bool ActorGraph::forEachNeighbor(int v, Visit visit) const {
+    if (v < csrVertexCount) {
+        for (long long e = offsets[v]; e < offsets[v + 1]; ++e) {
+            if (visit(neighbors[e])) {
+                return true;
             }
-            return false;
-            });
+        }
+    }
+    if (v < extraVertexCapacity) {
+        for (int i = 0; i < extraCounts[v]; ++i) {
+            if (visit(extraEdges[v][i].neighbor)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
 
-        // Create bidirectional connections between actors who starred together.
-        for (int i = 0; i < tmpCount; i++) {
-            for (int j = i + 1; j < tmpCount; j++) {
-                adjacencyLists[tmpIdx[i]].add(tmpIdx[j]);
-                adjacencyLists[tmpIdx[j]].add(tmpIdx[i]);
+/**
+ * @brief Checks whether the graph records collaboration years.
+ *
+ * @return bool True if built with years.
+ */
+bool ActorGraph::hasCollaborationYears() const {
+    return trackYears;
+}
+
+/**
+ * @brief Finds the CSR or overflow entry of one edge.
+ *
+ * @param a The vertex whose entries are searched.
+ * @param b The neighbor to look for.
+ * @param csrEntry Receives the CSR entry index, or -1.
+ * @param extraEntry Receives the index in a's overflow array, or -1.
+ * @return bool True if the edge exists.
+ */
+bool ActorGraph::findEdge(int a, int b, long long& csrEntry, int& extraEntry) const {
+    csrEntry = -1;
+    extraEntry = -1;
+    if (a < 0 || a >= vertexCount) {
+        return false;
+    }
+    if (a < csrVertexCount) {
+        for (long long e = offsets[a]; e < offsets[a + 1]; ++e) {
+            if (neighbors[e] == b) {
+                csrEntry = e;
+                return true;
+            }
+        }
+    }
+    if (a < extraVertexCapacity) {
+        for (int i = 0; i < extraCounts[a]; ++i) {
+            if (extraEdges[a][i].neighbor == b) {
+                extraEntry = i;
+                return true;
             }
         }
+    }
+    return false;
+}
+
+/**
+ * @brief Returns how many movies two actors share.
+ *
+ * @param a One actor's dense ID.
+ * @param b The other actor's dense ID.
+ * @return int The edge weight, or 0 if not linked.
+ */
+int ActorGraph::getSharedMovieCount(int a, int b) const {
+    long long csrEntry;
+    int extraEntry;
+    if (!findEdge(a, b, csrEntry, extraEntry)) {
+        return 0;
+    }
+    return (extraEntry != -1) ? extraEdges[a][extraEntry].weight : weights[csrEntry];
+}
+
+/**
+ * @brief Returns the first and last release years of the movies two actors share.
+ *
+ * @param a One actor's dense ID.
+ * @param b The other actor's dense ID.
+ * @param firstYear Receives the earliest year.
+ * @param lastYear Receives the latest year.
+ * @return bool True if the actors are linked and years are recorded.
+ */
+bool ActorGraph::getCollaborationYears(int a, int b, int& firstYear, int& lastYear) const {
+    long long csrEntry;
+    int extraEntry;
+    if (!trackYears || !findEdge(a, b, csrEntry, extraEntry)) {
+        return false;
+    }
+    firstYear = (extraEntry != -1) ? extraEdges[a][extraEntry].firstYear : firstYears[csrEntry];
+    lastYear = (extraEntry != -1) ? extraEdges[a][extraEntry].lastYear : lastYears[csrEntry];
+    return true;
+}
+
+/**
+ * @brief Makes sure the graph has at least a given number of vertices.
+ *
+ * @param count The number of vertices needed.
+ */
+void ActorGraph::ensureVertexCount(int count) {
+    if (count > vertexCount) {
+        vertexCount = count;
+    }
+}
+
+/**
+ * @brief Appends a neighbor to a vertex's overflow array, growing the
+ *        per-vertex tables and the array itself by doubling.
+ *
+ * @param vertex The vertex.
+ * @param neighbor The new neighbor.
+ * @param year Release year of the shared movie (0 if unknown).
+ */
+void ActorGraph::appendExtra(int vertex, int neighbor, int year) {
+    if (vertex >= extraVertexCapacity) {
+        int newCapacity = (extraVertexCapacity > 0) ? extraVertexCapacity : INITIAL_ACTOR_CAPACITY;
+        while (newCapacity <= vertex) {
+            newCapacity *= 2;
+        }
+        ExtraEdge** newEdges = new ExtraEdge* [newCapacity]();
+        int* newCounts = new int[newCapacity]();
+        int* newCapacities = new int[newCapacity]();
+        for (int v = 0; v < extraVertexCapacity; ++v) {
+            newEdges[v] = extraEdges[v];
+            newCounts[v] = extraCounts[v];
+            newCapacities[v] = extraCapacities[v];
+        }
+        delete[] extraEdges;
+        delete[] extraCounts;
+        delete[] extraCapacities;
+        extraEdges = newEdges;
+        extraCounts = newCounts;
+        extraCapacities = newCapacities;
+        extraVertexCapacity = newCapacity;
+    }
+    if (extraCounts[vertex] == extraCapacities[vertex]) {
+        int newCapacity = (extraCapacities[vertex] > 0) ? extraCapacities[vertex] * 2 : 4;
+        ExtraEdge* grown = new ExtraEdge[newCapacity];
+        for (int i = 0; i < extraCounts[vertex]; ++i) {
+            grown[i] = extraEdges[vertex][i];
+        }
+        delete[] extraEdges[vertex];
+        extraEdges[vertex] = grown;
+        extraCapacities[vertex] = newCapacity;
+    }
+    short y = trackYears ? static_cast<short>(year) : 0;
+    extraEdges[vertex][extraCounts[vertex]++] = { neighbor, 1, y, y };
+    ++extraTotal;
+}
 
-        delete[] tmpIdx;
+/**
+ * @brief Counts one more shared movie on an existing entry of a vertex.
+ *
+ * @param vertex The vertex.
+ * @param neighbor The neighbor to look for.
+ * @param year Release year of the shared movie (0 if unknown).
+ * @return bool True if the entry existed.
+ */
+bool ActorGraph::strengthenEdge(int vertex, int neighbor, int year) {
+    long long csrEntry;
+    int extraEntry;
+    if (!findEdge(vertex, neighbor, csrEntry, extraEntry)) {
         return false;
-        });
+    }
+    short y = static_cast<short>(year);
+    if (extraEntry != -1) {
+        ExtraEdge& extra = extraEdges[vertex][extraEntry];
+        if (extra.weight < MAX_EDGE_WEIGHT) {
+            ++extra.weight;
+        }
+        if (trackYears) {
+            if (y < extra.firstYear) extra.firstYear = y;
+            if (y > extra.lastYear) extra.lastYear = y;
+        }
+    }
+    else {
+        if (weights[csrEntry] < MAX_EDGE_WEIGHT) {
+            ++weights[csrEntry];
+        }
+        if (trackYears) {
+            if (y < firstYears[csrEntry]) firstYears[csrEntry] = y;
+            if (y > lastYears[csrEntry]) lastYears[csrEntry] = y;
+        }
+    }
+    return true;
 }
 
 /**
- * @brief Finds the index of an actor in the actorIds array.
+ * @brief Links two actors who now share a movie.
  *
- * Searches through the actorIds array for a given actor ID.
+ * @param a One actor's dense ID.
+ * @param b The other actor's dense ID.
+ * @param year Release year of the shared movie (0 if unknown).
+ */
+void ActorGraph::addEdge(int a, int b, int year) {
+    if (a < 0 || b < 0 || a == b) {
+        return;
+    }
+    ensureVertexCount((a > b ? a : b) + 1);
+    // Both directions are always updated together, so one lookup decides.
+    if (strengthenEdge(a, b, year)) {
+        strengthenEdge(b, a, year);
+        return;
+    }
+    appendExtra(a, b, year);
+    appendExtra(b, a, year);
+    // Compacting once the overflow is a quarter of the CSR entries keeps the
+    // copying amortized O(1) per edge.
+    if (extraTotal > MIN_COMPACT_ENTRIES && extraTotal * 4 > offsets[csrVertexCount]) {
+        compact();
+    }
+}
+
+/**
+ * @brief Rebuilds the CSR arrays with the overflow entries folded in.
+ */
+void ActorGraph::compact() {
+    long long* newOffsets = new long long[vertexCount + 1];
+    newOffsets[0] = 0;
+    for (int v = 0; v < vertexCount; ++v) {
+        long long degree = (v < csrVertexCount) ? offsets[v + 1] - offsets[v] : 0;
+        if (v < extraVertexCapacity) {
+            degree += extraCounts[v];
+        }
+        newOffsets[v + 1] = newOffsets[v] + degree;
+    }
+    long long entries = newOffsets[vertexCount] > 0 ? newOffsets[vertexCount] : 1;
+    int* newNeighbors = new int[entries];
+    unsigned short* newWeights = new unsigned short[entries];
+    short* newFirstYears = trackYears ? new short[entries] : nullptr;
+    short* newLastYears = trackYears ? new short[entries] : nullptr;
+    for (int v = 0; v < vertexCount; ++v) {
+        long long fill = newOffsets[v];
+        if (v < csrVertexCount) {
+            for (long long e = offsets[v]; e < offsets[v + 1]; ++e, ++fill) {
+                newNeighbors[fill] = neighbors[e];
+                newWeights[fill] = weights[e];
+                if (trackYears) {
+                    newFirstYears[fill] = firstYears[e];
+                    newLastYears[fill] = lastYears[e];
+                }
+            }
+        }
+        if (v < extraVertexCapacity) {
+            for (int i = 0; i < extraCounts[v]; ++i, ++fill) {
+                const ExtraEdge& extra = extraEdges[v][i];
+                newNeighbors[fill] = extra.neighbor;
+                newWeights[fill] = extra.weight;
+                if (trackYears) {
+                    newFirstYears[fill] = extra.firstYear;
+                    newLastYears[fill] = extra.lastYear;
+                }
+            }
+        }
+    }
+    clearExtras();
+    delete[] offsets;
+    delete[] neighbors;
+    delete[] weights;
+    delete[] firstYears;
+    delete[] lastYears;
+    offsets = newOffsets;
+    neighbors = newNeighbors;
+    weights = newWeights;
+    firstYears = newFirstYears;
+    lastYears = newLastYears;
+    csrVertexCount = vertexCount;
+}
+
+/**
+ * @brief Starts a search by moving to a new visit stamp.
  *
- * @param actorId  The actor ID to search for.
- * @param actorIds The array of actor IDs.
- * @param count    The number of elements in the actorIds array.
- * @return The index of the actor if found; -1 otherwise.
+ * The stamp and discovery order arrays follow the largest search so far,
+ * which can grow through addEdge() or a larger generated graph. A fresh or
+ * regrown stamp array is all zeros, and so is one whose stamps have run
+ * out, after which counting starts again at 1.
+ *
+ * @param vertices The number of vertices the search can reach.
+ * @return int The new stamp.
  */
-int ActorGraph::findActorIndexInArray(int actorId, const int actorIds[], int count) {
-    for (int i = 0; i < count; i++) {
-        if (actorIds[i] == actorId) {
-            return i;
+int ActorGraph::beginVisit(int vertices) const {
+    if (visitCapacity < vertices) {
+        delete[] visitStamps;
+        delete[] discoveredOrder;
+        visitCapacity = vertices;
+        visitStamps = new int[visitCapacity] {};
+        discoveredOrder = new int[visitCapacity];
+        visitEpoch = 0;
+    }
+    if (visitEpoch == std::numeric_limits<int>::max()) {
+        for (int v = 0; v < visitCapacity; ++v) {
+            visitStamps[v] = 0;
         }
+        visitEpoch = 0;
     }
-    return -1;
+    return ++visitEpoch;
 }
 
 /**
  * @brief Finds all actors connected to the start actor within a specified depth using BFS.
  *
  * Performs a breadth-first search (BFS) on the actor graph starting from a given actor index.
- * It returns a list of actor indices that are reachable within the given maximum depth.
+ * It returns a list of actor dense IDs that are reachable within the given maximum depth.
+ * Discovered vertices are collected in the graph's discovery order array and
+ * added to the list in one call, since each List::add walks the whole list.
+ * The queue is the graph's frontier, which grows as needed and keeps its
+ * buffer for the next search, and a vertex is visited when its stamp equals
+ * this search's stamp.
  *
  * @param startIndex     The starting index for the BFS.
- * @param adjacencyLists The array of adjacency lists representing the actor graph.
- * @param actorCount     The total number of actors in the graph.
  * @param maxDepth       The maximum depth to search.
  * @return A list of actor indices that are connected to the starting actor.
  */
-List<int> ActorGraph::findConnectedActors(
-    int startIndex,
-    const List<int>* adjacencyLists,
-    int actorCount,
-    int maxDepth
-) {
+List<int> ActorGraph::findConnectedActors(int startIndex, int maxDepth) const {
     List<int> discoveredIndices;
-    bool* visited = new bool[actorCount] {};  // All elements are initialized to false.
-    BFSQueue queue;
+    if (startIndex < 0 || startIndex >= vertexCount) {
+        return discoveredIndices;
+    }
+    int stamp = beginVisit(vertexCount);
+    int* visited = visitStamps;
+    int* discovered = discoveredOrder;  // Only the first discoveredCount entries are touched.
+    int discoveredCount = 0;
+    BFSQueue& queue = frontier;
+    queue.clear();
 
     // Start the BFS from the startIndex.
     queue.enqueue(startIndex, 0);
-    visited[startIndex] = true;
+    visited[startIndex] = stamp;
 
     while (!queue.isEmpty()) {
         BFSQueue::Pair current;
@@ -209,19 +705,174 @@ List<int> ActorGraph::findConnectedActors(
         int curIdx = current.idx;
         int curDepth = current.depth;
 
-        // If the current depth is less than the maximum, explore adjacent nodes.
+        // If the current depth is less than the maximum, explore adjacent nodes:
+        // the CSR range first, then any edges added since the last compaction.
         if (curDepth < maxDepth) {
-            adjacencyLists[curIdx].forEach([&](int neighborIdx) {
-                if (!visited[neighborIdx]) {
-                    visited[neighborIdx] = true;
-                    discoveredIndices.add(neighborIdx);
+            auto visit = [&](int neighborIdx) {
+                if (visited[neighborIdx] != stamp) {
+                    visited[neighborIdx] = stamp;
+                    discovered[discoveredCount++] = neighborIdx;
                     queue.enqueue(neighborIdx, curDepth + 1);
                 }
-                return false;
-                });
+            };
+            if (curIdx < csrVertexCount) {
+                for (long long e = offsets[curIdx]; e < offsets[curIdx + 1]; ++e) {
+                    visit(neighbors[e]);
+                }
+            }
+            if (curIdx < extraVertexCapacity) {
+                for (int i = 0; i < extraCounts[curIdx]; ++i) {
+                    visit(extraEdges[curIdx][i].neighbor);
+                }
+            }
+        }
+    }
+
+    discoveredIndices.addAll(discovered, discoveredCount);
+    return discoveredIndices;
+}
+
+/**
+ * @brief Finds all actors connected to the start actor with a direction-optimizing BFS.
+ *
+ * The levels are kept back to back in the discovery order array, the start vertex first,
+ * so the current frontier is always the range the previous step appended.
+ * Edge counts for the switching rule come from the degrees: the frontier's
+ * edges are summed as its vertices are found, and the unexplored edges are
+ * all entries minus the degrees of every vertex visited so far.
+ *
+ * @param startIndex     The starting index for the BFS.
+ * @param maxDepth       The maximum depth to search.
+ * @return A list of actor indices that are connected to the starting actor.
+ */
+List<int> ActorGraph::findConnectedActorsDirectionOptimizing(int startIndex, int maxDepth) const {
+    List<int> discoveredIndices;
+    if (startIndex < 0 || startIndex >= vertexCount) {
+        return discoveredIndices;
+    }
+    int stamp = beginVisit(vertexCount);
+    int* visited = visitStamps;
+    int words = (vertexCount + 63) / 64;
+    if (frontierWords < words) {
+        delete[] frontierBits;
+        frontierBits = new unsigned long long[words] {};
+        frontierWords = words;
+    }
+    int* levels = discoveredOrder;  // Only the first levelEnd entries are touched.
+    int levelStart = 0;
+    int levelEnd = 1;
+    levels[0] = startIndex;
+    visited[startIndex] = stamp;
+    long long frontierEdges = getDegree(startIndex);
+    long long unexploredEdges = getNeighborCount() - frontierEdges;
+    bool bottomUp = false;
+
+    for (int depth = 0; depth < maxDepth && levelStart < levelEnd; ++depth) {
+        int frontierSize = levelEnd - levelStart;
+        if (!bottomUp && frontierEdges > unexploredEdges / BOTTOM_UP_ALPHA) {
+            bottomUp = true;
+        }
+        else if (bottomUp && frontierSize < vertexCount / TOP_DOWN_BETA) {
+            bottomUp = false;
+        }
+        int nextEnd = levelEnd;
+        long long nextEdges = 0;
+        if (bottomUp) {
+            for (int i = levelStart; i < levelEnd; ++i) {
+                frontierBits[levels[i] >> 6] |= 1ULL << (levels[i] & 63);
+            }
+            for (int v = 0; v < vertexCount; ++v) {
+                if (visited[v] == stamp) {
+                    continue;
+                }
+                bool found = forEachNeighbor(v, [&](int u) {
+                    return (frontierBits[u >> 6] >> (u & 63)) & 1ULL;
+                    });
+                if (found) {
+                    visited[v] = stamp;
+                    levels[nextEnd++] = v;
+                    nextEdges += getDegree(v);
+                }
+            }
+            for (int i = levelStart; i < levelEnd; ++i) {
+                frontierBits[levels[i] >> 6] = 0;
+            }
+        }
+        else {
+            for (int i = levelStart; i < levelEnd; ++i) {
+                forEachNeighbor(levels[i], [&](int u) {
+                    if (visited[u] != stamp) {
+                        visited[u] = stamp;
+                        levels[nextEnd++] = u;
+                        nextEdges += getDegree(u);
+                    }
+                    return false;
+                    });
+            }
+        }
+        unexploredEdges -= nextEdges;
+        frontierEdges = nextEdges;
+        levelStart = levelEnd;
+        levelEnd = nextEnd;
+    }
+
+    discoveredIndices.addAll(levels + 1, levelEnd - 1);
+    return discoveredIndices;
+}
+
+/**
+ * @brief Finds all actors connected to the start actor using BFS over generated edges.
+ *
+ * Runs on the graph's visit stamps, discovery order array and frontier
+ * queue like the member version; each neighbor is visited as the generator
+ * produces it, so no per-vertex list is built.
+ *
+ * @param startIndex     The starting vertex.
+ * @param actorCount     The total number of vertices.
+ * @param maxDepth       The maximum depth to search.
+ * @param neighbors      Calls its second argument once per neighbor of a vertex.
+ * @return A list of vertices that are connected to the starting actor.
+ */
+List<int> ActorGraph::findConnectedActors(
+    int startIndex,
+    int actorCount,
+    int maxDepth,
+    const std::function<void(int, const std::function<void(int)>&)>& neighbors
+) const {
+    List<int> discoveredIndices;
+    if (startIndex < 0 || startIndex >= actorCount) {
+        return discoveredIndices;
+    }
+    int stamp = beginVisit(actorCount);
+    int* visited = visitStamps;
+    int* discovered = discoveredOrder;  // Only the first discoveredCount entries are touched.
+    int discoveredCount = 0;
+    BFSQueue& queue = frontier;
+    queue.clear();
+
+    queue.enqueue(startIndex, 0);
+    visited[startIndex] = stamp;
+
+    int nextDepth = 0;
+    const std::function<void(int)> visit = [&](int neighborIdx) {
+        if (neighborIdx >= 0 && neighborIdx < actorCount && visited[neighborIdx] != stamp) {
+            visited[neighborIdx] = stamp;
+            discovered[discoveredCount++] = neighborIdx;
+            queue.enqueue(neighborIdx, nextDepth);
+        }
+    };
+
+    while (!queue.isEmpty()) {
+        BFSQueue::Pair current;
+        if (!queue.dequeue(current))
+            break;
+
+        if (current.depth < maxDepth) {
+            nextDepth = current.depth + 1;
+            neighbors(current.idx, visit);
         }
     }
 
-    delete[] visited;
+    discoveredIndices.addAll(discovered, discoveredCount);
     return discoveredIndices;
 }
@@ -1,10 +1,11 @@
 #ifndef ACTOR_GRAPH_H
 #define ACTOR_GRAPH_H
 
-#include "HashTable.h"
+#include "DenseTable.h"
 #include "Actor.h"
 #include "Movie.h"
 #include "List.h"
+#include <functional>
 
 /***************************************************************************
  * ActorGraph.h
@@ -15,8 +16,23 @@
  *
  * Features Highlight:
  *   - Builds a graph of actors by linking actors who have worked together in movies.
+ *   - Vertices are the actors' dense IDs, so no separate ID array or search is needed.
+ *   - Stored in compressed sparse row form: one offsets array and one
+ *     neighbor array, filled in two passes (count degrees, then fill), so a
+ *     BFS reads each vertex's neighbors from contiguous memory.
+ *   - Each pair of co-stars is one edge however many movies they share;
+ *     the edge is weighted by the shared-movie count and can carry the
+ *     first and last year they worked together, kept in arrays beside the
+ *     neighbor array so a plain BFS never reads them.
+ *   - Edges added after the build go to small per-vertex overflow arrays,
+ *     which are folded back into the CSR arrays once they grow past a
+ *     quarter of the graph, so a long-lived graph can follow new links.
  *   - Provides methods to construct the actor graph, search using BFS, and find
  *     connected actors up to a specified depth.
+ *   - The BFS queue, visited marks and discovery order belong to the graph
+ *     and are reused by every search, including searches over generated
+ *     edges; marks are generation stamps, so a search costs only the
+ *     vertices it reaches, not the size of the graph.
  *
  ***************************************************************************/
 
@@ -24,14 +40,103 @@
   * @brief The ActorGraph class builds and manipulates a graph of actors.
   */
 class ActorGraph {
+private:
+    /**
+     * @brief An edge added after the build, held in a vertex's overflow array.
+     */
+    struct ExtraEdge {
+        int neighbor;     ///< The co-star's dense ID.
+        unsigned short weight;  ///< Movies shared (saturates at MAX_EDGE_WEIGHT).
+        short firstYear;  ///< Earliest shared release year (0 if years are not tracked).
+        short lastYear;   ///< Latest shared release year (0 if years are not tracked).
+    };
+
+    long long* offsets;  ///< Neighbors of vertex v are neighbors[offsets[v]] .. neighbors[offsets[v + 1] - 1].
+    int* neighbors;      ///< Neighbor lists of all vertices, back to back.
+    unsigned short* weights;  ///< Shared-movie count of each neighbor entry (saturates at MAX_EDGE_WEIGHT).
+    short* firstYears;   ///< First shared release year of each entry (nullptr unless tracked).
+    short* lastYears;    ///< Last shared release year of each entry (nullptr unless tracked).
+    bool trackYears;     ///< True if the graph records collaboration years.
+    int csrVertexCount;  ///< Vertices covered by offsets.
+    int vertexCount;     ///< Number of vertices (new vertices have no CSR range).
+    ExtraEdge** extraEdges;  ///< Per-vertex overflow arrays for edges added after the build (nullptr until used).
+    int* extraCounts;      ///< Entries used in each overflow array.
+    int* extraCapacities;  ///< Allocated size of each overflow array.
+    int extraVertexCapacity; ///< Allocated size of the three overflow arrays above.
+    long long extraTotal;  ///< Entries in all overflow arrays.
+
+    /// Largest stored shared-movie count; 16 bits keep the weights half the size of the neighbor array.
+    static const int MAX_EDGE_WEIGHT = 65535;
+
+    /// Overflow entries that always fit before a compaction is considered.
+    static const int MIN_COMPACT_ENTRIES = 65536;
+
+    /**
+     * @brief Releases the arrays and leaves an empty graph.
+     */
+    void clear();
+
+    /**
+     * @brief Releases the overflow arrays.
+     */
+    void clearExtras();
+
+    /**
+     * @brief Appends a neighbor to a vertex's overflow array.
+     *
+     * @param vertex The vertex.
+     * @param neighbor The new neighbor.
+     * @param year Release year of the shared movie (0 if unknown).
+     */
+    void appendExtra(int vertex, int neighbor, int year);
+
+    /**
+     * @brief Counts one more shared movie on an existing entry of a vertex.
+     *
+     * @param vertex The vertex.
+     * @param neighbor The neighbor to look for.
+     * @param year Release year of the shared movie (0 if unknown).
+     * @return bool True if the entry existed and was updated.
+     */
+    bool strengthenEdge(int vertex, int neighbor, int year);
+
+    /**
+     * @brief Finds the CSR or overflow entry of one edge.
+     *
+     * @param a The vertex whose entries are searched.
+     * @param b The neighbor to look for.
+     * @param csrEntry Receives the CSR entry index, or -1.
+     * @param extraEntry Receives the index in a's overflow array, or -1.
+     * @return bool True if the edge exists.
+     */
+    bool findEdge(int a, int b, long long& csrEntry, int& extraEntry) const;
+
+    /**
+     * @brief Rebuilds the CSR arrays with the overflow entries folded in.
+     *
+     * Each vertex keeps its CSR neighbors first, then its overflow neighbors
+     * in the order they were added, so a search finds the same actors in
+     * the same order before and after.
+     */
+    void compact();
+
 public:
     /// Initial capacity for storing actor data
     static const int INITIAL_ACTOR_CAPACITY = 2000;
 
+    /// A direction-optimizing search goes bottom-up once the frontier's edges exceed the unexplored edges divided by this.
+    static const int BOTTOM_UP_ALPHA = 14;
+
+    /// A direction-optimizing search goes back to top-down once the frontier is smaller than the vertex count divided by this.
+    static const int TOP_DOWN_BETA = 24;
+
     /**
      * @brief Structure for a BFS (Breadth-First Search) queue.
      *
-     * Used to perform a BFS search on the actor graph.
+     * Used to perform a BFS search on the actor graph. The queue is a ring
+     * buffer that doubles when full, so a search never drops a vertex;
+     * since each vertex is enqueued at most once, it never holds more than
+     * the vertex count. The storage is kept between searches.
      */
     struct BFSQueue {
         /**
@@ -42,7 +147,11 @@ public:
             int depth;  ///< Current depth in the BFS search.
         };
 
-        Pair data[2000] = {}; 
+        /// Slots allocated by the first enqueue.
+        static const int INITIAL_CAPACITY = 2000;
+
+        Pair* data;       ///< Ring buffer storage (nullptr until the first enqueue).
+        int capacity;     ///< Allocated size of data.
         int front;        ///< Index of the front element.
         int rear;         ///< Index of the rear element.
         int count;        ///< Current number of elements in the queue.
@@ -52,6 +161,17 @@ public:
          */
         BFSQueue();
 
+        /**
+         * @brief Destructor.
+         *
+         * Releases the ring buffer.
+         */
+        ~BFSQueue();
+
+        // Copy constructor and assignment operator are disabled for simplicity.
+        BFSQueue(const BFSQueue&) = delete;
+        BFSQueue& operator=(const BFSQueue&) = delete;
+
         /**
          * @brief Checks if the queue is empty.
          * @return true if the queue has no elements, false otherwise.
@@ -59,19 +179,17 @@ public:
         bool isEmpty() const;
 
         /**
-         * @brief Checks if the queue is full.
-         * @return true if the queue cannot accept more elements, false otherwise.
+         * @brief Empties the queue, keeping its storage for the next search.
          */
-        bool isFull() const;
+        void clear();
 
         /**
-         * @brief Enqueues an element into the queue.
+         * @brief Enqueues an element into the queue, doubling the buffer if it is full.
          *
          * @param i The actor index to enqueue.
          * @param d The BFS depth associated with this actor.
-         * @return true if the element was successfully enqueued, false if the queue is full.
          */
-        bool enqueue(int i, int d);
+        void enqueue(int i, int d);
 
         /**
          * @brief Dequeues an element from the queue.
@@ -82,56 +200,209 @@ public:
         bool dequeue(Pair& out);
     };
 
+private:
+    mutable BFSQueue frontier;  ///< Queue of the member findConnectedActors(), reused by every search.
+    mutable int* visitStamps;   ///< visitStamps[v] == visitEpoch marks v as seen by the current search.
+    mutable int* discoveredOrder;  ///< Vertices in the order the current search found them.
+    mutable int visitCapacity;  ///< Allocated size of visitStamps and discoveredOrder.
+    mutable int visitEpoch;     ///< Stamp of the current search; 0 is never used.
+    mutable unsigned long long* frontierBits;  ///< Bitmap of the current level for bottom-up steps (all zero between steps).
+    mutable int frontierWords;  ///< Allocated size of frontierBits in 64-bit words.
+
+    /**
+     * @brief Starts a search by moving to a new visit stamp.
+     *
+     * Nothing is cleared, so starting a search is O(1); the stamp array is
+     * only zero-filled when it grows or the stamp counter wraps.
+     *
+     * @param vertices The number of vertices the search can reach.
+     * @return int The new stamp.
+     */
+    int beginVisit(int vertices) const;
+
+    /**
+     * @brief Calls a function on each neighbor of a vertex until it returns true.
+     *
+     * Walks the CSR range, then the overflow array.
+     *
+     * @tparam Visit Callable taking an int neighbor and returning bool.
+     * @param v The vertex.
+     * @param visit Called for each neighbor; returning true stops the walk.
+     * @return bool True if the walk was stopped.
+     */
+    template <typename Visit>
+    bool forEachNeighbor(int v, Visit visit) const;
+
+public:
+    /**
+     * @brief Constructs an empty graph.
+     */
+    ActorGraph();
+
+    /**
+     * @brief Destructor.
+     *
+     * Releases the offsets, neighbor, visit stamp, discovery order and frontier bitmap arrays.
+     */
+    ~ActorGraph();
+
+    // Copy constructor and assignment operator are disabled for simplicity.
+    ActorGraph(const ActorGraph&) = delete;
+    ActorGraph& operator=(const ActorGraph&) = delete;
+
     /**
      * @brief Builds the actor graph by linking actors who have worked together in movies.
      *
-     * Iterates through the movie table to determine which actors have co-starred,
-     * constructing adjacency lists that represent those connections.
+     * Vertex i is the actor with dense ID i in actorTable. The cast of every
+     * movie is translated to dense IDs once and inverted into each actor's
+     * movies. Each vertex's co-stars are then walked movie by movie, twice:
+     * once to count the distinct ones (the degree, turned into offsets by a
+     * prefix sum) and once to write them, a co-star seen again only adding
+     * to its entry's weight. Neighbors appear in the order of their first
+     * shared movie. Replaces any previous graph, including edges added with
+     * addEdge().
+     *
+     * @param actorTable A dense table containing actor data.
+     * @param movieTable A dense table containing movie data.
+     * @param withYears True to also record each edge's first and last collaboration year.
+     */
+    void build(const DenseTable<Actor>& actorTable, const DenseTable<Movie>& movieTable, bool withYears = false);
+
+    /**
+     * @brief Returns the number of vertices.
+     *
+     * @return int The actor count when the graph was built.
+     */
+    int getVertexCount() const;
+
+    /**
+     * @brief Returns the number of neighbor entries (twice the number of distinct edges).
+     *
+     * @return long long The CSR and overflow entries.
+     */
+    long long getNeighborCount() const;
+
+    /**
+     * @brief Returns the number of distinct co-stars of a vertex.
      *
-     * @param actorTable A hash table containing actor data.
-     * @param movieTable A hash table containing movie data.
-     * @param actorIds Reference to a pointer that will be assigned a dynamically allocated array of actor IDs.
-     * @param actorCount Reference to an integer that will hold the total number of actors.
-     * @param adjacencyLists Reference to a pointer that will be assigned the dynamically allocated adjacency lists.
+     * @param v The vertex.
+     * @return int The degree (0 if v is out of range).
      */
-    static void buildActorGraph(
-        const HashTable<Actor>& actorTable,
-        const HashTable<Movie>& movieTable,
-        int*& actorIds,
-        int& actorCount,
-        List<int>*& adjacencyLists
-    );
+    int getDegree(int v) const;
 
     /**
-     * @brief Finds the index of an actor in the actorIds array.
+     * @brief Returns the memory held by the graph.
      *
-     * Searches for the actor with the given ID in the array.
+     * @return unsigned long long Bytes allocated for the CSR and overflow arrays.
+     */
+    unsigned long long getBytes() const;
+
+    /**
+     * @brief Checks whether the graph records collaboration years.
      *
-     * @param actorId The unique ID of the actor.
-     * @param actorIds The array of actor IDs.
-     * @param count The total number of actors in the array.
-     * @return The index of the actor if found; otherwise, -1.
+     * @return bool True if it was built with years.
      */
-    static int findActorIndexInArray(int actorId, const int actorIds[], int count);
+    bool hasCollaborationYears() const;
+
+    /**
+     * @brief Returns how many movies two actors share.
+     *
+     * O(degree of a).
+     *
+     * @param a One actor's dense ID.
+     * @param b The other actor's dense ID.
+     * @return int The edge weight (at most MAX_EDGE_WEIGHT), or 0 if they never worked together.
+     */
+    int getSharedMovieCount(int a, int b) const;
+
+    /**
+     * @brief Returns the first and last release years of the movies two actors share.
+     *
+     * @param a One actor's dense ID.
+     * @param b The other actor's dense ID.
+     * @param firstYear Receives the earliest year.
+     * @param lastYear Receives the latest year.
+     * @return bool True if the actors are linked and the graph records years.
+     */
+    bool getCollaborationYears(int a, int b, int& firstYear, int& lastYear) const;
+
+    /**
+     * @brief Makes sure the graph has at least a given number of vertices.
+     *
+     * New vertices have no neighbors.
+     *
+     * @param count The number of vertices needed.
+     */
+    void ensureVertexCount(int count);
+
+    /**
+     * @brief Links two actors who now share a movie.
+     *
+     * If they are already linked, the edge's weight (and years) are updated
+     * in place, which costs a scan of both neighbor ranges. Otherwise the
+     * edge goes to both overflow arrays, which are compacted into the CSR
+     * arrays when they grow too large. Adds the vertices if needed.
+     *
+     * @param a One actor's dense ID.
+     * @param b The other actor's dense ID.
+     * @param year Release year of the shared movie (0 if unknown).
+     */
+    void addEdge(int a, int b, int year = 0);
 
     /**
      * @brief Finds all actors connected to a specified actor using BFS.
      *
-     * Performs a breadth-first search (BFS) on the actor graph starting from the given index,
-     * collecting indices of all actors connected up to a maximum search depth.
+     * Performs a breadth-first search (BFS) on the actor graph starting from the given vertex,
+     * collecting the vertices of all actors connected up to a maximum search depth.
+     *
+     * @param startIndex The dense ID of the starting actor.
+     * @param maxDepth The maximum depth for the BFS search.
+     * @return A List<int> containing the dense IDs of all connected actors found within the specified depth.
+     */
+    List<int> findConnectedActors(int startIndex, int maxDepth) const;
+
+    /**
+     * @brief Finds the same actors as findConnectedActors() with a direction-optimizing BFS.
+     *
+     * The search runs one level at a time. While the frontier is small it
+     * expands top-down, pushing from each frontier vertex to its unvisited
+     * neighbors. Once the frontier's edges outnumber the unexplored edges
+     * by BOTTOM_UP_ALPHA, it marks the frontier in a bitmap and goes
+     * bottom-up instead: each unvisited vertex checks its neighbors and
+     * stops at the first one in the frontier. That skips most of the edges
+     * a hub's second level would otherwise scan. It returns to top-down
+     * once the frontier shrinks below the vertex count over TOP_DOWN_BETA.
+     *
+     * @param startIndex The dense ID of the starting actor.
+     * @param maxDepth The maximum depth for the BFS search.
+     * @return A List<int> of the dense IDs found, level by level. A level
+     *         reached top-down is in discovery order and one reached
+     *         bottom-up is in dense ID order, so within a level the order
+     *         can differ from findConnectedActors().
+     */
+    List<int> findConnectedActorsDirectionOptimizing(int startIndex, int maxDepth) const;
+
+    /**
+     * @brief Finds all actors connected to a specified actor using BFS over generated edges.
+     *
+     * Same search as the member version, for graphs that are not
+     * materialized: the neighbors of a vertex are produced on demand, for
+     * example from the cast and filmography indexes of a CatalogImage. The
+     * graph's own edges are ignored; only its visit stamps, discovery order
+     * and queue are used, so an empty graph serves as reusable scratch space.
      *
-     * @param startIndex The index of the starting actor.
-     * @param adjacencyLists The array of adjacency lists representing the graph.
-     * @param actorCount The total number of actors in the graph.
+     * @param startIndex The starting vertex.
+     * @param actorCount The total number of vertices.
      * @param maxDepth The maximum depth for the BFS search.
-     * @return A List<int> containing the indices of all connected actors found within the specified depth.
+     * @param neighbors Calls its second argument once per neighbor of a vertex (duplicates are allowed).
+     * @return A List<int> containing the vertices found within the specified depth.
      */
-    static List<int> findConnectedActors(
+    List<int> findConnectedActors(
         int startIndex,
-        const List<int>* adjacencyLists,
         int actorCount,
-        int maxDepth
-    );
+        int maxDepth,
+        const std::function<void(int, const std::function<void(int)>&)>& neighbors
+    ) const;
 };
 
 #endif // ACTOR_GRAPH_H
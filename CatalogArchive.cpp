@@ -0,0 +1,702 @@
+/***************************************************************************
+ * CatalogArchive.cpp
+ *
+ * Team:            Gearoid, Cedric
+ * Group:           1
+ * Student IDs:     S10241866, S10241549
+ *
+ * Features Highlight:
+ *   - Two-pass writer: count words, then encode every column.
+ *   - Bounds-checked varint decoding; the dictionary is indexed once when
+ *     the archive is opened.
+ *   - Single-row text lookups through the per-block offsets.
+ ***************************************************************************/
+
+#include "CatalogArchive.h"
+#include <cstdio>      // For std::rename/std::remove
+#include <cstring>
+#include <fstream>
+
+/**
+ * @brief Appends an unsigned varint (7 bits per byte, low bits first).
+ *
+ * @param out The buffer.
+ * @param value The value.
+ */
+static void putVarint(std::string& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+/**
+ * @brief Reads an unsigned varint without reading past the end of a section.
+ *
+ * @param p The first byte; advanced past the varint.
+ * @param end End of the section.
+ * @return uint64_t The value (truncated if the section ends inside it).
+ */
+static uint64_t getVarint(const unsigned char*& p, const unsigned char* end) {
+    uint64_t value = 0;
+    int shift = 0;
+    while (p < end && shift < 64) {
+        unsigned char b = *p++;
+        value |= static_cast<uint64_t>(b & 0x7F) << shift;
+        if ((b & 0x80) == 0) {
+            break;
+        }
+        shift += 7;
+    }
+    return value;
+}
+
+/**
+ * @brief Computes the FNV-1a hash of a byte range.
+ *
+ * @param s Pointer to the first byte.
+ * @param length Number of bytes.
+ * @return uint32_t The hash value.
+ */
+static uint32_t hashWord(const char* s, uint32_t length) {
+    uint32_t h = 2166136261u;
+    for (uint32_t i = 0; i < length; ++i) {
+        h ^= static_cast<unsigned char>(s[i]);
+        h *= 16777619u;
+    }
+    return h;
+}
+
+/**
+ * @brief Returns the number of rows in a column.
+ *
+ * @param header The archive header.
+ * @param column The column.
+ * @return uint32_t The actor count for actor columns, else the movie count.
+ */
+static uint32_t rowsOf(const ArchiveHeader& header, ArchiveColumn column) {
+    return (column <= ARCHIVE_ACTOR_NAMES) ? header.actorCount : header.movieCount;
+}
+
+/**
+ * @brief Checks whether a column holds text.
+ *
+ * @param column The column.
+ * @return bool True for names, titles and plots.
+ */
+static bool isTextColumn(ArchiveColumn column) {
+    return column == ARCHIVE_ACTOR_NAMES || column == ARCHIVE_MOVIE_TITLES
+        || column == ARCHIVE_MOVIE_PLOTS;
+}
+
+/**
+ * @brief Checks whether a column holds ratings.
+ *
+ * @param column The column.
+ * @return bool True for the rating columns.
+ */
+static bool isRatingColumn(ArchiveColumn column) {
+    return column == ARCHIVE_ACTOR_RATINGS || column == ARCHIVE_MOVIE_RATINGS;
+}
+
+/**
+ * @brief Sorts word indexes by descending count, keeping first-seen order on ties.
+ *
+ * @param ids The word indexes to sort.
+ * @param temp Scratch space of the same size.
+ * @param left First position.
+ * @param right Last position.
+ * @param counts Occurrence count of each word.
+ */
+static void mergeSortByCount(int* ids, int* temp, int left, int right, const int* counts) {
+    if (left >= right) {
+        return;
+    }
+    int mid = left + (right - left) / 2;
+    mergeSortByCount(ids, temp, left, mid, counts);
+    mergeSortByCount(ids, temp, mid + 1, right, counts);
+    int i = left;
+    int j = mid + 1;
+    int k = left;
+    while (i <= mid && j <= right) {
+        if (counts[ids[j]] > counts[ids[i]]) {
+            temp[k++] = ids[j++];
+        }
+        else {
+            temp[k++] = ids[i++];
+        }
+    }
+    while (i <= mid) temp[k++] = ids[i++];
+    while (j <= right) temp[k++] = ids[j++];
+    for (k = left; k <= right; ++k) {
+        ids[k] = temp[k];
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Writer
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Constructs a writer with no rows.
+ */
+CatalogArchiveWriter::CatalogArchiveWriter()
+    : words(new Word[1024]),
+    wordCount(0),
+    wordCapacity(1024),
+    slots(new int[2048]),
+    slotCapacity(2048),
+    codes(nullptr),
+    dictionarySize(0),
+    sealed(false),
+    actorCount(0),
+    movieCount(0)
+{
+    for (int i = 0; i < slotCapacity; ++i) {
+        slots[i] = -1;
+    }
+    for (int i = 0; i < ARCHIVE_SECTION_COUNT; ++i) {
+        previous[i] = 0;
+    }
+}
+
+/**
+ * @brief Destructor.
+ */
+CatalogArchiveWriter::~CatalogArchiveWriter() {
+    delete[] words;
+    delete[] slots;
+    delete[] codes;
+}
+
+/**
+ * @brief Finds a word, optionally adding it.
+ *
+ * @param s The word's first byte.
+ * @param length The word's length.
+ * @param add True to add the word if it is missing.
+ * @return int The word index, or -1.
+ */
+int CatalogArchiveWriter::findWord(const char* s, uint32_t length, bool add) {
+    uint32_t h = hashWord(s, length);
+    uint32_t mask = static_cast<uint32_t>(slotCapacity - 1);
+    uint32_t pos = h & mask;
+    while (slots[pos] != -1) {
+        const Word& w = words[slots[pos]];
+        if (w.hash == h && w.length == length
+            && std::memcmp(wordText.data() + w.offset, s, length) == 0) {
+            return slots[pos];
+        }
+        pos = (pos + 1) & mask;
+    }
+    if (!add) {
+        return -1;
+    }
+    if (wordCount == wordCapacity) {
+        Word* bigger = new Word[wordCapacity * 2];
+        std::memcpy(bigger, words, sizeof(Word) * wordCount);
+        delete[] words;
+        words = bigger;
+        wordCapacity *= 2;
+    }
+    Word& w = words[wordCount];
+    w.offset = static_cast<uint32_t>(wordText.size());
+    w.length = length;
+    w.hash = h;
+    w.count = 0;
+    wordText.append(s, length);
+    slots[pos] = wordCount;
+    // Keep the load factor at or below one half.
+    if (++wordCount * 2 > slotCapacity) {
+        growSlots();
+    }
+    return wordCount - 1;
+}
+
+/**
+ * @brief Doubles the slot table and reinserts every word.
+ */
+void CatalogArchiveWriter::growSlots() {
+    delete[] slots;
+    slotCapacity *= 2;
+    slots = new int[slotCapacity];
+    for (int i = 0; i < slotCapacity; ++i) {
+        slots[i] = -1;
+    }
+    uint32_t mask = static_cast<uint32_t>(slotCapacity - 1);
+    for (int i = 0; i < wordCount; ++i) {
+        uint32_t pos = words[i].hash & mask;
+        while (slots[pos] != -1) {
+            pos = (pos + 1) & mask;
+        }
+        slots[pos] = i;
+    }
+}
+
+/**
+ * @brief Counts the words of a name, title or plot.
+ *
+ * @param text The text.
+ */
+void CatalogArchiveWriter::countText(const char* text) {
+    if (sealed || text == nullptr || text[0] == '\0') {
+        return;
+    }
+    const char* start = text;
+    for (const char* p = text; ; ++p) {
+        if (*p == ' ' || *p == '\0') {
+            // findWord() may move the words array, so look it up afterwards.
+            int word = findWord(start, static_cast<uint32_t>(p - start), true);
+            words[word].count++;
+            if (*p == '\0') {
+                break;
+            }
+            start = p + 1;
+        }
+    }
+}
+
+/**
+ * @brief Chooses the dictionary and encodes it.
+ *
+ * Words seen once are cheaper as literals. The most frequent words get
+ * the smallest codes, so they encode in one byte.
+ */
+void CatalogArchiveWriter::sealDictionary() {
+    sealed = true;
+    codes = new int[wordCount > 0 ? wordCount : 1];
+    int* order = new int[wordCount > 0 ? wordCount : 1];
+    int* counts = new int[wordCount > 0 ? wordCount : 1];
+    int repeated = 0;
+    for (int i = 0; i < wordCount; ++i) {
+        codes[i] = -1;
+        counts[i] = words[i].count;
+        if (words[i].count >= 2) {
+            order[repeated++] = i;
+        }
+    }
+    int* temp = new int[repeated > 0 ? repeated : 1];
+    mergeSortByCount(order, temp, 0, repeated - 1, counts);
+    std::string& out = columns[ARCHIVE_WORDS];
+    for (int i = 0; i < repeated; ++i) {
+        const Word& w = words[order[i]];
+        codes[order[i]] = i;
+        putVarint(out, w.length);
+        out.append(wordText.data() + w.offset, w.length);
+    }
+    dictionarySize = repeated;
+    delete[] temp;
+    delete[] counts;
+    delete[] order;
+}
+
+/**
+ * @brief Appends a value to an ID or year column as a zigzag delta.
+ *
+ * @param column The column.
+ * @param value The value.
+ */
+void CatalogArchiveWriter::appendDelta(ArchiveColumn column, int value) {
+    int64_t delta = static_cast<int64_t>(value) - previous[column];
+    previous[column] = value;
+    putVarint(columns[column], (static_cast<uint64_t>(delta) << 1) ^ static_cast<uint64_t>(delta >> 63));
+}
+
+/**
+ * @brief Appends a rating; even rows take the low nibble of a new byte.
+ *
+ * @param column The column.
+ * @param row The row's index.
+ * @param rating The rating; values outside 0-15 are stored as unrated.
+ */
+void CatalogArchiveWriter::appendRating(ArchiveColumn column, int row, int rating) {
+    unsigned char nibble = (rating >= 0 && rating <= 15) ? static_cast<unsigned char>(rating) : 0;
+    std::string& out = columns[column];
+    if (row % 2 == 0) {
+        out.push_back(static_cast<char>(nibble));
+    }
+    else {
+        out.back() = static_cast<char>(static_cast<unsigned char>(out.back()) | (nibble << 4));
+    }
+}
+
+/**
+ * @brief Appends a row to a text column.
+ *
+ * @param column The column.
+ * @param row The row's index.
+ * @param text The text.
+ */
+void CatalogArchiveWriter::appendText(ArchiveColumn column, int row, const char* text) {
+    std::string& out = columns[column];
+    if (row % ARCHIVE_BLOCK_ROWS == 0) {
+        uint32_t start = static_cast<uint32_t>(out.size());
+        blockStarts[column].append(reinterpret_cast<const char*>(&start), sizeof(start));
+    }
+    if (text == nullptr || text[0] == '\0') {
+        putVarint(out, 0);
+        return;
+    }
+    uint64_t tokens = 1;
+    for (const char* p = text; *p != '\0'; ++p) {
+        if (*p == ' ') {
+            ++tokens;
+        }
+    }
+    putVarint(out, tokens);
+    const char* start = text;
+    for (const char* p = text; ; ++p) {
+        if (*p == ' ' || *p == '\0') {
+            uint32_t length = static_cast<uint32_t>(p - start);
+            int word = findWord(start, length, false);
+            int code = (word != -1) ? codes[word] : -1;
+            if (code != -1) {
+                putVarint(out, static_cast<uint64_t>(code) + 1);
+            }
+            else {
+                putVarint(out, 0);
+                putVarint(out, length);
+                out.append(start, length);
+            }
+            if (*p == '\0') {
+                break;
+            }
+            start = p + 1;
+        }
+    }
+}
+
+/**
+ * @brief Appends an actor row.
+ *
+ * @param id Actor ID.
+ * @param birthYear Birth year.
+ * @param rating Rating.
+ * @param name The name.
+ */
+void CatalogArchiveWriter::addActor(int id, int birthYear, int rating, const char* name) {
+    if (!sealed) {
+        sealDictionary();
+    }
+    appendDelta(ARCHIVE_ACTOR_IDS, id);
+    appendDelta(ARCHIVE_ACTOR_BIRTH_YEARS, birthYear);
+    appendRating(ARCHIVE_ACTOR_RATINGS, actorCount, rating);
+    appendText(ARCHIVE_ACTOR_NAMES, actorCount, name);
+    ++actorCount;
+}
+
+/**
+ * @brief Appends a movie row.
+ *
+ * @param id Movie ID.
+ * @param releaseYear Release year.
+ * @param rating Rating.
+ * @param title The title.
+ * @param plot The plot.
+ */
+void CatalogArchiveWriter::addMovie(int id, int releaseYear, int rating, const char* title, const char* plot) {
+    if (!sealed) {
+        sealDictionary();
+    }
+    appendDelta(ARCHIVE_MOVIE_IDS, id);
+    appendDelta(ARCHIVE_MOVIE_YEARS, releaseYear);
+    appendRating(ARCHIVE_MOVIE_RATINGS, movieCount, rating);
+    appendText(ARCHIVE_MOVIE_TITLES, movieCount, title);
+    appendText(ARCHIVE_MOVIE_PLOTS, movieCount, plot);
+    ++movieCount;
+}
+
+/**
+ * @brief Writes the header and every section to a temporary file, then
+ *        renames it over the archive.
+ *
+ * @param path The archive file.
+ * @param nextActorId The next free actor ID.
+ * @param nextMovieId The next free movie ID.
+ * @return bool True on success.
+ */
+bool CatalogArchiveWriter::write(const std::string& path, int nextActorId, int nextMovieId) {
+    if (!sealed) {
+        sealDictionary();
+    }
+    ArchiveHeader header = {};
+    header.magic = CATALOG_ARCHIVE_MAGIC;
+    header.version = CATALOG_ARCHIVE_VERSION;
+    header.actorCount = static_cast<uint32_t>(actorCount);
+    header.movieCount = static_cast<uint32_t>(movieCount);
+    header.wordCount = static_cast<uint32_t>(dictionarySize);
+    header.nextActorId = nextActorId;
+    header.nextMovieId = nextMovieId;
+    uint64_t offset = sizeof(ArchiveHeader);
+    for (int i = 0; i < ARCHIVE_SECTION_COUNT; ++i) {
+        header.sections[i].offset = offset;
+        header.sections[i].bytes = blockStarts[i].size() + columns[i].size();
+        offset += header.sections[i].bytes;
+    }
+
+    std::string tempPath = path + ".tmp";
+    std::ofstream out(tempPath.c_str(), std::ios::binary | std::ios::trunc);
+    bool ok = out.is_open();
+    if (ok) {
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        for (int i = 0; i < ARCHIVE_SECTION_COUNT; ++i) {
+            out.write(blockStarts[i].data(), static_cast<std::streamsize>(blockStarts[i].size()));
+            out.write(columns[i].data(), static_cast<std::streamsize>(columns[i].size()));
+        }
+        out.close();
+        ok = !out.fail();
+    }
+    if (ok) {
+        std::remove(path.c_str());
+        ok = std::rename(tempPath.c_str(), path.c_str()) == 0;
+    }
+    if (!ok) {
+        std::remove(tempPath.c_str());
+    }
+    return ok;
+}
+
+// ---------------------------------------------------------------------------
+// Reader
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Constructs a closed archive.
+ */
+CatalogArchive::CatalogArchive()
+    : header(),
+    wordStarts(nullptr),
+    wordLengths(nullptr)
+{
+}
+
+/**
+ * @brief Destructor.
+ */
+CatalogArchive::~CatalogArchive() {
+    close();
+}
+
+/**
+ * @brief Maps an archive and checks it.
+ *
+ * The section bounds, the size of each block index and rating column, and
+ * the dictionary are checked here; the varint columns are checked as they
+ * are decoded.
+ *
+ * @param path The archive file.
+ * @return bool True on success.
+ */
+bool CatalogArchive::open(const std::string& path) {
+    close();
+    if (!file.open(path)) {
+        return false;
+    }
+    uint64_t size = file.size();
+    if (size < sizeof(ArchiveHeader)) {
+        file.close();
+        return false;
+    }
+    std::memcpy(&header, file.data(), sizeof(ArchiveHeader));
+    bool valid = header.magic == CATALOG_ARCHIVE_MAGIC && header.version == CATALOG_ARCHIVE_VERSION;
+    for (int i = 0; valid && i < ARCHIVE_SECTION_COUNT; ++i) {
+        ArchiveColumn column = static_cast<ArchiveColumn>(i);
+        const ArchiveSection& section = header.sections[i];
+        valid = section.offset >= sizeof(ArchiveHeader) && section.offset <= size
+            && section.bytes <= size - section.offset;
+        uint64_t rows = rowsOf(header, column);
+        if (valid && isTextColumn(column)) {
+            valid = section.bytes >= (rows + ARCHIVE_BLOCK_ROWS - 1) / ARCHIVE_BLOCK_ROWS * sizeof(uint32_t);
+        }
+        if (valid && isRatingColumn(column)) {
+            valid = section.bytes >= (rows + 1) / 2;
+        }
+    }
+    if (valid) {
+        wordStarts = new uint32_t[header.wordCount + 1];
+        wordLengths = new uint32_t[header.wordCount + 1];
+        const unsigned char* words = sectionData(ARCHIVE_WORDS);
+        const unsigned char* p = words;
+        const unsigned char* end = words + header.sections[ARCHIVE_WORDS].bytes;
+        for (uint32_t i = 0; valid && i < header.wordCount; ++i) {
+            uint64_t length = getVarint(p, end);
+            valid = length <= static_cast<uint64_t>(end - p);
+            if (valid) {
+                wordStarts[i] = static_cast<uint32_t>(p - words);
+                wordLengths[i] = static_cast<uint32_t>(length);
+                p += length;
+            }
+        }
+    }
+    if (!valid) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Unmaps the archive and frees the dictionary index.
+ */
+void CatalogArchive::close() {
+    file.close();
+    header = ArchiveHeader();
+    delete[] wordStarts;
+    delete[] wordLengths;
+    wordStarts = nullptr;
+    wordLengths = nullptr;
+}
+
+/**
+ * @brief Checks whether an archive is open.
+ *
+ * @return bool True if open.
+ */
+bool CatalogArchive::isOpen() const {
+    return file.isOpen() && wordStarts != nullptr;
+}
+
+/**
+ * @brief Returns the number of actor rows.
+ *
+ * @return int The actor count.
+ */
+int CatalogArchive::getActorCount() const {
+    return static_cast<int>(header.actorCount);
+}
+
+/**
+ * @brief Returns the number of movie rows.
+ *
+ * @return int The movie count.
+ */
+int CatalogArchive::getMovieCount() const {
+    return static_cast<int>(header.movieCount);
+}
+
+/**
+ * @brief Returns the next actor ID recorded in the archive.
+ *
+ * @return int The next actor ID.
+ */
+int CatalogArchive::getNextActorId() const {
+    return header.nextActorId;
+}
+
+/**
+ * @brief Returns the next movie ID recorded in the archive.
+ *
+ * @return int The next movie ID.
+ */
+int CatalogArchive::getNextMovieId() const {
+    return header.nextMovieId;
+}
+
+/**
+ * @brief Returns the size of the archive file.
+ *
+ * @return unsigned long long Bytes.
+ */
+unsigned long long CatalogArchive::getFileBytes() const {
+    return isOpen() ? file.size() : 0;
+}
+
+/**
+ * @brief Returns the first byte of a section.
+ *
+ * @param column The section.
+ * @return const unsigned char* The section data.
+ */
+const unsigned char* CatalogArchive::sectionData(ArchiveColumn column) const {
+    return reinterpret_cast<const unsigned char*>(file.data()) + header.sections[column].offset;
+}
+
+/**
+ * @brief Decodes a whole ID, year or rating column.
+ *
+ * @param column The column.
+ * @param out Receives one value per row.
+ */
+void CatalogArchive::decodeColumn(ArchiveColumn column, int* out) const {
+    if (!isOpen() || isTextColumn(column) || column == ARCHIVE_WORDS) {
+        return;
+    }
+    uint32_t rows = rowsOf(header, column);
+    const unsigned char* p = sectionData(column);
+    const unsigned char* end = p + header.sections[column].bytes;
+    if (isRatingColumn(column)) {
+        for (uint32_t i = 0; i < rows; ++i) {
+            unsigned char packed = p[i / 2];
+            out[i] = (i % 2 == 0) ? (packed & 0x0F) : (packed >> 4);
+        }
+        return;
+    }
+    int64_t value = 0;
+    for (uint32_t i = 0; i < rows; ++i) {
+        uint64_t zigzag = getVarint(p, end);
+        value += static_cast<int64_t>(zigzag >> 1) ^ -static_cast<int64_t>(zigzag & 1);
+        out[i] = static_cast<int>(value);
+    }
+}
+
+/**
+ * @brief Decodes or skips one row of a text column.
+ *
+ * @param p The row's first byte; advanced past the row.
+ * @param end End of the section.
+ * @param out Receives the text, or nullptr to skip the row.
+ */
+void CatalogArchive::decodeTextRow(const unsigned char*& p, const unsigned char* end, std::string* out) const {
+    uint64_t tokens = getVarint(p, end);
+    for (uint64_t t = 0; t < tokens && p < end; ++t) {
+        if (out != nullptr && t > 0) {
+            out->push_back(' ');
+        }
+        uint64_t code = getVarint(p, end);
+        if (code == 0) {
+            uint64_t length = getVarint(p, end);
+            if (length > static_cast<uint64_t>(end - p)) {
+                length = static_cast<uint64_t>(end - p);
+            }
+            if (out != nullptr) {
+                out->append(reinterpret_cast<const char*>(p), static_cast<size_t>(length));
+            }
+            p += length;
+        }
+        else if (out != nullptr && code <= header.wordCount) {
+            const unsigned char* words = sectionData(ARCHIVE_WORDS);
+            out->append(reinterpret_cast<const char*>(words + wordStarts[code - 1]), wordLengths[code - 1]);
+        }
+    }
+}
+
+/**
+ * @brief Decodes one row of a text column.
+ *
+ * @param column The text column.
+ * @param row The row index.
+ * @return std::string The text.
+ */
+std::string CatalogArchive::textAt(ArchiveColumn column, int row) const {
+    std::string text;
+    if (!isOpen() || !isTextColumn(column) || row < 0
+        || static_cast<uint32_t>(row) >= rowsOf(header, column)) {
+        return text;
+    }
+    uint32_t blocks = (rowsOf(header, column) + ARCHIVE_BLOCK_ROWS - 1) / ARCHIVE_BLOCK_ROWS;
+    const unsigned char* data = sectionData(column);
+    const unsigned char* rowsStart = data + sizeof(uint32_t) * static_cast<uint64_t>(blocks);
+    const unsigned char* end = data + header.sections[column].bytes;
+    uint32_t blockStart;
+    std::memcpy(&blockStart, data + sizeof(uint32_t) * static_cast<uint64_t>(row / ARCHIVE_BLOCK_ROWS), sizeof(blockStart));
+    if (blockStart > static_cast<uint64_t>(end - rowsStart)) {
+        return text;
+    }
+    const unsigned char* p = rowsStart + blockStart;
+    for (int skip = row % ARCHIVE_BLOCK_ROWS; skip > 0; --skip) {
+        decodeTextRow(p, end, nullptr);
+    }
+    decodeTextRow(p, end, &text);
+    return text;
+}
@@ -0,0 +1,349 @@
+#ifndef CATALOG_ARCHIVE_H
+#define CATALOG_ARCHIVE_H
+
+#include "MappedFile.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/***************************************************************************
+ * CatalogArchive.h
+ *
+ * Team:            Gearoid, Cedric
+ * Group:           1
+ * Student IDs:     S10241866, S10241549
+ *
+ * Features Highlight:
+ *   - A compressed, column-oriented archive of the actor and movie records
+ *     for catalogues that are mostly cold: it is several times smaller than
+ *     the snapshot or image, and MovieApp can run its year and age scans on
+ *     it without building any Actor or Movie objects (see
+ *     MovieApp::openArchive).
+ *   - Each field is its own column: IDs and years as zigzag varints of the
+ *     difference from the previous row, ratings packed two per byte, and
+ *     names, titles and plots as word codes into a shared dictionary.
+ *   - Text columns keep the byte offset of every ARCHIVE_BLOCK_ROWS-th row,
+ *     so one row can be decoded without decoding the whole column.
+ *
+ *   File layout (little-endian, sections byte-packed):
+ *     ArchiveHeader
+ *     one section per ArchiveColumn, in enum order
+ *
+ *   Column encodings (rows in dense ID order):
+ *     ID, year        varint zigzag(value - previous value), previous = 0
+ *     rating          4 bits per row, low nibble first
+ *     text            uint32 blockStart[ceil(rows / ARCHIVE_BLOCK_ROWS)],
+ *                     then per row: varint tokenCount, then per token
+ *                     varint code (word code + 1, or 0 then varint length
+ *                     and the bytes of a literal). Tokens are the pieces
+ *                     of the text between single spaces.
+ *     words           per word: varint length, bytes; most frequent first
+ *
+ ***************************************************************************/
+
+/// "DSAC" read as a little-endian 32-bit integer.
+static const uint32_t CATALOG_ARCHIVE_MAGIC = 0x43415344u;
+
+/// Bumped whenever a column encoding changes.
+static const uint32_t CATALOG_ARCHIVE_VERSION = 1;
+
+/// Rows between entries of a text column's block index.
+static const int ARCHIVE_BLOCK_ROWS = 64;
+
+/**
+ * @brief The columns of an archive, in file order.
+ */
+enum ArchiveColumn {
+    ARCHIVE_ACTOR_IDS = 0,          ///< Actor IDs.
+    ARCHIVE_ACTOR_BIRTH_YEARS = 1,  ///< Actor birth years.
+    ARCHIVE_ACTOR_RATINGS = 2,      ///< Actor ratings (0 = unrated).
+    ARCHIVE_ACTOR_NAMES = 3,        ///< Actor names.
+    ARCHIVE_MOVIE_IDS = 4,          ///< Movie IDs.
+    ARCHIVE_MOVIE_YEARS = 5,        ///< Movie release years.
+    ARCHIVE_MOVIE_RATINGS = 6,      ///< Movie ratings (0 = unrated).
+    ARCHIVE_MOVIE_TITLES = 7,       ///< Movie titles.
+    ARCHIVE_MOVIE_PLOTS = 8,        ///< Movie plots.
+    ARCHIVE_WORDS = 9,              ///< The word dictionary shared by the text columns.
+    ARCHIVE_SECTION_COUNT = 10
+};
+
+/**
+ * @brief Where one column is stored.
+ */
+struct ArchiveSection {
+    uint64_t offset;         ///< File offset of the first byte.
+    uint64_t bytes;          ///< Size of the section.
+};
+
+/**
+ * @brief Fixed-size header at offset 0 of an archive file.
+ */
+struct ArchiveHeader {
+    uint32_t magic;          ///< CATALOG_ARCHIVE_MAGIC.
+    uint32_t version;        ///< CATALOG_ARCHIVE_VERSION.
+    uint32_t actorCount;     ///< Rows in each actor column.
+    uint32_t movieCount;     ///< Rows in each movie column.
+    uint32_t wordCount;      ///< Words in the dictionary.
+    int32_t nextActorId;     ///< MovieApp::nextActorId when written.
+    int32_t nextMovieId;     ///< MovieApp::nextMovieId when written.
+    uint32_t reserved;       ///< Zero.
+    ArchiveSection sections[ARCHIVE_SECTION_COUNT];  ///< Indexed by ArchiveColumn.
+};
+
+/**
+ * @brief Builds an archive file from rows given in dense ID order.
+ *
+ * The dictionary has to be known before any text is encoded, so writing
+ * takes two passes over the rows: countText() for every name, title and
+ * plot, then addActor() and addMovie() for every row, then write().
+ */
+class CatalogArchiveWriter {
+private:
+    /**
+     * @brief A distinct word seen by countText().
+     */
+    struct Word {
+        uint32_t offset;     ///< Offset of the text in wordText.
+        uint32_t length;     ///< Length of the text.
+        uint32_t hash;       ///< FNV-1a hash of the text.
+        int count;           ///< Occurrences across all text columns.
+    };
+
+    std::string wordText;    ///< Text of every distinct word, back to back.
+    Word* words;             ///< Distinct words, in first-seen order.
+    int wordCount;           ///< Number of distinct words.
+    int wordCapacity;        ///< Allocated size of words.
+    int* slots;              ///< Open-addressing table of word indexes (-1 = empty).
+    int slotCapacity;        ///< Number of slots (power of two).
+    int* codes;              ///< Dictionary code of each word, or -1 (set by sealDictionary()).
+    int dictionarySize;      ///< Words given a code.
+    bool sealed;             ///< True once the dictionary is fixed.
+
+    std::string columns[ARCHIVE_SECTION_COUNT];  ///< Encoded sections (text rows without the block index).
+    std::string blockStarts[ARCHIVE_SECTION_COUNT];  ///< Block index of each text column.
+    int actorCount;          ///< Actor rows added.
+    int movieCount;          ///< Movie rows added.
+    int64_t previous[ARCHIVE_SECTION_COUNT];     ///< Last value of each delta column.
+
+    /**
+     * @brief Finds a word, optionally adding it.
+     *
+     * @param s The word's first byte.
+     * @param length The word's length.
+     * @param add True to add the word if it is missing.
+     * @return int The word index, or -1 if it is missing and add is false.
+     */
+    int findWord(const char* s, uint32_t length, bool add);
+
+    /**
+     * @brief Doubles the slot table.
+     */
+    void growSlots();
+
+    /**
+     * @brief Chooses the dictionary: words seen at least twice, most frequent first.
+     */
+    void sealDictionary();
+
+    /**
+     * @brief Appends a value to an ID or year column.
+     *
+     * @param column The column.
+     * @param value The value.
+     */
+    void appendDelta(ArchiveColumn column, int value);
+
+    /**
+     * @brief Appends a value to a rating column.
+     *
+     * @param column The column.
+     * @param row The row's index in the column.
+     * @param rating The rating (0-15).
+     */
+    void appendRating(ArchiveColumn column, int row, int rating);
+
+    /**
+     * @brief Appends a row to a text column.
+     *
+     * @param column The column.
+     * @param row The row's index in the column.
+     * @param text The row's text.
+     */
+    void appendText(ArchiveColumn column, int row, const char* text);
+
+public:
+    /**
+     * @brief Constructs a writer with no rows.
+     */
+    CatalogArchiveWriter();
+
+    /**
+     * @brief Destructor.
+     */
+    ~CatalogArchiveWriter();
+
+    // Copy constructor and assignment operator are disabled for simplicity.
+    CatalogArchiveWriter(const CatalogArchiveWriter&) = delete;
+    CatalogArchiveWriter& operator=(const CatalogArchiveWriter&) = delete;
+
+    /**
+     * @brief Counts the words of a name, title or plot (first pass).
+     *
+     * @param text The text.
+     */
+    void countText(const char* text);
+
+    /**
+     * @brief Appends an actor row (second pass).
+     *
+     * @param id Actor ID.
+     * @param birthYear Birth year.
+     * @param rating Rating (0 = unrated).
+     * @param name The name.
+     */
+    void addActor(int id, int birthYear, int rating, const char* name);
+
+    /**
+     * @brief Appends a movie row (second pass).
+     *
+     * @param id Movie ID.
+     * @param releaseYear Release year.
+     * @param rating Rating (0 = unrated).
+     * @param title The title.
+     * @param plot The plot.
+     */
+    void addMovie(int id, int releaseYear, int rating, const char* title, const char* plot);
+
+    /**
+     * @brief Writes the archive through a temporary file.
+     *
+     * @param path The archive file to create or overwrite.
+     * @param nextActorId The next free actor ID.
+     * @param nextMovieId The next free movie ID.
+     * @return bool True if the archive was written completely.
+     */
+    bool write(const std::string& path, int nextActorId, int nextMovieId);
+};
+
+/**
+ * @brief Read-only view of an archive mapped into memory.
+ *
+ * Row indexes are the dense IDs the catalogue had when the archive was
+ * written. Decoding stops at the end of a section, so a damaged archive
+ * yields zeros and empty strings rather than reading out of bounds.
+ */
+class CatalogArchive {
+private:
+    MappedFile file;         ///< The mapped archive.
+    ArchiveHeader header;    ///< Copy of the header.
+    uint32_t* wordStarts;    ///< Offset of each word's text in the words section, plus the end.
+    uint32_t* wordLengths;   ///< Length of each word.
+
+    /**
+     * @brief Returns the first byte of a section.
+     *
+     * @param column The section.
+     * @return const unsigned char* The section data.
+     */
+    const unsigned char* sectionData(ArchiveColumn column) const;
+
+    /**
+     * @brief Appends one row of a text column to a string.
+     *
+     * @param p The row's first byte; advanced past the row.
+     * @param end End of the section.
+     * @param out Receives the text, or nullptr to skip the row.
+     */
+    void decodeTextRow(const unsigned char*& p, const unsigned char* end, std::string* out) const;
+
+public:
+    /**
+     * @brief Constructs a closed archive.
+     */
+    CatalogArchive();
+
+    /**
+     * @brief Destructor.
+     */
+    ~CatalogArchive();
+
+    // Copy constructor and assignment operator are disabled for simplicity.
+    CatalogArchive(const CatalogArchive&) = delete;
+    CatalogArchive& operator=(const CatalogArchive&) = delete;
+
+    /**
+     * @brief Maps an archive and checks its header, sections and dictionary.
+     *
+     * @param path The archive file.
+     * @return bool True if the archive is open.
+     */
+    bool open(const std::string& path);
+
+    /**
+     * @brief Unmaps the archive.
+     */
+    void close();
+
+    /**
+     * @brief Checks whether an archive is open.
+     *
+     * @return bool True if open.
+     */
+    bool isOpen() const;
+
+    /**
+     * @brief Returns the number of actor rows.
+     *
+     * @return int The actor count (0 when closed).
+     */
+    int getActorCount() const;
+
+    /**
+     * @brief Returns the number of movie rows.
+     *
+     * @return int The movie count (0 when closed).
+     */
+    int getMovieCount() const;
+
+    /**
+     * @brief Returns the next free actor ID recorded in the archive.
+     *
+     * @return int The next actor ID.
+     */
+    int getNextActorId() const;
+
+    /**
+     * @brief Returns the next free movie ID recorded in the archive.
+     *
+     * @return int The next movie ID.
+     */
+    int getNextMovieId() const;
+
+    /**
+     * @brief Returns the size of the archive file.
+     *
+     * @return unsigned long long Bytes (0 when closed).
+     */
+    unsigned long long getFileBytes() const;
+
+    /**
+     * @brief Decodes a whole ID, year or rating column.
+     *
+     * @param column The column (not a text column).
+     * @param out Receives one value per row; must hold the column's row count.
+     */
+    void decodeColumn(ArchiveColumn column, int* out) const;
+
+    /**
+     * @brief Decodes one row of a text column.
+     *
+     * Skips to the row's block, then over at most ARCHIVE_BLOCK_ROWS - 1 rows.
+     *
+     * @param column ARCHIVE_ACTOR_NAMES, ARCHIVE_MOVIE_TITLES or ARCHIVE_MOVIE_PLOTS.
+     * @param row The row index.
+     * @return std::string The text, or "" if the row is out of range.
+     */
+    std::string textAt(ArchiveColumn column, int row) const;
+};
+
+#endif // CATALOG_ARCHIVE_H
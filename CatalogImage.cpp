@@ -0,0 +1,456 @@
+/***************************************************************************
+ * CatalogImage.cpp
+ *
+ * Team:            Gearoid, Cedric
+ * Group:           1
+ * Student IDs:     S10241866, S10241549
+ *
+ * Features Highlight:
+ *   - Header-only validation when the image is opened.
+ *   - Binary searches over the precomputed ID, key and rating orders.
+ *   - Out-of-range references resolve to an empty record or string.
+ ***************************************************************************/
+
+#include "CatalogImage.h"
+#include <cstring>
+
+ /// Returned for record indexes outside the image.
+static const ImageActor EMPTY_ACTOR = { 0, 0, 0, { 0, 0 }, { 0, 0 }, 0 };
+static const ImageMovie EMPTY_MOVIE = { 0, 0, 0, { 0, 0 }, { 0, 0 }, { 0, 0 }, 0 };
+
+/**
+ * @brief Checks that an array section lies inside the file and is aligned.
+ *
+ * @param offset File offset of the section.
+ * @param count Number of elements.
+ * @param elementSize Size of one element.
+ * @param fileSize Size of the file.
+ * @return bool True if the section is valid.
+ */
+static bool sectionFits(uint64_t offset, uint64_t count, uint64_t elementSize, uint64_t fileSize) {
+    return offset % 8 == 0 && offset <= fileSize && count <= (fileSize - offset) / elementSize;
+}
+
+/**
+ * @brief Compares an image key with a search key.
+ *
+ * @param a The image key.
+ * @param aLength Length of the image key.
+ * @param b The search key.
+ * @return int Negative, zero or positive, like memcmp.
+ */
+static int compareKeyText(const char* a, size_t aLength, const std::string& b) {
+    size_t n = (aLength < b.size()) ? aLength : b.size();
+    int cmp = std::memcmp(a, b.data(), n);
+    if (cmp != 0) {
+        return cmp;
+    }
+    if (aLength < b.size()) return -1;
+    if (aLength > b.size()) return 1;
+    return 0;
+}
+
+/**
+ * @brief Constructs a closed image.
+ */
+CatalogImage::CatalogImage()
+    : header(),
+    actors(nullptr),
+    movies(nullptr),
+    actorIdOrder(nullptr),
+    movieIdOrder(nullptr),
+    actorNameOrder(nullptr),
+    movieTitleOrder(nullptr),
+    actorRatingOrder(nullptr),
+    movieRatingOrder(nullptr),
+    castStart(nullptr),
+    castActors(nullptr),
+    filmStart(nullptr),
+    filmMovies(nullptr),
+    text(nullptr)
+{
+}
+
+/**
+ * @brief Maps an image and checks its header.
+ *
+ * Only the header and the section bounds are checked, so opening takes the
+ * same time whatever the size of the catalogue.
+ *
+ * @param path The image file.
+ * @return bool True on success.
+ */
+bool CatalogImage::open(const std::string& path) {
+    close();
+    if (!file.open(path)) {
+        return false;
+    }
+    uint64_t size = file.size();
+    if (size < sizeof(ImageHeader)) {
+        file.close();
+        return false;
+    }
+    std::memcpy(&header, file.data(), sizeof(ImageHeader));
+    bool valid = header.magic == CATALOG_IMAGE_MAGIC
+        && header.version == CATALOG_IMAGE_VERSION
+        && header.ratedActorCount <= header.actorCount
+        && header.ratedMovieCount <= header.movieCount
+        && sectionFits(header.actorsOffset, header.actorCount, sizeof(ImageActor), size)
+        && sectionFits(header.moviesOffset, header.movieCount, sizeof(ImageMovie), size)
+        && sectionFits(header.actorIdOrderOffset, header.actorCount, sizeof(uint32_t), size)
+        && sectionFits(header.movieIdOrderOffset, header.movieCount, sizeof(uint32_t), size)
+        && sectionFits(header.actorNameOrderOffset, header.actorCount, sizeof(uint32_t), size)
+        && sectionFits(header.movieTitleOrderOffset, header.movieCount, sizeof(uint32_t), size)
+        && sectionFits(header.actorRatingOrderOffset, header.ratedActorCount, sizeof(uint32_t), size)
+        && sectionFits(header.movieRatingOrderOffset, header.ratedMovieCount, sizeof(uint32_t), size)
+        && sectionFits(header.castStartOffset, static_cast<uint64_t>(header.movieCount) + 1, sizeof(uint32_t), size)
+        && sectionFits(header.castActorsOffset, header.castCount, sizeof(uint32_t), size)
+        && sectionFits(header.filmStartOffset, static_cast<uint64_t>(header.actorCount) + 1, sizeof(uint32_t), size)
+        && sectionFits(header.filmMoviesOffset, header.castCount, sizeof(uint32_t), size)
+        && header.textBytes > 0
+        && sectionFits(header.textOffset, header.textBytes, 1, size);
+    if (!valid) {
+        file.close();
+        return false;
+    }
+    const char* base = file.data();
+    actors = reinterpret_cast<const ImageActor*>(base + header.actorsOffset);
+    movies = reinterpret_cast<const ImageMovie*>(base + header.moviesOffset);
+    actorIdOrder = reinterpret_cast<const uint32_t*>(base + header.actorIdOrderOffset);
+    movieIdOrder = reinterpret_cast<const uint32_t*>(base + header.movieIdOrderOffset);
+    actorNameOrder = reinterpret_cast<const uint32_t*>(base + header.actorNameOrderOffset);
+    movieTitleOrder = reinterpret_cast<const uint32_t*>(base + header.movieTitleOrderOffset);
+    actorRatingOrder = reinterpret_cast<const uint32_t*>(base + header.actorRatingOrderOffset);
+    movieRatingOrder = reinterpret_cast<const uint32_t*>(base + header.movieRatingOrderOffset);
+    castStart = reinterpret_cast<const uint32_t*>(base + header.castStartOffset);
+    castActors = reinterpret_cast<const uint32_t*>(base + header.castActorsOffset);
+    filmStart = reinterpret_cast<const uint32_t*>(base + header.filmStartOffset);
+    filmMovies = reinterpret_cast<const uint32_t*>(base + header.filmMoviesOffset);
+    text = base + header.textOffset;
+    return true;
+}
+
+/**
+ * @brief Unmaps the image.
+ */
+void CatalogImage::close() {
+    file.close();
+    header = ImageHeader();
+    actors = nullptr;
+    movies = nullptr;
+    text = nullptr;
+}
+
+/**
+ * @brief Checks whether an image is open.
+ *
+ * @return bool True if open.
+ */
+bool CatalogImage::isOpen() const {
+    return file.isOpen() && text != nullptr;
+}
+
+/**
+ * @brief Returns the number of actor records.
+ *
+ * @return int The actor count.
+ */
+int CatalogImage::getActorCount() const {
+    return static_cast<int>(header.actorCount);
+}
+
+/**
+ * @brief Returns the number of movie records.
+ *
+ * @return int The movie count.
+ */
+int CatalogImage::getMovieCount() const {
+    return static_cast<int>(header.movieCount);
+}
+
+/**
+ * @brief Returns the next actor ID recorded in the image.
+ *
+ * @return int The next actor ID.
+ */
+int CatalogImage::getNextActorId() const {
+    return header.nextActorId;
+}
+
+/**
+ * @brief Returns the next movie ID recorded in the image.
+ *
+ * @return int The next movie ID.
+ */
+int CatalogImage::getNextMovieId() const {
+    return header.nextMovieId;
+}
+
+/**
+ * @brief Returns the last mutation log sequence recorded in the image.
+ *
+ * @return uint64_t The sequence.
+ */
+uint64_t CatalogImage::getLogSequence() const {
+    return header.logSequence;
+}
+
+/**
+ * @brief Returns an actor record.
+ *
+ * @param index Record index.
+ * @return const ImageActor& The record, or an empty record if out of range.
+ */
+const ImageActor& CatalogImage::actorAt(int index) const {
+    if (index < 0 || static_cast<uint32_t>(index) >= header.actorCount) {
+        return EMPTY_ACTOR;
+    }
+    return actors[index];
+}
+
+/**
+ * @brief Returns a movie record.
+ *
+ * @param index Record index.
+ * @return const ImageMovie& The record, or an empty record if out of range.
+ */
+const ImageMovie& CatalogImage::movieAt(int index) const {
+    if (index < 0 || static_cast<uint32_t>(index) >= header.movieCount) {
+        return EMPTY_MOVIE;
+    }
+    return movies[index];
+}
+
+/**
+ * @brief Resolves a string of the text section.
+ *
+ * @param t The string reference.
+ * @return const char* The text, or "" if the reference is invalid.
+ */
+const char* CatalogImage::textOf(ImageText t) const {
+    uint64_t end = static_cast<uint64_t>(t.offset) + t.length;
+    if (text == nullptr || end >= header.textBytes || text[end] != '\0') {
+        return "";
+    }
+    return text + t.offset;
+}
+
+/**
+ * @brief Binary search over actorIdOrder.
+ *
+ * @param id The actor ID.
+ * @return int The record index, or -1.
+ */
+int CatalogImage::findActor(int id) const {
+    int low = 0;
+    int high = getActorCount() - 1;
+    while (low <= high) {
+        int mid = low + (high - low) / 2;
+        int index = static_cast<int>(actorIdOrder[mid]);
+        int midId = actorAt(index).id;
+        if (midId == id) {
+            return (index < getActorCount()) ? index : -1;
+        }
+        if (midId < id) {
+            low = mid + 1;
+        }
+        else {
+            high = mid - 1;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Binary search over movieIdOrder.
+ *
+ * @param id The movie ID.
+ * @return int The record index, or -1.
+ */
+int CatalogImage::findMovie(int id) const {
+    int low = 0;
+    int high = getMovieCount() - 1;
+    while (low <= high) {
+        int mid = low + (high - low) / 2;
+        int index = static_cast<int>(movieIdOrder[mid]);
+        int midId = movieAt(index).id;
+        if (midId == id) {
+            return (index < getMovieCount()) ? index : -1;
+        }
+        if (midId < id) {
+            low = mid + 1;
+        }
+        else {
+            high = mid - 1;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Returns the actor indexes in name order.
+ *
+ * @return const uint32_t* The order.
+ */
+const uint32_t* CatalogImage::getActorNameOrder() const {
+    return actorNameOrder;
+}
+
+/**
+ * @brief Returns the movie indexes in title order.
+ *
+ * @return const uint32_t* The order.
+ */
+const uint32_t* CatalogImage::getMovieTitleOrder() const {
+    return movieTitleOrder;
+}
+
+/**
+ * @brief Finds the run of an order array whose keys equal a search key.
+ *
+ * Two binary searches find the lower and upper bounds of the run.
+ *
+ * @param order The order array.
+ * @param count Entries in the order.
+ * @param keyOf Returns the ImageText key of a record index.
+ * @param key The search key.
+ * @param first Receives the start of the run.
+ * @return int The length of the run.
+ */
+template <typename KeyOf>
+int CatalogImage::equalKeyRange(const uint32_t* order, int count, const KeyOf& keyOf,
+    const std::string& key, int& first) const {
+    auto compareAt = [&](int pos) {
+        ImageText t = keyOf(static_cast<int>(order[pos]));
+        return compareKeyText(textOf(t), t.length, key);
+    };
+    int low = 0;
+    int high = count;
+    while (low < high) {
+        int mid = low + (high - low) / 2;
+        if (compareAt(mid) < 0) low = mid + 1;
+        else high = mid;
+    }
+    first = low;
+    high = count;
+    while (low < high) {
+        int mid = low + (high - low) / 2;
+        if (compareAt(mid) <= 0) low = mid + 1;
+        else high = mid;
+    }
+    return low - first;
+}
+
+/**
+ * @brief Finds the actors whose name folds to a key.
+ *
+ * @param key The folded name.
+ * @param first Receives the first position in the name order.
+ * @return int The number of matches.
+ */
+int CatalogImage::actorsWithKey(const std::string& key, int& first) const {
+    return equalKeyRange(actorNameOrder, getActorCount(),
+        [this](int index) { return actorAt(index).key; }, key, first);
+}
+
+/**
+ * @brief Finds the movies whose title folds to a key.
+ *
+ * @param key The folded title.
+ * @param first Receives the first position in the title order.
+ * @return int The number of matches.
+ */
+int CatalogImage::moviesWithKey(const std::string& key, int& first) const {
+    return equalKeyRange(movieTitleOrder, getMovieCount(),
+        [this](int index) { return movieAt(index).key; }, key, first);
+}
+
+/**
+ * @brief Returns the rated actors with a given rating.
+ *
+ * @param rating The rating.
+ * @param count Receives the number of actors.
+ * @return const uint32_t* Their record indexes.
+ */
+const uint32_t* CatalogImage::actorsWithRating(int rating, int& count) const {
+    int total = static_cast<int>(header.ratedActorCount);
+    int low = 0;
+    int high = total;
+    while (low < high) {
+        int mid = low + (high - low) / 2;
+        if (actorAt(static_cast<int>(actorRatingOrder[mid])).rating < rating) low = mid + 1;
+        else high = mid;
+    }
+    int first = low;
+    while (low < total && actorAt(static_cast<int>(actorRatingOrder[low])).rating == rating) {
+        ++low;
+    }
+    count = low - first;
+    return actorRatingOrder + first;
+}
+
+/**
+ * @brief Returns the rated movies with a given rating.
+ *
+ * @param rating The rating.
+ * @param count Receives the number of movies.
+ * @return const uint32_t* Their record indexes.
+ */
+const uint32_t* CatalogImage::moviesWithRating(int rating, int& count) const {
+    int total = static_cast<int>(header.ratedMovieCount);
+    int low = 0;
+    int high = total;
+    while (low < high) {
+        int mid = low + (high - low) / 2;
+        if (movieAt(static_cast<int>(movieRatingOrder[mid])).rating < rating) low = mid + 1;
+        else high = mid;
+    }
+    int first = low;
+    while (low < total && movieAt(static_cast<int>(movieRatingOrder[low])).rating == rating) {
+        ++low;
+    }
+    count = low - first;
+    return movieRatingOrder + first;
+}
+
+/**
+ * @brief Returns the cast of a movie.
+ *
+ * @param movieIndex The movie's record index.
+ * @param count Receives the cast size (0 if the CSR entry is invalid).
+ * @return const uint32_t* The actor indexes.
+ */
+const uint32_t* CatalogImage::castOf(int movieIndex, int& count) const {
+    count = 0;
+    if (movieIndex < 0 || static_cast<uint32_t>(movieIndex) >= header.movieCount) {
+        return castActors;
+    }
+    uint32_t begin = castStart[movieIndex];
+    uint32_t end = castStart[movieIndex + 1];
+    if (begin > end || end > header.castCount) {
+        return castActors;
+    }
+    count = static_cast<int>(end - begin);
+    return castActors + begin;
+}
+
+/**
+ * @brief Returns the filmography of an actor.
+ *
+ * @param actorIndex The actor's record index.
+ * @param count Receives the number of movies (0 if the CSR entry is invalid).
+ * @return const uint32_t* The movie indexes.
+ */
+const uint32_t* CatalogImage::filmsOf(int actorIndex, int& count) const {
+    count = 0;
+    if (actorIndex < 0 || static_cast<uint32_t>(actorIndex) >= header.actorCount) {
+        return filmMovies;
+    }
+    uint32_t begin = filmStart[actorIndex];
+    uint32_t end = filmStart[actorIndex + 1];
+    if (begin > end || end > header.castCount) {
+        return filmMovies;
+    }
+    count = static_cast<int>(end - begin);
+    return filmMovies + begin;
+}
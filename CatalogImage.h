@@ -0,0 +1,352 @@
+#ifndef CATALOG_IMAGE_H
+#define CATALOG_IMAGE_H
+
+#include "MappedFile.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/***************************************************************************
+ * CatalogImage.h
+ *
+ * Team:            Gearoid, Cedric
+ * Group:           1
+ * Student IDs:     S10241866, S10241549
+ *
+ * Features Highlight:
+ *   - A read-only, pointer-free image of the whole catalogue that MovieApp
+ *     serves queries from in place (see MovieApp::openImage).
+ *   - Everything a query needs is precomputed: records in dense ID order,
+ *     ID indexes, name/title orders, cast and filmography CSR arrays and
+ *     rating orders. Opening an image only maps the file and checks its
+ *     header, so startup cost does not depend on the catalogue size, and
+ *     processes serving the same image share its pages in the OS cache.
+ *   - Lookups are bounds-checked as they are made instead of validating
+ *     every record when the file is opened.
+ *
+ *   File layout (native little-endian, every section 8-byte aligned):
+ *     ImageHeader
+ *     ImageActor[actorCount]              in dense ID order
+ *     ImageMovie[movieCount]              in dense ID order
+ *     uint32 actorIdOrder[actorCount]     record indexes sorted by ID
+ *     uint32 movieIdOrder[movieCount]
+ *     uint32 actorNameOrder[actorCount]   sorted by collation key
+ *     uint32 movieTitleOrder[movieCount]
+ *     uint32 actorRatingOrder[ratedActorCount]  rated records, by rating
+ *     uint32 movieRatingOrder[ratedMovieCount]
+ *     uint32 castStart[movieCount + 1]    CSR: movie -> actor indexes
+ *     uint32 castActors[castCount]
+ *     uint32 filmStart[actorCount + 1]    CSR: actor -> movie indexes
+ *     uint32 filmMovies[castCount]
+ *     text                                NUL-terminated strings
+ *
+ ***************************************************************************/
+
+/// "DSAI" read as a little-endian 32-bit integer.
+static const uint32_t CATALOG_IMAGE_MAGIC = 0x49415344u;
+
+/// Bumped whenever a section layout or the collation key folding changes.
+static const uint32_t CATALOG_IMAGE_VERSION = 3;
+
+/**
+ * @brief A string in the image's text section.
+ */
+struct ImageText {
+    uint32_t offset;         ///< Offset of the first byte in the text section.
+    uint32_t length;         ///< Length, excluding the NUL terminator.
+};
+
+/**
+ * @brief Fixed-size header at offset 0 of an image file.
+ */
+struct ImageHeader {
+    uint32_t magic;                  ///< CATALOG_IMAGE_MAGIC.
+    uint32_t version;                ///< CATALOG_IMAGE_VERSION.
+    uint32_t actorCount;             ///< Number of ImageActor records.
+    uint32_t movieCount;             ///< Number of ImageMovie records.
+    uint32_t castCount;              ///< Number of cast links.
+    uint32_t ratedActorCount;        ///< Entries in actorRatingOrder.
+    uint32_t ratedMovieCount;        ///< Entries in movieRatingOrder.
+    int32_t nextActorId;             ///< MovieApp::nextActorId when written.
+    int32_t nextMovieId;             ///< MovieApp::nextMovieId when written.
+    uint32_t reserved;               ///< Zero; keeps the offsets 8-byte aligned.
+    uint64_t actorsOffset;           ///< File offset of the actor records.
+    uint64_t moviesOffset;           ///< File offset of the movie records.
+    uint64_t actorIdOrderOffset;     ///< File offset of actorIdOrder.
+    uint64_t movieIdOrderOffset;     ///< File offset of movieIdOrder.
+    uint64_t actorNameOrderOffset;   ///< File offset of actorNameOrder.
+    uint64_t movieTitleOrderOffset;  ///< File offset of movieTitleOrder.
+    uint64_t actorRatingOrderOffset; ///< File offset of actorRatingOrder.
+    uint64_t movieRatingOrderOffset; ///< File offset of movieRatingOrder.
+    uint64_t castStartOffset;        ///< File offset of castStart.
+    uint64_t castActorsOffset;       ///< File offset of castActors.
+    uint64_t filmStartOffset;        ///< File offset of filmStart.
+    uint64_t filmMoviesOffset;       ///< File offset of filmMovies.
+    uint64_t textOffset;             ///< File offset of the text section.
+    uint64_t textBytes;              ///< Size of the text section.
+    uint64_t logSequence;            ///< Last mutation log sequence contained in the image.
+};
+
+/**
+ * @brief One actor record.
+ */
+struct ImageActor {
+    int32_t id;              ///< Actor ID.
+    int32_t birthYear;       ///< Birth year.
+    int32_t rating;          ///< Rating (0 = unrated).
+    ImageText name;          ///< The name.
+    ImageText key;           ///< The name's collation key.
+    uint32_t reserved;       ///< Zero; pads the record to 32 bytes.
+};
+
+/**
+ * @brief One movie record.
+ */
+struct ImageMovie {
+    int32_t id;              ///< Movie ID.
+    int32_t releaseYear;     ///< Release year.
+    int32_t rating;          ///< Rating (0 = unrated).
+    ImageText title;         ///< The title.
+    ImageText key;           ///< The title's collation key.
+    ImageText plot;          ///< The plot.
+    uint32_t reserved;       ///< Zero; pads the record to 40 bytes.
+};
+
+/**
+ * @brief An actor as MovieApp sees it while serving an image: either the
+ *        image record or the overlay record that replaced it.
+ */
+struct CatalogActorRow {
+    int id;                  ///< Actor ID.
+    int birthYear;           ///< Birth year.
+    int rating;              ///< Rating.
+    const char* name;        ///< The name.
+    const char* key;         ///< The collation key (not NUL-terminated for overlay rows).
+    unsigned int keyLength;  ///< Length of the collation key.
+};
+
+/**
+ * @brief A movie as MovieApp sees it while serving an image.
+ */
+struct CatalogMovieRow {
+    int id;                  ///< Movie ID.
+    int releaseYear;         ///< Release year.
+    int rating;              ///< Rating.
+    const char* title;       ///< The title.
+    const char* key;         ///< The collation key.
+    unsigned int keyLength;  ///< Length of the collation key.
+};
+
+/**
+ * @brief Read-only view of a catalogue image mapped into memory.
+ *
+ * Record indexes used by this class are the dense IDs the catalogue had
+ * when the image was written.
+ */
+class CatalogImage {
+private:
+    MappedFile file;                 ///< The mapped image.
+    ImageHeader header;              ///< Copy of the header.
+    const ImageActor* actors;        ///< Actor records.
+    const ImageMovie* movies;        ///< Movie records.
+    const uint32_t* actorIdOrder;    ///< Actor indexes sorted by ID.
+    const uint32_t* movieIdOrder;    ///< Movie indexes sorted by ID.
+    const uint32_t* actorNameOrder;  ///< Actor indexes sorted by name key.
+    const uint32_t* movieTitleOrder; ///< Movie indexes sorted by title key.
+    const uint32_t* actorRatingOrder; ///< Rated actor indexes sorted by rating.
+    const uint32_t* movieRatingOrder; ///< Rated movie indexes sorted by rating.
+    const uint32_t* castStart;       ///< CSR offsets into castActors.
+    const uint32_t* castActors;      ///< Actor indexes of every cast.
+    const uint32_t* filmStart;       ///< CSR offsets into filmMovies.
+    const uint32_t* filmMovies;      ///< Movie indexes of every filmography.
+    const char* text;                ///< The text section.
+
+    /**
+     * @brief Returns the range of an order array whose keys equal a search key.
+     *
+     * @param order The name or title order.
+     * @param count Entries in the order.
+     * @param keyOf Returns the key of a record index.
+     * @param key The folded search key.
+     * @param first Receives the position of the first match.
+     * @return int The number of matches.
+     */
+    template <typename KeyOf>
+    int equalKeyRange(const uint32_t* order, int count, const KeyOf& keyOf,
+        const std::string& key, int& first) const;
+
+public:
+    /**
+     * @brief Constructs a closed image.
+     */
+    CatalogImage();
+
+    // Copy constructor and assignment operator are disabled for simplicity.
+    CatalogImage(const CatalogImage&) = delete;
+    CatalogImage& operator=(const CatalogImage&) = delete;
+
+    /**
+     * @brief Maps an image and checks its header and section bounds.
+     *
+     * @param path The image file.
+     * @return bool True if the image is open.
+     */
+    bool open(const std::string& path);
+
+    /**
+     * @brief Unmaps the image.
+     */
+    void close();
+
+    /**
+     * @brief Checks whether an image is open.
+     *
+     * @return bool True if open.
+     */
+    bool isOpen() const;
+
+    /**
+     * @brief Returns the number of actor records.
+     *
+     * @return int The actor count (0 when closed).
+     */
+    int getActorCount() const;
+
+    /**
+     * @brief Returns the number of movie records.
+     *
+     * @return int The movie count (0 when closed).
+     */
+    int getMovieCount() const;
+
+    /**
+     * @brief Returns the next free actor ID recorded in the image.
+     *
+     * @return int The next actor ID.
+     */
+    int getNextActorId() const;
+
+    /**
+     * @brief Returns the next free movie ID recorded in the image.
+     *
+     * @return int The next movie ID.
+     */
+    int getNextMovieId() const;
+
+    /**
+     * @brief Returns the last mutation log sequence the image contains.
+     *
+     * @return uint64_t The sequence, or 0 if it contains no logged change.
+     */
+    uint64_t getLogSequence() const;
+
+    /**
+     * @brief Returns an actor record.
+     *
+     * @param index Record index (0 <= index < getActorCount()).
+     * @return const ImageActor& The record.
+     */
+    const ImageActor& actorAt(int index) const;
+
+    /**
+     * @brief Returns a movie record.
+     *
+     * @param index Record index (0 <= index < getMovieCount()).
+     * @return const ImageMovie& The record.
+     */
+    const ImageMovie& movieAt(int index) const;
+
+    /**
+     * @brief Resolves a string of the text section.
+     *
+     * @param t The string reference.
+     * @return const char* The NUL-terminated text, or "" if t is out of range.
+     */
+    const char* textOf(ImageText t) const;
+
+    /**
+     * @brief Finds an actor record by actor ID with a binary search.
+     *
+     * @param id The actor ID.
+     * @return int The record index, or -1 if the image has no such actor.
+     */
+    int findActor(int id) const;
+
+    /**
+     * @brief Finds a movie record by movie ID with a binary search.
+     *
+     * @param id The movie ID.
+     * @return int The record index, or -1 if the image has no such movie.
+     */
+    int findMovie(int id) const;
+
+    /**
+     * @brief Returns the actor indexes in name order.
+     *
+     * @return const uint32_t* getActorCount() indexes.
+     */
+    const uint32_t* getActorNameOrder() const;
+
+    /**
+     * @brief Returns the movie indexes in title order.
+     *
+     * @return const uint32_t* getMovieCount() indexes.
+     */
+    const uint32_t* getMovieTitleOrder() const;
+
+    /**
+     * @brief Finds the actors whose name folds to a key.
+     *
+     * @param key The folded name.
+     * @param first Receives the position of the first match in getActorNameOrder().
+     * @return int The number of matches (0 if none).
+     */
+    int actorsWithKey(const std::string& key, int& first) const;
+
+    /**
+     * @brief Finds the movies whose title folds to a key.
+     *
+     * @param key The folded title.
+     * @param first Receives the position of the first match in getMovieTitleOrder().
+     * @return int The number of matches (0 if none).
+     */
+    int moviesWithKey(const std::string& key, int& first) const;
+
+    /**
+     * @brief Returns the rated actors with a given rating.
+     *
+     * @param rating The rating.
+     * @param count Receives the number of actors.
+     * @return const uint32_t* Their record indexes, in dense ID order.
+     */
+    const uint32_t* actorsWithRating(int rating, int& count) const;
+
+    /**
+     * @brief Returns the rated movies with a given rating.
+     *
+     * @param rating The rating.
+     * @param count Receives the number of movies.
+     * @return const uint32_t* Their record indexes, in dense ID order.
+     */
+    const uint32_t* moviesWithRating(int rating, int& count) const;
+
+    /**
+     * @brief Returns the cast of a movie.
+     *
+     * @param movieIndex The movie's record index.
+     * @param count Receives the cast size.
+     * @return const uint32_t* The actors' record indexes, in cast order.
+     */
+    const uint32_t* castOf(int movieIndex, int& count) const;
+
+    /**
+     * @brief Returns the filmography of an actor.
+     *
+     * @param actorIndex The actor's record index.
+     * @param count Receives the number of movies.
+     * @return const uint32_t* The movies' record indexes, in dense ID order.
+     */
+    const uint32_t* filmsOf(int actorIndex, int& count) const;
+};
+
+#endif // CATALOG_IMAGE_H
@@ -0,0 +1,560 @@
+/***************************************************************************
+ * ChunkedCsv.cpp
+ *
+ * Team:            Gearoid, Cedric
+ * Group:           1
+ * Student IDs:     S10241866, S10241549
+ *
+ * Features Highlight:
+ *   - Line-aligned chunk splitting.
+ *   - Per-thread staging buffers.
+ *   - std::thread fan-out with the caller doing the first chunk.
+ *   - Chunk parsers for the actor, movie and cast files.
+ ***************************************************************************/
+
+#include "ChunkedCsv.h"
+#include "CsvScanner.h"
+#include "Collation.h"
+#include "LoadReport.h"
+#include <cstring>
+#include <iostream>
+#include <thread>
+
+// Smallest slice of a CSV file worth parsing on a thread of its own.
+static const size_t CSV_MIN_CHUNK_BYTES = 1 << 20;
+
+ /**
+  * @brief Constructs an empty staging buffer.
+  */
+template <typename T>
+StagingBuffer<T>::StagingBuffer()
+    : rows(new T[1024]),
+    count(0),
+    capacity(1024),
+    rejected(0),
+    badNumbers(0),
+    cpuMillis(0.0)
+{
+}
+
+/**
+ * @brief Destructor.
+ */
+template <typename T>
+StagingBuffer<T>::~StagingBuffer() {
+    delete[] rows;
+}
+
+/**
+ * @brief Appends a row.
+ *
+ * @param row The row to append.
+ */
+template <typename T>
+void StagingBuffer<T>::add(const T& row) {
+    if (count >= capacity) {
+        int newCapacity = capacity * 2;
+        T* newArr = new T[newCapacity];
+        for (int i = 0; i < count; ++i) {
+            newArr[i] = rows[i];
+        }
+        delete[] rows;
+        rows = newArr;
+        capacity = newCapacity;
+    }
+    rows[count++] = row;
+}
+
+/**
+ * @brief Returns the number of staged rows.
+ *
+ * @return int The row count.
+ */
+template <typename T>
+int StagingBuffer<T>::size() const {
+    return count;
+}
+
+/**
+ * @brief Returns a staged row.
+ *
+ * @param index Row index.
+ * @return const T& The row.
+ */
+template <typename T>
+const T& StagingBuffer<T>::at(int index) const {
+    return rows[index];
+}
+
+/**
+ * @brief Splits [start, size) into line-aligned chunks.
+ *
+ * Each tentative boundary is pushed forward past the next '\n' that is not
+ * inside a quoted field, so no row is ever cut in two. Whether a position is
+ * inside quotes follows from the parity of the quotes before it (an escaped
+ * "" adds two), which is tracked with a running count from the first row.
+ *
+ * @param data The buffer.
+ * @param start First byte after the header.
+ * @param size Buffer size.
+ * @param maxChunks Maximum number of chunks.
+ * @param minChunkBytes Minimum bytes per chunk.
+ * @param chunks Output array.
+ * @return int The number of chunks.
+ */
+int splitCsvChunks(const char* data, size_t start, size_t size, int maxChunks,
+    size_t minChunkBytes, CsvChunk* chunks) {
+    size_t total = (size > start) ? size - start : 0;
+    int n = maxChunks;
+    if (minChunkBytes > 0 && total / minChunkBytes < static_cast<size_t>(n)) {
+        n = static_cast<int>(total / minChunkBytes);
+    }
+    if (n < 1) n = 1;
+
+    int written = 0;
+    size_t begin = start;
+    size_t quotes = 0;  // Quotes in [start, begin).
+    const char* last = data + size;
+    for (int i = 1; i < n && begin < size; ++i) {
+        size_t target = start + total / n * i;
+        if (target <= begin) continue;
+        quotes += CsvScanner::countQuotes(data + begin, data + target);
+        const char* p = data + target;
+        while (true) {
+            p = CsvScanner::findEither(p, last, '\n', '"');
+            if (p == last || (*p == '\n' && quotes % 2 == 0)) break;
+            if (*p == '"') ++quotes;
+            ++p;
+        }
+        size_t end = (p == last) ? size : static_cast<size_t>(p - data) + 1;
+        chunks[written].begin = begin;
+        chunks[written].end = end;
+        ++written;
+        begin = end;
+    }
+    chunks[written].begin = begin;
+    chunks[written].end = size;
+    return written + 1;
+}
+
+/**
+ * @brief Returns the number of worker threads to use.
+ *
+ * @return int Between 1 and 16.
+ */
+int csvWorkerCount() {
+    unsigned int n = std::thread::hardware_concurrency();
+    if (n == 0) return 1;
+    if (n > 16) return 16;
+    return static_cast<int>(n);
+}
+
+/**
+ * @brief Runs the tasks on worker threads and joins them.
+ *
+ * @param count Number of tasks.
+ * @param work The task body.
+ */
+void runCsvChunks(int count, const std::function<void(int)>& work) {
+    if (count <= 0) return;
+    std::thread* workers = new std::thread[count];
+    for (int i = 1; i < count; ++i) {
+        workers[i] = std::thread(work, i);
+    }
+    work(0);
+    for (int i = 1; i < count; ++i) {
+        workers[i].join();
+    }
+    delete[] workers;
+}
+
+// ---------------------------------------------------------------------------
+// CsvStage
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Finds where the rows of a mapped CSV file start.
+ *
+ * @param data The mapped file.
+ * @param size The file size.
+ * @return size_t Offset of the first byte after the header line.
+ */
+static size_t csvBodyStart(const char* data, size_t size) {
+    const char* newline = static_cast<const char*>(std::memchr(data, '\n', size));
+    return newline ? static_cast<size_t>(newline - data) + 1 : size;
+}
+
+/**
+ * @brief Returns the value of a CSV field as the loaders store it.
+ *
+ * Quoted fields are kept exactly as written between the quotes. Unquoted
+ * fields are trimmed of spaces and stray quotes, as trimQuotes() does.
+ *
+ * @param csv The scanner positioned on a row.
+ * @param index The field index.
+ * @return std::string_view The field value (escapes not yet collapsed).
+ */
+static std::string_view csvFieldText(const CsvScanner& csv, int index) {
+    std::string_view text = csv.field(index);
+    return csv.isQuoted(index) ? text : CsvScanner::trim(text, " \"");
+}
+
+/**
+ * @brief Constructs an empty stage.
+ */
+template <typename T>
+CsvStage<T>::CsvStage()
+    : chunks(nullptr),
+    chunkCount(0),
+    staged(nullptr),
+    end(0)
+{
+}
+
+/**
+ * @brief Destructor.
+ */
+template <typename T>
+CsvStage<T>::~CsvStage() {
+    delete[] staged;
+    delete[] chunks;
+}
+
+/**
+ * @brief Maps a CSV file and splits it into chunks.
+ *
+ * @param filename The CSV file.
+ * @return bool True if the file has content.
+ */
+template <typename T>
+bool CsvStage<T>::open(const std::string& filename) {
+    if (!file.open(filename)) {
+        std::cerr << "[Error] Could not open file: " << filename << "\n";
+        return false;
+    }
+    if (file.size() == 0) {
+        std::cerr << "[Error] File is empty: " << filename << "\n";
+        return false;
+    }
+    end = file.size();
+    split(csvBodyStart(file.data(), file.size()));
+    return true;
+}
+
+/**
+ * @brief Maps a CSV file and stages the complete rows after an offset.
+ *
+ * The end of the last complete row is found by scanning forward from the
+ * offset for newlines outside quoted fields.
+ *
+ * @param filename The CSV file.
+ * @param offset Where the previous read ended.
+ * @return bool True if the file is open.
+ */
+template <typename T>
+bool CsvStage<T>::openAppended(const std::string& filename, size_t offset) {
+    if (!file.open(filename)) {
+        std::cerr << "[Error] Could not open file: " << filename << "\n";
+        return false;
+    }
+    size_t size = file.size();
+    if (size == 0) {
+        end = 0;
+        split(0);
+        return true;
+    }
+    size_t begin = csvBodyStart(file.data(), size);
+    if (offset > begin && offset <= size) {
+        begin = offset;
+    }
+    end = begin;
+    size_t quotes = 0;
+    const char* last = file.data() + size;
+    const char* p = file.data() + begin;
+    while (true) {
+        p = CsvScanner::findEither(p, last, '\n', '"');
+        if (p == last) break;
+        if (*p == '"') {
+            ++quotes;
+        }
+        else if (quotes % 2 == 0) {
+            end = static_cast<size_t>(p - file.data()) + 1;
+        }
+        ++p;
+    }
+    split(begin);
+    return true;
+}
+
+/**
+ * @brief Splits [begin, end) into chunks and allocates their buffers.
+ *
+ * @param begin Offset of the first row.
+ */
+template <typename T>
+void CsvStage<T>::split(size_t begin) {
+    int maxChunks = csvWorkerCount();
+    chunks = new CsvChunk[maxChunks];
+    chunkCount = splitCsvChunks(file.data(), begin, end, maxChunks, CSV_MIN_CHUNK_BYTES, chunks);
+    staged = new StagingBuffer<T>[chunkCount];
+}
+
+/**
+ * @brief Returns where the staged rows end.
+ *
+ * @return size_t Offset one past the last staged byte.
+ */
+template <typename T>
+size_t CsvStage<T>::getEnd() const {
+    return end;
+}
+
+/**
+ * @brief Returns the number of chunks.
+ *
+ * @return int The chunk count.
+ */
+template <typename T>
+int CsvStage<T>::getChunkCount() const {
+    return chunkCount;
+}
+
+/**
+ * @brief Parses every chunk on its own thread.
+ */
+template <typename T>
+void CsvStage<T>::parseAll() {
+    runCsvChunks(chunkCount, [this](int c) {
+        double start = threadCpuMillis();
+        parseChunk(c);
+        staged[c].cpuMillis = threadCpuMillis() - start;
+        });
+}
+
+/**
+ * @brief Returns the number of staged rows over all chunks.
+ *
+ * @return int The row count.
+ */
+template <typename T>
+int CsvStage<T>::getRowCount() const {
+    int rows = 0;
+    for (int c = 0; c < chunkCount; ++c) {
+        rows += staged[c].size();
+    }
+    return rows;
+}
+
+/**
+ * @brief Returns the number of rows the parsers dropped for a missing field.
+ *
+ * @return int The dropped row count.
+ */
+template <typename T>
+int CsvStage<T>::getRejectedCount() const {
+    int rows = 0;
+    for (int c = 0; c < chunkCount; ++c) {
+        rows += staged[c].rejected;
+    }
+    return rows;
+}
+
+/**
+ * @brief Returns the number of rows the parsers dropped for a bad number.
+ *
+ * @return int The dropped row count.
+ */
+template <typename T>
+int CsvStage<T>::getBadNumberCount() const {
+    int rows = 0;
+    for (int c = 0; c < chunkCount; ++c) {
+        rows += staged[c].badNumbers;
+    }
+    return rows;
+}
+
+/**
+ * @brief Returns the CPU time spent parsing, summed over the worker threads.
+ *
+ * @return double Milliseconds.
+ */
+template <typename T>
+double CsvStage<T>::getParseCpuMillis() const {
+    double millis = 0.0;
+    for (int c = 0; c < chunkCount; ++c) {
+        millis += staged[c].cpuMillis;
+    }
+    return millis;
+}
+
+/**
+ * @brief Returns the mapped file.
+ *
+ * @return const char* The first byte of the file.
+ */
+template <typename T>
+const char* CsvStage<T>::data() const {
+    return file.data();
+}
+
+/**
+ * @brief Returns the rows staged from a chunk.
+ *
+ * @param c The chunk index.
+ * @return const StagingBuffer<T>& The buffer.
+ */
+template <typename T>
+const StagingBuffer<T>& CsvStage<T>::rowsOf(int c) const {
+    return staged[c];
+}
+
+/**
+ * @brief Parses a chunk of actors.csv.
+ *
+ * Each row is staged as its ID, birth year, name position and folded name
+ * key. Rows with a missing field or a bad number are skipped and counted
+ * as rejected.
+ *
+ * @param c The chunk index.
+ */
+template <>
+void CsvStage<StagedActorRow>::parseChunk(int c) {
+    CsvScanner csv(file.data() + chunks[c].begin, chunks[c].end - chunks[c].begin);
+    StagingBuffer<StagedActorRow>& out = staged[c];
+    while (csv.nextRow()) {
+        if (csv.row().empty()) continue;
+
+        std::string_view idField = csv.field(0);
+        std::string_view nameField = csv.field(1);
+        std::string_view birthField = csv.field(2);
+
+        // Skip malformed rows.
+        if (idField.empty() || nameField.empty() || birthField.empty()) {
+            ++out.rejected;
+            continue;
+        }
+
+        StagedActorRow row;
+        if (!CsvScanner::toInt(idField, row.id) || !CsvScanner::toInt(birthField, row.birthYear)) {
+            ++out.badNumbers;
+            continue;
+        }
+
+        std::string_view name = csvFieldText(csv, 1);
+        row.nameInText = csv.isEscaped(1);
+        if (row.nameInText) {
+            row.nameOffset = out.text.size();
+            CsvScanner::unescape(name, out.text);
+            row.nameLength = static_cast<unsigned int>(out.text.size() - row.nameOffset);
+            name = std::string_view(out.text.data() + row.nameOffset, row.nameLength);
+        }
+        else {
+            row.nameOffset = name.empty() ? 0 : chunks[c].begin + csv.offsetOf(name);
+            row.nameLength = static_cast<unsigned int>(name.size());
+        }
+        row.keyOffset = out.keys.size();
+        foldCase(name.data(), name.size(), out.keys);
+        row.keyLength = static_cast<unsigned int>(out.keys.size() - row.keyOffset);
+        out.add(row);
+    }
+}
+
+/**
+ * @brief Parses a chunk of movies.csv.
+ *
+ * Fields are tokenized per RFC 4180, so quoted titles may contain commas.
+ * Rows with a missing field or a bad number are staged as malformed so the
+ * merge can report them in file order. Plots are recorded by position only.
+ *
+ * @param c The chunk index.
+ */
+template <>
+void CsvStage<StagedMovieRow>::parseChunk(int c) {
+    CsvScanner csv(file.data() + chunks[c].begin, chunks[c].end - chunks[c].begin);
+    StagingBuffer<StagedMovieRow>& out = staged[c];
+    while (csv.nextRow()) {
+        if (csv.row().empty()) continue;
+
+        std::string_view idField = csv.field(0);
+        std::string_view titleField = csv.field(1);
+        std::string_view plotField = csv.field(2);
+        std::string_view yearField = csv.field(3);
+
+        StagedMovieRow row = {};
+        row.rowOffset = chunks[c].begin + csv.rowOffset();
+        row.rowLength = static_cast<unsigned int>(csv.row().size());
+
+        // Validate basic row structure.
+        if (idField.empty() || titleField.empty() || plotField.empty() || yearField.empty()) {
+            row.malformed = true;
+            out.add(row);
+            continue;
+        }
+        if (!CsvScanner::toInt(idField, row.id) || !CsvScanner::toInt(yearField, row.releaseYear)) {
+            row.malformed = true;
+            row.badNumber = true;
+            out.add(row);
+            continue;
+        }
+
+        std::string_view title = csvFieldText(csv, 1);
+        std::string_view plot = csvFieldText(csv, 2);
+        row.titleInText = csv.isEscaped(1);
+        if (row.titleInText) {
+            row.titleOffset = out.text.size();
+            CsvScanner::unescape(title, out.text);
+            row.titleLength = static_cast<unsigned int>(out.text.size() - row.titleOffset);
+            title = std::string_view(out.text.data() + row.titleOffset, row.titleLength);
+        }
+        else {
+            row.titleOffset = title.empty() ? 0 : chunks[c].begin + csv.offsetOf(title);
+            row.titleLength = static_cast<unsigned int>(title.size());
+        }
+        // Plots stay in the file; escaped ones are unescaped when first read.
+        row.plotOffset = plot.empty() ? 0 : chunks[c].begin + csv.offsetOf(plot);
+        row.plotLength = static_cast<unsigned int>(plot.size());
+        row.plotEscaped = csv.isEscaped(2);
+        row.keyOffset = out.keys.size();
+        foldCase(title.data(), title.size(), out.keys);
+        row.keyLength = static_cast<unsigned int>(out.keys.size() - row.keyOffset);
+        out.add(row);
+    }
+}
+
+/**
+ * @brief Tokenizes a chunk of cast.csv into (actor ID, movie ID) pairs.
+ *
+ * Rows with a missing field or a bad number are skipped and counted as
+ * rejected.
+ *
+ * @param c The chunk index.
+ */
+template <>
+void CsvStage<StagedCastRow>::parseChunk(int c) {
+    CsvScanner csv(file.data() + chunks[c].begin, chunks[c].end - chunks[c].begin);
+    StagingBuffer<StagedCastRow>& out = staged[c];
+    while (csv.nextRow()) {
+        std::string_view actorField = csv.field(0);
+        std::string_view movieField = csv.field(1);
+        if (actorField.empty() || movieField.empty()) {
+            if (!csv.row().empty()) {
+                ++out.rejected;
+            }
+            continue;
+        }
+        StagedCastRow row;
+        if (!CsvScanner::toInt(actorField, row.actorId) || !CsvScanner::toInt(movieField, row.movieId)) {
+            ++out.badNumbers;
+            continue;
+        }
+        out.add(row);
+    }
+}
+
+// ***** Explicit Template Instantiations *****
+template class StagingBuffer<StagedActorRow>;
+template class StagingBuffer<StagedMovieRow>;
+template class StagingBuffer<StagedCastRow>;
+template class CsvStage<StagedActorRow>;
+template class CsvStage<StagedMovieRow>;
+template class CsvStage<StagedCastRow>;
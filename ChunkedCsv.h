@@ -0,0 +1,317 @@
+#ifndef CHUNKED_CSV_H
+#define CHUNKED_CSV_H
+
+#include "MappedFile.h"
+#include <cstddef>
+#include <functional>
+#include <string>
+
+/***************************************************************************
+ * ChunkedCsv.h
+ *
+ * Team:            Gearoid, Cedric
+ * Group:           1
+ * Student IDs:     S10241866, S10241549
+ *
+ * Features Highlight:
+ *   - Splits a mapped CSV file into chunks that start and end on row
+ *     boundaries (never inside a quoted field), and parses the chunks on
+ *     separate threads.
+ *   - Each worker writes to its own StagingBuffer, so parsing needs no
+ *     locks. The loader then merges the buffers in chunk order on one
+ *     thread, which keeps duplicate IDs resolving exactly as a sequential
+ *     read would (the last row in the file wins).
+ *   - CsvStage bundles a mapped file, its chunks and their buffers, so a
+ *     loader can parse several files at once and merge each when ready.
+ *     openAppended() stages only the complete rows after a byte offset,
+ *     for following files that are being appended to.
+ *
+ ***************************************************************************/
+
+ /**
+  * @brief Byte range of one chunk within a CSV buffer.
+  */
+struct CsvChunk {
+    size_t begin;  ///< Offset of the chunk's first byte.
+    size_t end;    ///< Offset one past the chunk's last byte.
+};
+
+/**
+ * @brief An actor row parsed by a worker, waiting to be merged.
+ *
+ * Text is stored as offsets: the name into the mapped file (or into the
+ * chunk's text buffer when it had to be unescaped) and the folded collation
+ * key into the chunk's key buffer.
+ */
+struct StagedActorRow {
+    int id;                  ///< Actor ID.
+    int birthYear;           ///< Birth year.
+    size_t nameOffset;       ///< Offset of the trimmed name.
+    unsigned int nameLength; ///< Length of the trimmed name.
+    bool nameInText;         ///< True if nameOffset refers to the text buffer, not the file.
+    size_t keyOffset;        ///< Offset of the collation key in the key buffer.
+    unsigned int keyLength;  ///< Length of the collation key.
+};
+
+/**
+ * @brief A movie row parsed by a worker, waiting to be merged.
+ *
+ * Malformed rows are staged too, so the loader can report them in file order.
+ */
+struct StagedMovieRow {
+    int id;                   ///< Movie ID.
+    int releaseYear;          ///< Release year.
+    size_t titleOffset;       ///< Offset of the trimmed title.
+    unsigned int titleLength; ///< Length of the trimmed title.
+    bool titleInText;         ///< True if titleOffset refers to the text buffer, not the file.
+    size_t keyOffset;         ///< Offset of the collation key in the key buffer.
+    unsigned int keyLength;   ///< Length of the collation key.
+    size_t plotOffset;        ///< Offset of the trimmed plot in the file.
+    unsigned int plotLength;  ///< Length of the trimmed plot (0 = none).
+    bool plotEscaped;         ///< True if the plot contains "" escapes.
+    bool malformed;           ///< True if the row is missing a field or has a bad number.
+    bool badNumber;           ///< True if malformed because the ID or year is not a number.
+    size_t rowOffset;         ///< Offset of the row (for warnings).
+    unsigned int rowLength;   ///< Length of the row (for warnings).
+};
+
+/**
+ * @brief A cast row tokenized by a worker, waiting to be linked.
+ */
+struct StagedCastRow {
+    int actorId;             ///< Actor ID.
+    int movieId;             ///< Movie ID.
+};
+
+/**
+ * @brief Growable, thread-local array of staged rows plus their key text.
+ *
+ * @tparam T StagedActorRow, StagedMovieRow or StagedCastRow.
+ */
+template <typename T>
+class StagingBuffer {
+private:
+    T* rows;          ///< Staged rows in file order.
+    int count;        ///< Number of rows.
+    int capacity;     ///< Allocated size of rows.
+
+public:
+    std::string keys; ///< Concatenated collation keys referenced by the rows.
+    std::string text; ///< Unescaped copies of quoted fields that contained "".
+    int rejected;     ///< Rows dropped by the parser for a missing field.
+    int badNumbers;   ///< Rows dropped by the parser for an ID or year that is not a number.
+    double cpuMillis; ///< CPU time the parser spent on the chunk.
+
+    /**
+     * @brief Constructs an empty buffer.
+     */
+    StagingBuffer();
+
+    /**
+     * @brief Destructor.
+     */
+    ~StagingBuffer();
+
+    // Copy constructor and assignment operator are disabled for simplicity.
+    StagingBuffer(const StagingBuffer&) = delete;
+    StagingBuffer& operator=(const StagingBuffer&) = delete;
+
+    /**
+     * @brief Appends a row, doubling the array when it is full.
+     *
+     * @param row The row to append.
+     */
+    void add(const T& row);
+
+    /**
+     * @brief Returns the number of staged rows.
+     *
+     * @return int The row count.
+     */
+    int size() const;
+
+    /**
+     * @brief Returns a staged row.
+     *
+     * @param index Row index (0 <= index < size()).
+     * @return const T& The row.
+     */
+    const T& at(int index) const;
+};
+
+/**
+ * @brief Splits a buffer into chunks that each end on a row boundary.
+ *
+ * The number of chunks is bounded by maxChunks and by requiring roughly
+ * minChunkBytes per chunk, so small files are handled by a single chunk.
+ *
+ * @param data The buffer.
+ * @param start Offset where the rows begin (after the header).
+ * @param size Size of the buffer.
+ * @param maxChunks Upper bound on the number of chunks.
+ * @param minChunkBytes Smallest chunk worth a thread of its own.
+ * @param chunks Output array with room for maxChunks entries.
+ * @return int The number of chunks written.
+ */
+int splitCsvChunks(const char* data, size_t start, size_t size, int maxChunks,
+    size_t minChunkBytes, CsvChunk* chunks);
+
+/**
+ * @brief Returns how many worker threads the loaders may use.
+ *
+ * @return int The hardware thread count, clamped to [1, 16].
+ */
+int csvWorkerCount();
+
+/**
+ * @brief Runs work(0) .. work(count - 1) concurrently and waits for all of them.
+ *
+ * work(0) runs on the calling thread.
+ *
+ * @param count Number of tasks.
+ * @param work The task body, given its index.
+ */
+void runCsvChunks(int count, const std::function<void(int)>& work);
+
+/**
+ * @brief A CSV file being loaded: the mapping, its chunks and their staging buffers.
+ *
+ * open() maps the file and splits it; parseChunk() may then run for every
+ * chunk at once, since each chunk writes only to its own buffer. The staged
+ * rows point into the mapping, so the stage must outlive the merge.
+ *
+ * @tparam T The staged row type, which selects the parser.
+ */
+template <typename T>
+class CsvStage {
+private:
+    MappedFile file;             ///< The mapped CSV file.
+    CsvChunk* chunks;            ///< Row-aligned chunks of the file body.
+    int chunkCount;              ///< Number of chunks.
+    StagingBuffer<T>* staged;    ///< One buffer per chunk.
+    size_t end;                  ///< Offset one past the last staged byte.
+
+    /**
+     * @brief Splits [begin, end) into chunks and allocates their buffers.
+     *
+     * @param begin Offset of the first row.
+     */
+    void split(size_t begin);
+
+public:
+    /**
+     * @brief Constructs an empty stage.
+     */
+    CsvStage();
+
+    /**
+     * @brief Destructor. Releases the buffers and unmaps the file.
+     */
+    ~CsvStage();
+
+    // Copy constructor and assignment operator are disabled for simplicity.
+    CsvStage(const CsvStage&) = delete;
+    CsvStage& operator=(const CsvStage&) = delete;
+
+    /**
+     * @brief Maps a CSV file and splits its body (after the header) into chunks.
+     *
+     * @param filename The CSV file.
+     * @return bool False (after reporting the error) if the file is missing or empty.
+     */
+    bool open(const std::string& filename);
+
+    /**
+     * @brief Maps a CSV file and stages only the rows after a byte offset.
+     *
+     * A trailing row without its newline may still be being written, so
+     * only complete rows are staged. If the file is now shorter than the
+     * offset it was replaced, and is staged from its first row again.
+     *
+     * @param filename The CSV file.
+     * @param offset Offset returned by getEnd() on the previous read (0 = whole file).
+     * @return bool False if the file cannot be opened.
+     */
+    bool openAppended(const std::string& filename, size_t offset);
+
+    /**
+     * @brief Returns where the staged rows end, for the next openAppended().
+     *
+     * @return size_t Offset one past the last staged byte.
+     */
+    size_t getEnd() const;
+
+    /**
+     * @brief Returns the number of chunks.
+     *
+     * @return int The chunk count (0 before open()).
+     */
+    int getChunkCount() const;
+
+    /**
+     * @brief Parses one chunk into its staging buffer.
+     *
+     * @param c The chunk index.
+     */
+    void parseChunk(int c);
+
+    /**
+     * @brief Parses every chunk, one thread per chunk.
+     *
+     * Each worker records its own CPU time (see getParseCpuMillis()).
+     */
+    void parseAll();
+
+    /**
+     * @brief Returns the number of staged rows over all chunks.
+     *
+     * @return int The row count.
+     */
+    int getRowCount() const;
+
+    /**
+     * @brief Returns the number of rows the parsers dropped for a missing field.
+     *
+     * Movie rows are staged as malformed instead, so this is 0 for movies.
+     *
+     * @return int The dropped row count.
+     */
+    int getRejectedCount() const;
+
+    /**
+     * @brief Returns the number of rows the parsers dropped for an ID or year that is not a number.
+     *
+     * Movie rows are staged as malformed instead, so this is 0 for movies.
+     *
+     * @return int The dropped row count.
+     */
+    int getBadNumberCount() const;
+
+    /**
+     * @brief Returns the CPU time spent parsing, summed over the worker threads.
+     *
+     * @return double Milliseconds.
+     */
+    double getParseCpuMillis() const;
+
+    /**
+     * @brief Returns the mapped file the staged offsets refer to.
+     *
+     * @return const char* The first byte of the file.
+     */
+    const char* data() const;
+
+    /**
+     * @brief Returns the rows staged from one chunk, in file order.
+     *
+     * @param c The chunk index.
+     * @return const StagingBuffer<T>& The chunk's buffer.
+     */
+    const StagingBuffer<T>& rowsOf(int c) const;
+};
+
+template <> void CsvStage<StagedActorRow>::parseChunk(int c);
+template <> void CsvStage<StagedMovieRow>::parseChunk(int c);
+template <> void CsvStage<StagedCastRow>::parseChunk(int c);
+
+#endif // CHUNKED_CSV_H
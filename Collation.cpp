@@ -0,0 +1,148 @@
+/***************************************************************************
+ * Collation.cpp
+ *
+ * Team:            Gearoid, Cedric
+ * Group:           1
+ * Student IDs:     S10241866, S10241549
+ *
+ * Features Highlight:
+ *   - ASCII and two-byte UTF-8 case folding.
+ *   - Interned collation keys compared by handle or memcmp.
+ ***************************************************************************/
+
+#include "Collation.h"
+#include <cstring>
+
+ /**
+  * @brief Maps an uppercase code point in the two-byte UTF-8 range to lowercase.
+  *
+  * @param cp A code point between U+0080 and U+07FF.
+  * @return unsigned int The lowercase code point (ASCII 'i' for İ and ı), or cp if it has none.
+  */
+static unsigned int lowerTwoByteCodePoint(unsigned int cp) {
+    // Latin-1 Supplement: À..Þ, skipping the multiplication sign.
+    if (cp >= 0xC0 && cp <= 0xDE && cp != 0xD7) return cp + 0x20;
+    // Dotted İ and dotless ı both fold to plain 'i', so "İstanbul" matches "istanbul";
+    // İ is even and would otherwise fall into the parity rule below and become ı.
+    if (cp == 0x130 || cp == 0x131) return 'i';
+    // Latin Extended-A alternates upper/lower; the parity flips at U+0139 and U+0179.
+    if (cp >= 0x100 && cp <= 0x137) return (cp % 2 == 0) ? cp + 1 : cp;
+    if (cp >= 0x139 && cp <= 0x148) return (cp % 2 == 1) ? cp + 1 : cp;
+    if (cp >= 0x14A && cp <= 0x177) return (cp % 2 == 0) ? cp + 1 : cp;
+    if (cp == 0x178) return 0xFF;
+    if (cp >= 0x179 && cp <= 0x17E) return (cp % 2 == 1) ? cp + 1 : cp;
+    // Greek capitals, skipping the unassigned U+03A2.
+    if (cp >= 0x391 && cp <= 0x3A9 && cp != 0x3A2) return cp + 0x20;
+    // Cyrillic: Ѐ..Џ and А..Я.
+    if (cp >= 0x400 && cp <= 0x40F) return cp + 0x50;
+    if (cp >= 0x410 && cp <= 0x42F) return cp + 0x20;
+    return cp;
+}
+
+/**
+ * @brief Appends the case-folded form of a UTF-8 string to a buffer.
+ *
+ * @param text The text to fold.
+ * @param out The output buffer.
+ */
+void foldCase(const char* text, std::string& out) {
+    if (!text) return;
+    foldCase(text, std::strlen(text), out);
+}
+
+/**
+ * @brief Appends the case-folded form of a UTF-8 byte range to a buffer.
+ *
+ * @param text Pointer to the first byte.
+ * @param length Number of bytes.
+ * @param out The output buffer.
+ */
+void foldCase(const char* text, size_t length, std::string& out) {
+    if (!text) return;
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(text);
+    const unsigned char* end = p + length;
+    while (p < end) {
+        unsigned char c = *p;
+        if (c < 0x80) {
+            out += static_cast<char>((c >= 'A' && c <= 'Z') ? c + ('a' - 'A') : c);
+            ++p;
+        }
+        else if ((c & 0xE0) == 0xC0 && p + 1 < end && (p[1] & 0xC0) == 0x80) {
+            unsigned int cp = lowerTwoByteCodePoint(((c & 0x1Fu) << 6) | (p[1] & 0x3Fu));
+            if (cp < 0x80) {
+                out += static_cast<char>(cp);
+            }
+            else {
+                out += static_cast<char>(0xC0 | (cp >> 6));
+                out += static_cast<char>(0x80 | (cp & 0x3F));
+            }
+            p += 2;
+        }
+        else {
+            out += static_cast<char>(c);
+            ++p;
+        }
+    }
+}
+
+/**
+ * @brief Folds a string and interns the result.
+ *
+ * @param text The original text.
+ * @return StringHandle The interned key.
+ */
+StringHandle makeCollationKey(const char* text) {
+    std::string folded;
+    foldCase(text, folded);
+    return StringArena::shared().intern(folded.c_str(), folded.size());
+}
+
+/**
+ * @brief Folds a string and looks the result up without interning it.
+ *
+ * @param text The search text.
+ * @param key Receives the key handle.
+ * @return bool True if the key exists in the arena.
+ */
+bool findCollationKey(const char* text, StringHandle& key) {
+    std::string folded;
+    foldCase(text, folded);
+    return StringArena::shared().find(folded.c_str(), folded.size(), key);
+}
+
+/**
+ * @brief Compares two interned keys by handle.
+ *
+ * Interning stores each distinct key once, so equal keys share an offset.
+ *
+ * @param a The first key.
+ * @param b The second key.
+ * @return bool True if the keys are equal.
+ */
+bool sameCollationKey(StringHandle a, StringHandle b) {
+    return a.offset == b.offset && a.length == b.length;
+}
+
+/**
+ * @brief Orders two collation keys bytewise.
+ *
+ * Keys that are the same handle return without touching the text.
+ *
+ * @param a The first key.
+ * @param b The second key.
+ * @return int Negative, zero or positive as a is before, equal to or after b.
+ */
+int compareCollationKeys(StringHandle a, StringHandle b) {
+    if (sameCollationKey(a, b)) {
+        return 0;
+    }
+    const StringArena& arena = StringArena::shared();
+    unsigned int n = (a.length < b.length) ? a.length : b.length;
+    int cmp = std::memcmp(arena.resolve(a), arena.resolve(b), n);
+    if (cmp != 0) {
+        return cmp;
+    }
+    if (a.length < b.length) return -1;
+    if (a.length > b.length) return 1;
+    return 0;
+}
@@ -0,0 +1,88 @@
+#ifndef COLLATION_H
+#define COLLATION_H
+
+#include "StringArena.h"
+#include <string>
+
+/***************************************************************************
+ * Collation.h
+ *
+ * Team:            Gearoid, Cedric
+ * Group:           1
+ * Student IDs:     S10241866, S10241549
+ *
+ * Features Highlight:
+ *   - Case-folded collation keys for actor names and movie titles.
+ *   - Folding understands UTF-8: accented Latin, Greek and Cyrillic capitals
+ *     are lowered along with ASCII, so "ARMANDO MATÍAS" matches
+ *     "Armando Matías".
+ *   - Keys are interned in the shared StringArena, so two names are equal
+ *     ignoring case exactly when their key handles are equal, and ordering
+ *     two names is a single memcmp.
+ *
+ ***************************************************************************/
+
+ /**
+  * @brief Appends the case-folded form of a UTF-8 string to a buffer.
+  *
+  * ASCII letters are lowered byte by byte. Two-byte UTF-8 sequences for
+  * Latin-1, Latin Extended-A, Greek and Cyrillic capitals are replaced by
+  * their lowercase code point; dotted İ and dotless ı both become ASCII
+  * 'i'. Any other byte, including malformed UTF-8, is copied unchanged.
+  *
+  * @param text The text to fold (nullptr is treated as empty).
+  * @param out The buffer the folded text is appended to.
+  */
+void foldCase(const char* text, std::string& out);
+
+/**
+ * @brief Appends the case-folded form of a UTF-8 byte range to a buffer.
+ *
+ * Same rules as the C-string overload; the range need not be terminated,
+ * so loaders can fold fields straight out of a mapped file.
+ *
+ * @param text Pointer to the first byte.
+ * @param length Number of bytes.
+ * @param out The buffer the folded text is appended to.
+ */
+void foldCase(const char* text, size_t length, std::string& out);
+
+/**
+ * @brief Builds and interns the collation key for a name or title.
+ *
+ * @param text The original text.
+ * @return StringHandle Handle to the folded key in the shared StringArena.
+ */
+StringHandle makeCollationKey(const char* text);
+
+/**
+ * @brief Finds the collation key of a search string without storing it.
+ *
+ * If no stored name or title folds to the same key, nothing can match the
+ * search and the caller may skip its scan.
+ *
+ * @param text The search text.
+ * @param key Receives the key handle when it exists.
+ * @return bool True if the key is present in the shared StringArena.
+ */
+bool findCollationKey(const char* text, StringHandle& key);
+
+/**
+ * @brief Tests two interned collation keys for equality.
+ *
+ * @param a The first key.
+ * @param b The second key.
+ * @return bool True if both handles refer to the same key.
+ */
+bool sameCollationKey(StringHandle a, StringHandle b);
+
+/**
+ * @brief Orders two collation keys.
+ *
+ * @param a The first key.
+ * @param b The second key.
+ * @return int Negative if a < b, positive if a > b, zero if equal.
+ */
+int compareCollationKeys(StringHandle a, StringHandle b);
+
+#endif // COLLATION_H
@@ -0,0 +1,276 @@
+/***************************************************************************
+ * ColumnStore.cpp
+ *
+ * Team:            Gearoid, Cedric
+ * Group:           1
+ * Student IDs:     S10241866, S10241549
+ *
+ * Features Highlight:
+ *   - Parallel growable column arrays for actors and movies.
+ *   - Row writes keyed by dense ID.
+ *   - Collation key columns for name/title ordering and lookup.
+ ***************************************************************************/
+
+#include "ColumnStore.h"
+
+ /**
+  * @brief Reallocates one column to a new capacity, keeping the first count entries.
+  *
+  * @tparam T The element type of the column.
+  * @param column Reference to the column pointer.
+  * @param count Number of entries to keep.
+  * @param newCapacity The new column size.
+  */
+template <typename T>
+static void growColumn(T*& column, int count, int newCapacity) {
+    T* newArr = new T[newCapacity];
+    for (int i = 0; i < count; ++i) {
+        newArr[i] = column[i];
+    }
+    delete[] column;
+    column = newArr;
+}
+
+// ---------------------------------------------------------------------------
+// ActorColumns
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Constructs empty actor columns.
+ *
+ * @param initialCapacity Initial number of rows allocated per column.
+ */
+ActorColumns::ActorColumns(int initialCapacity)
+    : ids(new int[initialCapacity]),
+    birthYears(new int[initialCapacity]),
+    ratings(new int[initialCapacity]),
+    names(new StringHandle[initialCapacity]),
+    nameKeys(new StringHandle[initialCapacity]),
+    count(0),
+    capacity(initialCapacity)
+{
+}
+
+/**
+ * @brief Destructor.
+ */
+ActorColumns::~ActorColumns() {
+    delete[] ids;
+    delete[] birthYears;
+    delete[] ratings;
+    delete[] names;
+    delete[] nameKeys;
+}
+
+/**
+ * @brief Doubles every column until the given row fits.
+ *
+ * @param row The dense ID that must be addressable.
+ */
+void ActorColumns::ensureCapacity(int row) {
+    if (row < capacity) return;
+    int newCapacity = capacity * 2;
+    while (row >= newCapacity) {
+        newCapacity *= 2;
+    }
+    growColumn(ids, count, newCapacity);
+    growColumn(birthYears, count, newCapacity);
+    growColumn(ratings, count, newCapacity);
+    growColumn(names, count, newCapacity);
+    growColumn(nameKeys, count, newCapacity);
+    capacity = newCapacity;
+}
+
+/**
+ * @brief Copies an actor's scalar fields, name handle and name key into a row.
+ *
+ * @param denseId The actor's dense ID.
+ * @param actor The actor to copy from.
+ */
+void ActorColumns::set(int denseId, const Actor& actor) {
+    ensureCapacity(denseId);
+    ids[denseId] = actor.getId();
+    birthYears[denseId] = actor.getBirthYear();
+    ratings[denseId] = actor.getRating();
+    names[denseId] = actor.getNameHandle();
+    nameKeys[denseId] = actor.getNameKey();
+    if (denseId >= count) {
+        count = denseId + 1;
+    }
+}
+
+/**
+ * @brief Returns the number of rows.
+ *
+ * @return int The row count.
+ */
+int ActorColumns::size() const {
+    return count;
+}
+
+/**
+ * @brief Returns the external ID column.
+ *
+ * @return const int* The IDs.
+ */
+const int* ActorColumns::getIds() const {
+    return ids;
+}
+
+/**
+ * @brief Returns the birth year column.
+ *
+ * @return const int* The birth years.
+ */
+const int* ActorColumns::getBirthYears() const {
+    return birthYears;
+}
+
+/**
+ * @brief Returns the rating column.
+ *
+ * @return const int* The ratings.
+ */
+const int* ActorColumns::getRatings() const {
+    return ratings;
+}
+
+/**
+ * @brief Returns the name handle column.
+ *
+ * @return const StringHandle* The name handles.
+ */
+const StringHandle* ActorColumns::getNames() const {
+    return names;
+}
+
+/**
+ * @brief Returns the name collation key column.
+ *
+ * @return const StringHandle* The name keys.
+ */
+const StringHandle* ActorColumns::getNameKeys() const {
+    return nameKeys;
+}
+
+// ---------------------------------------------------------------------------
+// MovieColumns
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Constructs empty movie columns.
+ *
+ * @param initialCapacity Initial number of rows allocated per column.
+ */
+MovieColumns::MovieColumns(int initialCapacity)
+    : ids(new int[initialCapacity]),
+    releaseYears(new int[initialCapacity]),
+    ratings(new int[initialCapacity]),
+    titles(new StringHandle[initialCapacity]),
+    titleKeys(new StringHandle[initialCapacity]),
+    count(0),
+    capacity(initialCapacity)
+{
+}
+
+/**
+ * @brief Destructor.
+ */
+MovieColumns::~MovieColumns() {
+    delete[] ids;
+    delete[] releaseYears;
+    delete[] ratings;
+    delete[] titles;
+    delete[] titleKeys;
+}
+
+/**
+ * @brief Doubles every column until the given row fits.
+ *
+ * @param row The dense ID that must be addressable.
+ */
+void MovieColumns::ensureCapacity(int row) {
+    if (row < capacity) return;
+    int newCapacity = capacity * 2;
+    while (row >= newCapacity) {
+        newCapacity *= 2;
+    }
+    growColumn(ids, count, newCapacity);
+    growColumn(releaseYears, count, newCapacity);
+    growColumn(ratings, count, newCapacity);
+    growColumn(titles, count, newCapacity);
+    growColumn(titleKeys, count, newCapacity);
+    capacity = newCapacity;
+}
+
+/**
+ * @brief Copies a movie's scalar fields, title handle and title key into a row.
+ *
+ * @param denseId The movie's dense ID.
+ * @param movie The movie to copy from.
+ */
+void MovieColumns::set(int denseId, const Movie& movie) {
+    ensureCapacity(denseId);
+    ids[denseId] = movie.getId();
+    releaseYears[denseId] = movie.getReleaseYear();
+    ratings[denseId] = movie.getRating();
+    titles[denseId] = movie.getTitleHandle();
+    titleKeys[denseId] = movie.getTitleKey();
+    if (denseId >= count) {
+        count = denseId + 1;
+    }
+}
+
+/**
+ * @brief Returns the number of rows.
+ *
+ * @return int The row count.
+ */
+int MovieColumns::size() const {
+    return count;
+}
+
+/**
+ * @brief Returns the external ID column.
+ *
+ * @return const int* The IDs.
+ */
+const int* MovieColumns::getIds() const {
+    return ids;
+}
+
+/**
+ * @brief Returns the release year column.
+ *
+ * @return const int* The release years.
+ */
+const int* MovieColumns::getReleaseYears() const {
+    return releaseYears;
+}
+
+/**
+ * @brief Returns the rating column.
+ *
+ * @return const int* The ratings.
+ */
+const int* MovieColumns::getRatings() const {
+    return ratings;
+}
+
+/**
+ * @brief Returns the title handle column.
+ *
+ * @return const StringHandle* The title handles.
+ */
+const StringHandle* MovieColumns::getTitles() const {
+    return titles;
+}
+
+/**
+ * @brief Returns the title collation key column.
+ *
+ * @return const StringHandle* The title keys.
+ */
+const StringHandle* MovieColumns::getTitleKeys() const {
+    return titleKeys;
+}
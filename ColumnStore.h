@@ -0,0 +1,206 @@
+#ifndef COLUMN_STORE_H
+#define COLUMN_STORE_H
+
+#include "Actor.h"
+#include "Movie.h"
+#include "StringArena.h"
+
+/***************************************************************************
+ * ColumnStore.h
+ *
+ * Team:            Gearoid, Cedric
+ * Group:           1
+ * Student IDs:     S10241866, S10241549
+ *
+ * Features Highlight:
+ *   - Struct-of-arrays copies of the scalar actor and movie fields.
+ *   - Each column is a plain array indexed by dense ID, parallel to the
+ *     DenseTable that owns the full records.
+ *   - Scans that filter or sort on one field (age, year, name) read just that
+ *     column instead of pulling whole Actor/Movie objects through the cache.
+ *   - Name and title collation keys are kept as their own columns for
+ *     sorting and case-insensitive lookups.
+ *
+ ***************************************************************************/
+
+ /**
+  * @brief Columnar view of the actor table.
+  */
+class ActorColumns {
+private:
+    int* ids;              ///< External actor IDs.
+    int* birthYears;       ///< Birth years.
+    int* ratings;          ///< Ratings (0 = unrated).
+    StringHandle* names;   ///< Name handles into the shared StringArena.
+    StringHandle* nameKeys; ///< Case-folded name collation keys.
+    int count;             ///< Number of rows (highest dense ID + 1).
+    int capacity;          ///< Allocated size of each column.
+
+    /**
+     * @brief Grows every column so that the given row fits.
+     *
+     * @param row The dense ID that must be addressable.
+     */
+    void ensureCapacity(int row);
+
+public:
+    /**
+     * @brief Constructs empty columns.
+     *
+     * @param initialCapacity Initial number of rows allocated per column.
+     */
+    explicit ActorColumns(int initialCapacity = 2000);
+
+    /**
+     * @brief Destructor.
+     *
+     * Releases every column.
+     */
+    ~ActorColumns();
+
+    // Copying is disabled for simplicity.
+    ActorColumns(const ActorColumns&) = delete;
+    ActorColumns& operator=(const ActorColumns&) = delete;
+
+    /**
+     * @brief Writes an actor's fields into a row.
+     *
+     * @param denseId The actor's dense ID.
+     * @param actor The actor whose fields are copied.
+     */
+    void set(int denseId, const Actor& actor);
+
+    /**
+     * @brief Returns the number of rows.
+     *
+     * @return int The row count.
+     */
+    int size() const;
+
+    /**
+     * @brief Returns the external ID column.
+     *
+     * @return const int* Pointer to size() IDs.
+     */
+    const int* getIds() const;
+
+    /**
+     * @brief Returns the birth year column.
+     *
+     * @return const int* Pointer to size() birth years.
+     */
+    const int* getBirthYears() const;
+
+    /**
+     * @brief Returns the rating column.
+     *
+     * @return const int* Pointer to size() ratings.
+     */
+    const int* getRatings() const;
+
+    /**
+     * @brief Returns the name handle column.
+     *
+     * @return const StringHandle* Pointer to size() name handles.
+     */
+    const StringHandle* getNames() const;
+
+    /**
+     * @brief Returns the name collation key column.
+     *
+     * @return const StringHandle* Pointer to size() key handles.
+     */
+    const StringHandle* getNameKeys() const;
+};
+
+/**
+ * @brief Columnar view of the movie table.
+ */
+class MovieColumns {
+private:
+    int* ids;              ///< External movie IDs.
+    int* releaseYears;     ///< Release years.
+    int* ratings;          ///< Ratings (0 = unrated).
+    StringHandle* titles;  ///< Title handles into the shared StringArena.
+    StringHandle* titleKeys; ///< Case-folded title collation keys.
+    int count;             ///< Number of rows (highest dense ID + 1).
+    int capacity;          ///< Allocated size of each column.
+
+    /**
+     * @brief Grows every column so that the given row fits.
+     *
+     * @param row The dense ID that must be addressable.
+     */
+    void ensureCapacity(int row);
+
+public:
+    /**
+     * @brief Constructs empty columns.
+     *
+     * @param initialCapacity Initial number of rows allocated per column.
+     */
+    explicit MovieColumns(int initialCapacity = 2000);
+
+    /**
+     * @brief Destructor.
+     *
+     * Releases every column.
+     */
+    ~MovieColumns();
+
+    // Copying is disabled for simplicity.
+    MovieColumns(const MovieColumns&) = delete;
+    MovieColumns& operator=(const MovieColumns&) = delete;
+
+    /**
+     * @brief Writes a movie's fields into a row.
+     *
+     * @param denseId The movie's dense ID.
+     * @param movie The movie whose fields are copied.
+     */
+    void set(int denseId, const Movie& movie);
+
+    /**
+     * @brief Returns the number of rows.
+     *
+     * @return int The row count.
+     */
+    int size() const;
+
+    /**
+     * @brief Returns the external ID column.
+     *
+     * @return const int* Pointer to size() IDs.
+     */
+    const int* getIds() const;
+
+    /**
+     * @brief Returns the release year column.
+     *
+     * @return const int* Pointer to size() release years.
+     */
+    const int* getReleaseYears() const;
+
+    /**
+     * @brief Returns the rating column.
+     *
+     * @return const int* Pointer to size() ratings.
+     */
+    const int* getRatings() const;
+
+    /**
+     * @brief Returns the title handle column.
+     *
+     * @return const StringHandle* Pointer to size() title handles.
+     */
+    const StringHandle* getTitles() const;
+
+    /**
+     * @brief Returns the title collation key column.
+     *
+     * @return const StringHandle* Pointer to size() key handles.
+     */
+    const StringHandle* getTitleKeys() const;
+};
+
+#endif // COLUMN_STORE_H
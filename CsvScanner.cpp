@@ -0,0 +1,334 @@
+/***************************************************************************
+ * CsvScanner.cpp
+ *
+ * Team:            Gearoid, Cedric
+ * Group:           1
+ * Student IDs:     S10241866, S10241549
+ *
+ * Features Highlight:
+ *   - SSE2/AVX2 search for separators, quotes and line breaks.
+ *   - RFC 4180 quoted fields with "" escapes and embedded line breaks.
+ *   - std::from_chars integer parsing that must consume the whole field.
+ ***************************************************************************/
+
+#include "CsvScanner.h"
+#include <charconv>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CSV_SCANNER_SSE2 1
+#include <emmintrin.h>
+#endif
+#if defined(__AVX2__)
+#define CSV_SCANNER_AVX2 1
+#include <immintrin.h>
+#endif
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+ /**
+  * @brief Returns the index of the lowest set bit of a non-zero mask.
+  *
+  * @param mask A movemask result with at least one bit set.
+  * @return int The bit index.
+  */
+static inline int lowestSetBit(unsigned int mask) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctz(mask);
+#endif
+}
+
+/**
+ * @brief Constructs a scanner positioned before the first row.
+ *
+ * @param data First byte of the buffer.
+ * @param size Number of bytes.
+ */
+CsvScanner::CsvScanner(const char* data, size_t size)
+    : begin(data),
+    end(data + size),
+    cursor(data),
+    rowBegin(data),
+    rowEnd(data),
+    fieldTotal(0)
+{
+}
+
+/**
+ * @brief Finds the first of two bytes, a vector register at a time.
+ *
+ * @param p Start of the range.
+ * @param last One past the end of the range.
+ * @param a First byte.
+ * @param b Second byte.
+ * @return const char* The match, or last.
+ */
+const char* CsvScanner::findEither(const char* p, const char* last, char a, char b) {
+#ifdef CSV_SCANNER_AVX2
+    const __m256i wideA = _mm256_set1_epi8(a);
+    const __m256i wideB = _mm256_set1_epi8(b);
+    while (last - p >= 32) {
+        __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        __m256i hits = _mm256_or_si256(_mm256_cmpeq_epi8(chunk, wideA), _mm256_cmpeq_epi8(chunk, wideB));
+        unsigned int mask = static_cast<unsigned int>(_mm256_movemask_epi8(hits));
+        if (mask != 0) {
+            return p + lowestSetBit(mask);
+        }
+        p += 32;
+    }
+#endif
+#ifdef CSV_SCANNER_SSE2
+    const __m128i vecA = _mm_set1_epi8(a);
+    const __m128i vecB = _mm_set1_epi8(b);
+    while (last - p >= 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        __m128i hits = _mm_or_si128(_mm_cmpeq_epi8(chunk, vecA), _mm_cmpeq_epi8(chunk, vecB));
+        unsigned int mask = static_cast<unsigned int>(_mm_movemask_epi8(hits));
+        if (mask != 0) {
+            return p + lowestSetBit(mask);
+        }
+        p += 16;
+    }
+#endif
+    while (p < last && *p != a && *p != b) {
+        ++p;
+    }
+    return p;
+}
+
+/**
+ * @brief Counts '"' bytes in a range.
+ *
+ * The SSE2 path keeps 16 byte-wide counters and folds them with
+ * _mm_sad_epu8 before they can overflow.
+ *
+ * @param p Start of the range.
+ * @param last One past the end of the range.
+ * @return size_t The number of quotes.
+ */
+size_t CsvScanner::countQuotes(const char* p, const char* last) {
+    size_t total = 0;
+#ifdef CSV_SCANNER_SSE2
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i zero = _mm_setzero_si128();
+    while (last - p >= 16) {
+        __m128i counts = zero;
+        int rounds = 0;
+        while (last - p >= 16 && rounds < 255) {
+            __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+            // A match is 0xFF (-1), so subtracting it adds one to that byte's counter.
+            counts = _mm_sub_epi8(counts, _mm_cmpeq_epi8(chunk, quote));
+            p += 16;
+            ++rounds;
+        }
+        __m128i sums = _mm_sad_epu8(counts, zero);
+        total += static_cast<size_t>(_mm_cvtsi128_si32(sums))
+            + static_cast<size_t>(_mm_cvtsi128_si32(_mm_srli_si128(sums, 8)));
+    }
+#endif
+    while (p < last) {
+        if (*p == '"') ++total;
+        ++p;
+    }
+    return total;
+}
+
+/**
+ * @brief Reads the next row, honouring quoted fields.
+ *
+ * Unquoted fields run to the next ',' or '\n'. Quoted fields run to the
+ * closing quote (a doubled quote is an escape and does not close the field);
+ * anything between the closing quote and the next separator is ignored.
+ *
+ * @return bool True if a row was read.
+ */
+bool CsvScanner::nextRow() {
+    if (cursor == nullptr || cursor >= end) {
+        return false;
+    }
+    rowBegin = cursor;
+    fieldTotal = 0;
+    const char* p = cursor;
+    while (true) {
+        const char* textBegin = p;
+        const char* textEnd;
+        bool quoted = false;
+        bool escaped = false;
+        if (p < end && *p == '"') {
+            quoted = true;
+            textBegin = p + 1;
+            const char* q = textBegin;
+            while (true) {
+                q = static_cast<const char*>(std::memchr(q, '"', end - q));
+                if (q == nullptr) {
+                    q = end; // Unterminated quote: the field runs to the end of the buffer.
+                    break;
+                }
+                if (q + 1 < end && q[1] == '"') {
+                    escaped = true;
+                    q += 2;
+                    continue;
+                }
+                break;
+            }
+            textEnd = q;
+            p = (q < end) ? findEither(q + 1, end, ',', '\n') : end;
+        }
+        else {
+            p = findEither(p, end, ',', '\n');
+            textEnd = p;
+            if (textEnd > textBegin && (p == end || *p == '\n') && textEnd[-1] == '\r') {
+                --textEnd;
+            }
+        }
+
+        if (fieldTotal < MAX_FIELDS) {
+            fieldBegin[fieldTotal] = textBegin;
+            fieldEnd[fieldTotal] = textEnd;
+            fieldQuoted[fieldTotal] = quoted;
+            fieldEscaped[fieldTotal] = escaped;
+            ++fieldTotal;
+        }
+
+        if (p >= end) {
+            rowEnd = end;
+            cursor = end;
+            break;
+        }
+        if (*p == ',') {
+            ++p;
+            continue;
+        }
+        rowEnd = p;     // *p == '\n'
+        cursor = p + 1;
+        break;
+    }
+    if (rowEnd > rowBegin && rowEnd[-1] == '\r') {
+        --rowEnd;
+    }
+    return true;
+}
+
+/**
+ * @brief Returns the current row.
+ *
+ * @return std::string_view The row without its line ending.
+ */
+std::string_view CsvScanner::row() const {
+    return std::string_view(rowBegin, static_cast<size_t>(rowEnd - rowBegin));
+}
+
+/**
+ * @brief Returns where the current row starts.
+ *
+ * @return size_t Byte offset in the buffer.
+ */
+size_t CsvScanner::rowOffset() const {
+    return static_cast<size_t>(rowBegin - begin);
+}
+
+/**
+ * @brief Returns the number of fields in the current row.
+ *
+ * @return int The field count.
+ */
+int CsvScanner::fieldCount() const {
+    return fieldTotal;
+}
+
+/**
+ * @brief Returns a field of the current row.
+ *
+ * @param index Zero-based field index.
+ * @return std::string_view The field text, or an empty view when out of range.
+ */
+std::string_view CsvScanner::field(int index) const {
+    if (index < 0 || index >= fieldTotal) {
+        return std::string_view();
+    }
+    return std::string_view(fieldBegin[index], static_cast<size_t>(fieldEnd[index] - fieldBegin[index]));
+}
+
+/**
+ * @brief Checks whether a field was quoted.
+ *
+ * @param index Zero-based field index.
+ * @return bool True if quoted.
+ */
+bool CsvScanner::isQuoted(int index) const {
+    return index >= 0 && index < fieldTotal && fieldQuoted[index];
+}
+
+/**
+ * @brief Checks whether a field contains escaped quotes.
+ *
+ * @param index Zero-based field index.
+ * @return bool True if escaped.
+ */
+bool CsvScanner::isEscaped(int index) const {
+    return index >= 0 && index < fieldTotal && fieldEscaped[index];
+}
+
+/**
+ * @brief Converts a view into the buffer to a byte offset.
+ *
+ * @param view A view returned by row() or field().
+ * @return size_t Offset of its first byte.
+ */
+size_t CsvScanner::offsetOf(std::string_view view) const {
+    return static_cast<size_t>(view.data() - begin);
+}
+
+/**
+ * @brief Appends field text with doubled quotes collapsed.
+ *
+ * @param view The quoted field's text.
+ * @param out The output buffer.
+ */
+void CsvScanner::unescape(std::string_view view, std::string& out) {
+    for (size_t i = 0; i < view.size(); ++i) {
+        out += view[i];
+        if (view[i] == '"' && i + 1 < view.size() && view[i + 1] == '"') {
+            ++i;
+        }
+    }
+}
+
+/**
+ * @brief Trims characters from both ends of a view.
+ *
+ * @param view The view.
+ * @param chars Characters to remove.
+ * @return std::string_view The trimmed view.
+ */
+std::string_view CsvScanner::trim(std::string_view view, const char* chars) {
+    size_t start = view.find_first_not_of(chars);
+    if (start == std::string_view::npos) {
+        return std::string_view();
+    }
+    size_t last = view.find_last_not_of(chars);
+    return view.substr(start, last - start + 1);
+}
+
+/**
+ * @brief Parses an integer without copying the text.
+ *
+ * @param view The text to parse.
+ * @param value Receives the value; left unchanged on failure.
+ * @return bool True if the trimmed field is exactly one in-range number.
+ */
+bool CsvScanner::toInt(std::string_view view, int& value) {
+    view = trim(view, " \t");
+    const char* first = view.data();
+    const char* last = first + view.size();
+    if (first != last && *first == '+') {
+        ++first;
+    }
+    std::from_chars_result res = std::from_chars(first, last, value);
+    return res.ec == std::errc() && res.ptr == last;
+}
@@ -0,0 +1,179 @@
+#ifndef CSV_SCANNER_H
+#define CSV_SCANNER_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+/***************************************************************************
+ * CsvScanner.h
+ *
+ * Team:            Gearoid, Cedric
+ * Group:           1
+ * Student IDs:     S10241866, S10241549
+ *
+ * Features Highlight:
+ *   - RFC 4180 tokenizer over a CSV buffer (typically a MappedFile): quoted
+ *     fields may contain commas, line breaks and doubled ("") quotes.
+ *   - Separators, quotes and line breaks are located 16 bytes at a time with
+ *     SSE2 (32 with AVX2), falling back to a byte loop elsewhere.
+ *   - Fields are std::string_view slices of the buffer; only fields that
+ *     contain escaped quotes ever need to be copied (see unescape()).
+ *   - Integers are parsed in place with std::from_chars, and a field with
+ *     anything besides the number is refused.
+ *   - Accepts LF and CRLF line endings.
+ *
+ ***************************************************************************/
+
+ /**
+  * @brief Zero-copy RFC 4180 row scanner over a memory buffer.
+  *
+  * For a quoted field, field() returns the text between the quotes; if that
+  * text contains escaped quotes, isEscaped() is true and unescape() produces
+  * the real value. Views returned by row() and field() stay valid as long as
+  * the buffer does.
+  */
+class CsvScanner {
+public:
+    static const int MAX_FIELDS = 16;  ///< Fields kept per row; any further fields are ignored.
+
+private:
+    const char* begin;                 ///< Start of the buffer.
+    const char* end;                   ///< One past the end of the buffer.
+    const char* cursor;                ///< Start of the next row.
+    const char* rowBegin;              ///< Start of the current row.
+    const char* rowEnd;                ///< End of the current row (line ending excluded).
+    const char* fieldBegin[MAX_FIELDS];  ///< Start of each field's text.
+    const char* fieldEnd[MAX_FIELDS];    ///< End of each field's text.
+    bool fieldQuoted[MAX_FIELDS];      ///< True if the field was enclosed in quotes.
+    bool fieldEscaped[MAX_FIELDS];     ///< True if the field contains "" escapes.
+    int fieldTotal;                    ///< Number of fields in the current row.
+
+public:
+    /**
+     * @brief Constructs a scanner over a buffer.
+     *
+     * @param data First byte of the buffer (may be nullptr if size is 0).
+     * @param size Number of bytes.
+     */
+    CsvScanner(const char* data, size_t size);
+
+    /**
+     * @brief Advances to the next row and splits it into fields.
+     *
+     * A row ends at the first line break that is not inside a quoted field.
+     * Empty lines are returned as rows with a single empty field.
+     *
+     * @return bool False once the end of the buffer is reached.
+     */
+    bool nextRow();
+
+    /**
+     * @brief Returns the current row without its line ending.
+     *
+     * @return std::string_view The raw row text.
+     */
+    std::string_view row() const;
+
+    /**
+     * @brief Returns the byte offset of the current row in the buffer.
+     *
+     * @return size_t Offset of the row's first byte.
+     */
+    size_t rowOffset() const;
+
+    /**
+     * @brief Returns the number of fields in the current row.
+     *
+     * @return int The field count.
+     */
+    int fieldCount() const;
+
+    /**
+     * @brief Returns the text of one field of the current row.
+     *
+     * @param index Zero-based field index.
+     * @return std::string_view The field (without enclosing quotes), or an
+     *         empty view if the row has fewer fields.
+     */
+    std::string_view field(int index) const;
+
+    /**
+     * @brief Checks whether a field was enclosed in quotes.
+     *
+     * @param index Zero-based field index.
+     * @return bool True for a quoted field.
+     */
+    bool isQuoted(int index) const;
+
+    /**
+     * @brief Checks whether a quoted field contains escaped ("") quotes.
+     *
+     * @param index Zero-based field index.
+     * @return bool True if field() must be passed through unescape().
+     */
+    bool isEscaped(int index) const;
+
+    /**
+     * @brief Returns the byte offset of a view that points into the buffer.
+     *
+     * @param view A field or row previously returned by this scanner.
+     * @return size_t Offset of the view's first byte.
+     */
+    size_t offsetOf(std::string_view view) const;
+
+    /**
+     * @brief Appends quoted-field text to a buffer with each "" turned into ".
+     *
+     * @param view Text returned by field().
+     * @param out The buffer to append to.
+     */
+    static void unescape(std::string_view view, std::string& out);
+
+    /**
+     * @brief Strips a set of characters from both ends of a view.
+     *
+     * @param view The view to trim.
+     * @param chars The characters to strip.
+     * @return std::string_view The trimmed view (empty if nothing remains).
+     */
+    static std::string_view trim(std::string_view view, const char* chars);
+
+    /**
+     * @brief Parses a decimal integer in place.
+     *
+     * Surrounding spaces and tabs and a leading '+' are ignored. Anything
+     * else must be part of the number: unlike atoi, a field such as "abc"
+     * or "1999a", or one outside int range, is refused instead of giving 0
+     * or a prefix.
+     *
+     * @param view The text to parse.
+     * @param value Receives the parsed value.
+     * @return bool True if the whole field is a number that fits in an int.
+     */
+    static bool toInt(std::string_view view, int& value);
+
+    /**
+     * @brief Finds the first occurrence of either of two bytes.
+     *
+     * @param p Start of the range.
+     * @param last One past the end of the range.
+     * @param a The first byte to look for.
+     * @param b The second byte to look for.
+     * @return const char* Pointer to the match, or last if there is none.
+     */
+    static const char* findEither(const char* p, const char* last, char a, char b);
+
+    /**
+     * @brief Counts the quote characters in a range.
+     *
+     * Used to tell whether a position lies inside a quoted field.
+     *
+     * @param p Start of the range.
+     * @param last One past the end of the range.
+     * @return size_t The number of '"' bytes.
+     */
+    static size_t countQuotes(const char* p, const char* last);
+};
+
+#endif // CSV_SCANNER_H
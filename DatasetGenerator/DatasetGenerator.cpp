@@ -0,0 +1,839 @@
+/***************************************************************************
+ * DatasetGenerator.cpp
+ *
+ * Team:            Gearoid, Cedric
+ * Group:           1
+ * Student IDs:     S10241866, S10241549
+ *
+ * Features Highlight:
+ *   - Writes actors.csv, movies.csv and cast.csv in the same shape as the
+ *     shipped files, at any scale (default 1M actors, 500k movies and 10M
+ *     cast rows) for load and query benchmarks.
+ *   - Seedable: the same seed and sizes always produce byte-identical files,
+ *     on any compiler (own SplitMix64 generator, no <random> distributions,
+ *     and the power-law weights use fixed-point log2/exp2 and integer
+ *     cumulative tables instead of std::pow, whose rounding differs
+ *     between standard libraries).
+ *   - Sparse 7-8 digit IDs, rows in shuffled order, some quoted titles.
+ *   - Cast sizes follow a Pareto distribution; actors are drawn by a Zipf
+ *     popularity rank, so actor degrees follow a power law.
+ *   - Collaborations repeat: each movie belongs to a (Zipf-chosen) studio
+ *     that keeps a few regulars, who are cast together again.
+ *
+ *   Usage:
+ *     DatasetGenerator [--actors N] [--movies N] [--cast N] [--seed S] [--out DIR]
+ ***************************************************************************/
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+/// Largest cast a single movie is given.
+static const int MAX_CAST_SIZE = 2000;
+
+/// Pareto shape of the cast-size distribution (lower is heavier-tailed; at
+/// least 32/22, so the Q10 weights in makeCastSizes() fit in 32 bits).
+static const double CAST_SIZE_ALPHA = 1.5;
+
+/// Zipf exponent of actor popularity; degree exponent is about 1 + 1/s.
+static const double ACTOR_ZIPF_S = 0.9;
+
+/// Actors per unit of popularity rank offset; the offset flattens the head of
+/// the distribution so the busiest actor's share stays realistic at any scale.
+static const int ACTORS_PER_ZIPF_OFFSET = 1000;
+
+/// Zipf exponent of studio size.
+static const double STUDIO_ZIPF_S = 1.0;
+
+/// Average number of movies per studio.
+static const int MOVIES_PER_STUDIO = 40;
+
+/// Regulars remembered per studio.
+static const int REGULARS_PER_STUDIO = 8;
+
+/// Chance that a cast slot goes to one of the studio's regulars.
+static const double REGULAR_CHANCE = 0.35;
+
+/// Leading cast members of each movie who become studio regulars.
+static const int LEADS_PER_MOVIE = 3;
+
+/// Bytes buffered before each write to a CSV file.
+static const size_t WRITE_BUFFER_BYTES = 1 << 20;
+
+static const char* FIRST_NAMES[] = {
+    "James", "Mary", "Hiroshi", "Anna", "Carlos", "Priya", "Mohammed", "Sofia",
+    "Wei", "Elena", "Olusegun", "Ingrid", "Rajesh", "Camille", "Dmitri", "Aiko",
+    "Mateo", "Fatima", "Lars", "Chloe", "Kwame", "Yuki", "Pedro", "Leila",
+    "Thomas", "Nadia", "Jun", "Isabel", "Arjun", "Greta", "Luca", "Amara",
+    "Ravi", "Marta", "Kenji", "Rosa", "Omar", "Helga", "Diego", "Mei"
+};
+
+static const char* LAST_NAMES[] = {
+    "Smith", "Tanaka", "Garcia", "Kumar", "Rossi", "M\xC3\xBCller", "Okafor", "Kim",
+    "Novak", "Silva", "Dubois", "Ivanova", "Chen", "Hansen", "Moreau", "Sato",
+    "Lopez", "Ahmed", "Jansen", "Nguyen", "Kowalski", "Costa", "Ali", "Berg",
+    "Watanabe", "Fern\xC3\xA1ndez", "Mensah", "Park", "Schmidt", "Gupta", "Romano", "Haddad",
+    "Lindqvist", "Mori", "Castillo", "Singh", "Petrov", "Yilmaz", "O'Brien", "Suzuki"
+};
+
+static const char* TITLE_ADJECTIVES[] = {
+    "Last", "Silent", "Broken", "Golden", "Hidden", "Lost", "Red", "Endless",
+    "Secret", "Wild", "Dark", "Little", "Forgotten", "Burning", "Frozen", "Distant"
+};
+
+static const char* TITLE_NOUNS[] = {
+    "Summer", "River", "City", "Promise", "Kingdom", "Night", "Road", "Garden",
+    "Station", "Letter", "Island", "Storm", "Mirror", "Harbour", "Dream", "Frontier",
+    "Winter", "Song", "House", "Border", "Empire", "Shadow", "Voyage", "Heart"
+};
+
+template <typename T, size_t N>
+static int countOf(T(&)[N]) {
+    return static_cast<int>(N);
+}
+
+ /**
+  * @brief SplitMix64 pseudo-random generator.
+  *
+  * Used instead of <random> distributions, whose output differs between
+  * standard libraries, so a seed reproduces the same files everywhere.
+  */
+class SplitMix64 {
+private:
+    uint64_t state; ///< Current state.
+
+public:
+    /**
+     * @brief Constructs a generator from a seed.
+     *
+     * @param seed The seed.
+     */
+    explicit SplitMix64(uint64_t seed) : state(seed) {}
+
+    /**
+     * @brief Returns the next 64 random bits.
+     *
+     * @return uint64_t The random value.
+     */
+    uint64_t next() {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    /**
+     * @brief Returns a uniform double in [0, 1).
+     *
+     * @return double The random value.
+     */
+    double uniform() {
+        return static_cast<double>(next() >> 11) * (1.0 / 9007199254740992.0);
+    }
+
+    /**
+     * @brief Returns a uniform integer in [0, bound).
+     *
+     * @param bound The exclusive upper bound (must be positive).
+     * @return int The random value.
+     */
+    int below(int bound) {
+        return static_cast<int>(next() % static_cast<uint64_t>(bound));
+    }
+
+    /**
+     * @brief Returns an unbiased uniform integer in [0, bound).
+     *
+     * Draws that fall in the incomplete last block of 2^64 are redrawn, so
+     * large bounds are not skewed towards small values.
+     *
+     * @param bound The exclusive upper bound (must be positive).
+     * @return uint64_t The random value.
+     */
+    uint64_t belowWide(uint64_t bound) {
+        uint64_t limit = UINT64_MAX - UINT64_MAX % bound;
+        uint64_t value = next();
+        while (value >= limit) {
+            value = next();
+        }
+        return value % bound;
+    }
+};
+
+// ---------------------------------------------------------------------------
+// Fixed-Point Powers
+// ---------------------------------------------------------------------------
+
+/// Fractional bits of the Q32 fixed-point logarithms and powers below.
+static const int FIXED_BITS = 32;
+
+/// Fractional bits of an exponent passed to fixedPowNeg().
+static const int EXPONENT_BITS = 16;
+
+/// EXP2_NEG_HALVINGS[i] = 2^(-2^-(i+1)) in Q32, rounded to nearest.
+static const uint64_t EXP2_NEG_HALVINGS[FIXED_BITS] = {
+    0xB504F334ULL, 0xD744FCCBULL, 0xEAC0C6E8ULL, 0xF5257D15ULL,
+    0xFA83B2DBULL, 0xFD3E0C0DULL, 0xFE9E115CULL, 0xFF4ECB59ULL,
+    0xFFA75652ULL, 0xFFD3A752ULL, 0xFFE9D2B3ULL, 0xFFF4E91CULL,
+    0xFFFA747FULL, 0xFFFD3A3BULL, 0xFFFE9D1DULL, 0xFFFF4E8EULL,
+    0xFFFFA747ULL, 0xFFFFD3A3ULL, 0xFFFFE9D2ULL, 0xFFFFF4E9ULL,
+    0xFFFFFA74ULL, 0xFFFFFD3AULL, 0xFFFFFE9DULL, 0xFFFFFF4FULL,
+    0xFFFFFFA7ULL, 0xFFFFFFD4ULL, 0xFFFFFFEAULL, 0xFFFFFFF5ULL,
+    0xFFFFFFFAULL, 0xFFFFFFFDULL, 0xFFFFFFFFULL, 0xFFFFFFFFULL
+};
+
+/**
+ * @brief Computes log2 of a positive integer in Q32, using integer operations only.
+ *
+ * The mantissa is normalized to [1, 2) in Q31 and squared once per
+ * fractional bit: each time the square reaches 2, that bit is set.
+ *
+ * @param x The value (at least 1).
+ * @return uint64_t log2(x) in Q32.
+ */
+static uint64_t fixedLog2(uint64_t x) {
+    int whole = 0;
+    while ((x >> whole) > 1) {
+        ++whole;
+    }
+    uint64_t mantissa = (whole >= 31) ? x >> (whole - 31) : x << (31 - whole);
+    uint64_t result = static_cast<uint64_t>(whole) << FIXED_BITS;
+    for (int bit = FIXED_BITS - 1; bit >= 0; --bit) {
+        mantissa = (mantissa * mantissa) >> 31;
+        if (mantissa >= (1ULL << 32)) {
+            mantissa >>= 1;
+            result |= 1ULL << bit;
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Computes 2^-y in Q32 for a Q32 y >= 0, using integer operations only.
+ *
+ * @param y The exponent in Q32.
+ * @return uint64_t 2^-y in Q32 (0 once it drops below 2^-32).
+ */
+static uint64_t fixedExp2Neg(uint64_t y) {
+    uint64_t whole = y >> FIXED_BITS;
+    if (whole >= FIXED_BITS) {
+        return 0;
+    }
+    uint64_t result = 1ULL << FIXED_BITS;
+    for (int i = 0; i < FIXED_BITS; ++i) {
+        if (y & (1ULL << (FIXED_BITS - 1 - i))) {
+            result = (result * EXP2_NEG_HALVINGS[i]) >> FIXED_BITS;
+        }
+    }
+    return result >> whole;
+}
+
+/**
+ * @brief Converts an exponent constant to fixed point.
+ *
+ * Scaling by a power of two and truncating is exact in IEEE arithmetic, so
+ * every compiler gets the same integer.
+ *
+ * @param value The exponent.
+ * @return uint64_t The exponent with EXPONENT_BITS fractional bits.
+ */
+static uint64_t toFixedExponent(double value) {
+    return static_cast<uint64_t>(value * (1 << EXPONENT_BITS));
+}
+
+/**
+ * @brief Computes x^-s in Q32.
+ *
+ * @param x The base (at least 1).
+ * @param s The exponent, from toFixedExponent().
+ * @return uint64_t x^-s in Q32.
+ */
+static uint64_t fixedPowNeg(uint64_t x, uint64_t s) {
+    return fixedExp2Neg((fixedLog2(x) * s) >> EXPONENT_BITS);
+}
+
+/**
+ * @brief Zipf(-Mandelbrot) sampler over ranks 0..count-1 by binary search on cumulative weights.
+ *
+ * The weights and their running sums are Q32 integers, so the table and
+ * every draw are the same on any compiler.
+ */
+class ZipfSampler {
+private:
+    uint64_t* cumulative; ///< cumulative[r] = sum of weights of ranks 0..r, in Q32.
+    int count;            ///< Number of ranks.
+
+public:
+    /**
+     * @brief Builds the cumulative weights, weight(r) = 1 / (r + offset)^s.
+     *
+     * @param count Number of ranks.
+     * @param s The Zipf exponent.
+     * @param offset The rank offset (1 for plain Zipf).
+     */
+    ZipfSampler(int count, double s, int offset) : cumulative(new uint64_t[count > 0 ? count : 1]), count(count) {
+        uint64_t exponent = toFixedExponent(s);
+        uint64_t total = 0;
+        for (int r = 0; r < count; ++r) {
+            total += fixedPowNeg(static_cast<uint64_t>(r) + offset, exponent);
+            cumulative[r] = total;
+        }
+    }
+
+    /**
+     * @brief Destructor.
+     */
+    ~ZipfSampler() {
+        delete[] cumulative;
+    }
+
+    // Copy constructor and assignment operator are disabled for simplicity.
+    ZipfSampler(const ZipfSampler&) = delete;
+    ZipfSampler& operator=(const ZipfSampler&) = delete;
+
+    /**
+     * @brief Draws a rank.
+     *
+     * @param rng The random generator.
+     * @return int A rank in [0, count).
+     */
+    int sample(SplitMix64& rng) const {
+        uint64_t target = rng.belowWide(cumulative[count - 1]);
+        int low = 0;
+        int high = count - 1;
+        while (low < high) {
+            int mid = low + (high - low) / 2;
+            if (cumulative[mid] <= target) {
+                low = mid + 1;
+            }
+            else {
+                high = mid;
+            }
+        }
+        return low;
+    }
+};
+
+/**
+ * @brief Buffered CSV file writer.
+ */
+class CsvWriter {
+private:
+    std::ofstream out;   ///< The file.
+    std::string buffer;  ///< Rows not yet written.
+
+public:
+    /**
+     * @brief Creates (or truncates) a file.
+     *
+     * @param path The file path.
+     */
+    explicit CsvWriter(const std::string& path) : out(path.c_str(), std::ios::binary | std::ios::trunc) {
+        buffer.reserve(WRITE_BUFFER_BYTES + 256);
+    }
+
+    /**
+     * @brief Destructor. Writes any buffered rows.
+     */
+    ~CsvWriter() {
+        flush();
+    }
+
+    /**
+     * @brief Checks whether the file opened and every write so far succeeded.
+     *
+     * @return bool True if good.
+     */
+    bool good() const {
+        return out.good();
+    }
+
+    /**
+     * @brief Appends text, writing the buffer once it is full.
+     *
+     * @param text The text.
+     */
+    void put(const std::string& text) {
+        buffer += text;
+        if (buffer.size() >= WRITE_BUFFER_BYTES) {
+            flush();
+        }
+    }
+
+    /**
+     * @brief Appends a non-negative integer.
+     *
+     * @param value The integer.
+     */
+    void putInt(long long value) {
+        char digits[24];
+        int length = 0;
+        do {
+            digits[length++] = static_cast<char>('0' + value % 10);
+            value /= 10;
+        } while (value > 0);
+        while (length > 0) {
+            buffer += digits[--length];
+        }
+    }
+
+    /**
+     * @brief Appends a single character.
+     *
+     * @param c The character.
+     */
+    void putChar(char c) {
+        buffer += c;
+        if (c == '\n' && buffer.size() >= WRITE_BUFFER_BYTES) {
+            flush();
+        }
+    }
+
+    /**
+     * @brief Writes the buffered rows to the file.
+     */
+    void flush() {
+        if (!buffer.empty()) {
+            out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            buffer.clear();
+        }
+        out.flush();
+    }
+};
+
+/**
+ * @brief Fills an array with sparse, distinct, ascending IDs.
+ *
+ * IDs are spread over [1, space) with a random gap in each stride, like
+ * the 7-8 digit IMDb numbers in the shipped files.
+ *
+ * @param ids The array to fill.
+ * @param count Number of IDs.
+ * @param space Size of the ID space (at least count).
+ * @param rng The random generator.
+ */
+static void makeSparseIds(int* ids, int count, long long space, SplitMix64& rng) {
+    long long stride = space / count;
+    for (int i = 0; i < count; ++i) {
+        ids[i] = static_cast<int>(1 + i * stride + rng.below(static_cast<int>(stride)));
+    }
+}
+
+/**
+ * @brief Shuffles an array in place (Fisher-Yates).
+ *
+ * @param values The array.
+ * @param count Number of elements.
+ * @param rng The random generator.
+ */
+static void shuffle(int* values, int count, SplitMix64& rng) {
+    for (int i = count - 1; i > 0; --i) {
+        int j = rng.below(i + 1);
+        int temp = values[i];
+        values[i] = values[j];
+        values[j] = temp;
+    }
+}
+
+/**
+ * @brief Makes a person's name.
+ *
+ * @param rng The random generator.
+ * @return std::string The name.
+ */
+static std::string makeName(SplitMix64& rng) {
+    std::string name = FIRST_NAMES[rng.below(countOf(FIRST_NAMES))];
+    if (rng.below(8) == 0) {
+        name += ' ';
+        name += static_cast<char>('A' + rng.below(26));
+        name += '.';
+    }
+    name += ' ';
+    name += LAST_NAMES[rng.below(countOf(LAST_NAMES))];
+    return name;
+}
+
+/**
+ * @brief Makes a movie title, quoted when it contains a comma.
+ *
+ * @param rng The random generator.
+ * @return std::string The CSV field.
+ */
+static std::string makeTitle(SplitMix64& rng) {
+    const char* adjective = TITLE_ADJECTIVES[rng.below(countOf(TITLE_ADJECTIVES))];
+    const char* noun = TITLE_NOUNS[rng.below(countOf(TITLE_NOUNS))];
+    const char* other = TITLE_NOUNS[rng.below(countOf(TITLE_NOUNS))];
+    switch (rng.below(6)) {
+    case 0:
+        return std::string("The ") + adjective + " " + noun;
+    case 1:
+        return std::string(noun) + " of the " + adjective + " " + other;
+    case 2:
+        return std::string("\"") + adjective + " " + noun + ", " + other + "\"";
+    case 3:
+        return std::string(adjective) + " " + noun + " " + std::to_string(2 + rng.below(4));
+    default:
+        return std::string(adjective) + " " + noun;
+    }
+}
+
+/**
+ * @brief Parses a non-negative integer option value.
+ *
+ * @param text The value text.
+ * @param value Receives the value.
+ * @return bool True if the text is a valid number.
+ */
+static bool parseCount(const char* text, unsigned long long& value) {
+    char* end = nullptr;
+    value = std::strtoull(text, &end, 10);
+    return end != text && *end == '\0';
+}
+
+/**
+ * @brief Writes actors.csv.
+ *
+ * @param path The file path.
+ * @param actorIds The actor IDs.
+ * @param actorCount Number of actors.
+ * @param rng The random generator.
+ * @return bool True on success.
+ */
+static bool writeActors(const std::string& path, const int* actorIds, int actorCount, SplitMix64& rng) {
+    int* order = new int[actorCount];
+    for (int i = 0; i < actorCount; ++i) {
+        order[i] = i;
+    }
+    shuffle(order, actorCount, rng);
+
+    CsvWriter out(path);
+    out.put("id,name,birth\n");
+    for (int i = 0; i < actorCount; ++i) {
+        // Birth years cluster around the 1960s-70s, spread 1900-2012.
+        int birth = 1900 + static_cast<int>((rng.uniform() + rng.uniform() + rng.uniform()) / 3.0 * 113.0);
+        out.putInt(actorIds[order[i]]);
+        out.putChar(',');
+        out.put(makeName(rng));
+        out.putChar(',');
+        out.putInt(birth);
+        out.putChar('\n');
+    }
+    out.flush();
+    delete[] order;
+    return out.good();
+}
+
+/**
+ * @brief Writes movies.csv.
+ *
+ * @param path The file path.
+ * @param movieIds The movie IDs.
+ * @param movieCount Number of movies.
+ * @param rng The random generator.
+ * @return bool True on success.
+ */
+static bool writeMovies(const std::string& path, const int* movieIds, int movieCount, SplitMix64& rng) {
+    int* order = new int[movieCount];
+    for (int i = 0; i < movieCount; ++i) {
+        order[i] = i;
+    }
+    shuffle(order, movieCount, rng);
+
+    CsvWriter out(path);
+    out.put("id,title,plot,year\n");
+    for (int i = 0; i < movieCount; ++i) {
+        // More movies are made every year: skew release years towards the present.
+        double u = rng.uniform();
+        int year = 2024 - static_cast<int>(u * u * 105.0);
+        out.putInt(movieIds[order[i]]);
+        out.putChar(',');
+        out.put(makeTitle(rng));
+        out.put(",Plot ");
+        out.putInt(i + 1);
+        out.putChar(',');
+        out.putInt(year);
+        out.putChar('\n');
+    }
+    out.flush();
+    delete[] order;
+    return out.good();
+}
+
+/**
+ * @brief Splits the cast rows between movies with Pareto-distributed sizes.
+ *
+ * @param castSizes Receives each movie's cast size.
+ * @param movieCount Number of movies.
+ * @param castRows Total cast rows (at most movieCount * maxSize).
+ * @param maxSize Largest cast allowed.
+ * @param rng The random generator.
+ */
+static void makeCastSizes(int* castSizes, int movieCount, long long castRows, int maxSize, SplitMix64& rng) {
+    // Pareto weight v^(-1/alpha) for v uniform in (0, 1], in Q10 fixed point:
+    // with v = u / 2^32, -log2(v) = 32 - log2(u), so the weight is at most
+    // 2^(32/alpha) and a movie's share of castRows fits in 64 bits.
+    const int WEIGHT_BITS = 10;
+    uint64_t inverseAlpha = toFixedExponent(1.0 / CAST_SIZE_ALPHA);
+    uint64_t* weights = new uint64_t[movieCount];
+    uint64_t total = 0;
+    for (int m = 0; m < movieCount; ++m) {
+        uint64_t u = (rng.next() >> 32) + 1;
+        uint64_t power = ((32ULL << FIXED_BITS) - fixedLog2(u)) * inverseAlpha >> EXPONENT_BITS;
+        // 2^power = 2^ceil(power) * 2^-(ceil(power) - power).
+        uint64_t ceiling = (power + (1ULL << FIXED_BITS) - 1) >> FIXED_BITS;
+        uint64_t fraction = fixedExp2Neg((ceiling << FIXED_BITS) - power);
+        weights[m] = fraction >> (FIXED_BITS - WEIGHT_BITS - ceiling);
+        total += weights[m];
+    }
+    int minSize = (castRows >= movieCount) ? 1 : 0;
+    long long assigned = 0;
+    for (int m = 0; m < movieCount; ++m) {
+        long long size = static_cast<long long>(static_cast<uint64_t>(castRows) * weights[m] / total);
+        if (size < minSize) {
+            size = minSize;
+        }
+        if (size > maxSize) {
+            size = maxSize;
+        }
+        castSizes[m] = static_cast<int>(size);
+        assigned += size;
+    }
+    delete[] weights;
+
+    // Rounding and clamping leave a small difference; spread it over random movies.
+    while (assigned < castRows) {
+        int m = rng.below(movieCount);
+        if (castSizes[m] < maxSize) {
+            ++castSizes[m];
+            ++assigned;
+        }
+    }
+    while (assigned > castRows) {
+        int m = rng.below(movieCount);
+        if (castSizes[m] > minSize) {
+            --castSizes[m];
+            --assigned;
+        }
+    }
+}
+
+/**
+ * @brief Writes cast.csv.
+ *
+ * Each movie's cast is drawn from the actors by popularity rank, except
+ * that some slots go to regulars of the movie's studio; the movie's leads
+ * then become regulars themselves.
+ *
+ * @param path The file path.
+ * @param actorIds The actor IDs.
+ * @param actorCount Number of actors.
+ * @param movieIds The movie IDs.
+ * @param movieCount Number of movies.
+ * @param castRows Number of cast rows to write.
+ * @param rng The random generator.
+ * @param maxDegree Receives the largest number of movies of one actor.
+ * @param maxCast Receives the largest cast.
+ * @return bool True on success.
+ */
+static bool writeCast(const std::string& path, const int* actorIds, int actorCount,
+    const int* movieIds, int movieCount, long long castRows, SplitMix64& rng,
+    int& maxDegree, int& maxCast) {
+    int maxSize = (actorCount < MAX_CAST_SIZE) ? actorCount : MAX_CAST_SIZE;
+    int* castSizes = new int[movieCount];
+    makeCastSizes(castSizes, movieCount, castRows, maxSize, rng);
+
+    // Popularity rank r belongs to actor byRank[r], so popular actors have random IDs.
+    int* byRank = new int[actorCount];
+    for (int i = 0; i < actorCount; ++i) {
+        byRank[i] = i;
+    }
+    shuffle(byRank, actorCount, rng);
+    ZipfSampler actorRanks(actorCount, ACTOR_ZIPF_S, 20 + actorCount / ACTORS_PER_ZIPF_OFFSET);
+
+    int studioCount = movieCount / MOVIES_PER_STUDIO + 1;
+    ZipfSampler studioRanks(studioCount, STUDIO_ZIPF_S, 1);
+    int* regulars = new int[studioCount * REGULARS_PER_STUDIO];
+    int* regularCount = new int[studioCount];
+    int* regularNext = new int[studioCount];
+    std::memset(regularCount, 0, sizeof(int) * studioCount);
+    std::memset(regularNext, 0, sizeof(int) * studioCount);
+
+    int* castedIn = new int[actorCount];   // Last movie each actor was cast in (dedup stamp).
+    int* degree = new int[actorCount];
+    std::memset(castedIn, -1, sizeof(int) * actorCount);
+    std::memset(degree, 0, sizeof(int) * actorCount);
+    int* cast = new int[maxSize > 0 ? maxSize : 1];
+
+    int* order = new int[movieCount];
+    for (int m = 0; m < movieCount; ++m) {
+        order[m] = m;
+    }
+    shuffle(order, movieCount, rng);
+
+    CsvWriter out(path);
+    out.put("person_id,movie_id\n");
+    maxCast = 0;
+    for (int i = 0; i < movieCount; ++i) {
+        int m = order[i];
+        int studio = studioRanks.sample(rng);
+        int* studioRegulars = regulars + studio * REGULARS_PER_STUDIO;
+        int size = 0;
+        while (size < castSizes[m]) {
+            int actor;
+            if (regularCount[studio] > 0 && rng.uniform() < REGULAR_CHANCE) {
+                actor = studioRegulars[rng.below(regularCount[studio])];
+            }
+            else {
+                actor = byRank[actorRanks.sample(rng)];
+            }
+            // A large cast can exhaust the popular actors; fall back to a uniform pick.
+            for (int attempt = 0; castedIn[actor] == m && attempt < 8; ++attempt) {
+                actor = (attempt < 4) ? byRank[actorRanks.sample(rng)] : rng.below(actorCount);
+            }
+            while (castedIn[actor] == m) {
+                actor = (actor + 1) % actorCount;
+            }
+            castedIn[actor] = m;
+            cast[size++] = actor;
+        }
+
+        for (int k = 0; k < size; ++k) {
+            ++degree[cast[k]];
+            out.putInt(actorIds[cast[k]]);
+            out.putChar(',');
+            out.putInt(movieIds[m]);
+            out.putChar('\n');
+        }
+        if (size > maxCast) {
+            maxCast = size;
+        }
+
+        // The leads join the studio's regulars, replacing the oldest.
+        for (int k = 0; k < size && k < LEADS_PER_MOVIE; ++k) {
+            studioRegulars[regularNext[studio]] = cast[k];
+            regularNext[studio] = (regularNext[studio] + 1) % REGULARS_PER_STUDIO;
+            if (regularCount[studio] < REGULARS_PER_STUDIO) {
+                ++regularCount[studio];
+            }
+        }
+    }
+    out.flush();
+
+    maxDegree = 0;
+    for (int a = 0; a < actorCount; ++a) {
+        if (degree[a] > maxDegree) {
+            maxDegree = degree[a];
+        }
+    }
+
+    delete[] order;
+    delete[] cast;
+    delete[] degree;
+    delete[] castedIn;
+    delete[] regularNext;
+    delete[] regularCount;
+    delete[] regulars;
+    delete[] byRank;
+    delete[] castSizes;
+    return out.good();
+}
+
+/**
+ * @brief Generates a synthetic dataset.
+ *
+ * @param argc Number of command-line arguments.
+ * @param argv Command-line arguments (see the usage in the file header).
+ * @return int 0 on success, 1 on bad arguments or a write failure.
+ */
+int main(int argc, char* argv[]) {
+    unsigned long long actors = 1000000;
+    unsigned long long movies = 500000;
+    unsigned long long castRows = 10000000;
+    unsigned long long seed = 1;
+    std::string outDir = ".";
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            std::cerr << "[Error] Missing value for " << arg << ".\n";
+            return 1;
+        }
+        const char* value = argv[++i];
+        bool ok = true;
+        if (arg == "--actors") {
+            ok = parseCount(value, actors);
+        }
+        else if (arg == "--movies") {
+            ok = parseCount(value, movies);
+        }
+        else if (arg == "--cast") {
+            ok = parseCount(value, castRows);
+        }
+        else if (arg == "--seed") {
+            ok = parseCount(value, seed);
+        }
+        else if (arg == "--out") {
+            outDir = value;
+        }
+        else {
+            std::cerr << "[Error] Unknown option " << arg << ".\n"
+                << "Usage: DatasetGenerator [--actors N] [--movies N] [--cast N] [--seed S] [--out DIR]\n";
+            return 1;
+        }
+        if (!ok) {
+            std::cerr << "[Error] Invalid number for " << arg << ": " << value << "\n";
+            return 1;
+        }
+    }
+    if (actors == 0 || movies == 0 || actors > 100000000ULL || movies > 100000000ULL) {
+        std::cerr << "[Error] Actor and movie counts must be between 1 and 100000000.\n";
+        return 1;
+    }
+    int actorCount = static_cast<int>(actors);
+    int movieCount = static_cast<int>(movies);
+    int maxSize = (actorCount < MAX_CAST_SIZE) ? actorCount : MAX_CAST_SIZE;
+    if (castRows > static_cast<unsigned long long>(movieCount) * maxSize) {
+        castRows = static_cast<unsigned long long>(movieCount) * maxSize;
+        std::cout << "[Warning] Cast rows limited to " << castRows << " (" << maxSize << " per movie).\n";
+    }
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    SplitMix64 rng(seed);
+
+    // IDs fill a space of at least 8 digits, like the shipped files.
+    int* actorIds = new int[actorCount];
+    int* movieIds = new int[movieCount];
+    long long actorSpace = (actorCount * 10LL > 9999999LL) ? actorCount * 10LL : 9999999LL;
+    long long movieSpace = (movieCount * 20LL > 9999999LL) ? movieCount * 20LL : 9999999LL;
+    makeSparseIds(actorIds, actorCount, actorSpace, rng);
+    makeSparseIds(movieIds, movieCount, movieSpace, rng);
+
+    // Each file gets its own stream, so changing one size leaves the other files alone.
+    SplitMix64 actorRng(rng.next());
+    SplitMix64 movieRng(rng.next());
+    SplitMix64 castRng(rng.next());
+    std::string prefix = outDir.empty() ? std::string() : outDir + "/";
+    int maxDegree = 0;
+    int maxCast = 0;
+    bool ok = writeActors(prefix + "actors.csv", actorIds, actorCount, actorRng)
+        && writeMovies(prefix + "movies.csv", movieIds, movieCount, movieRng)
+        && writeCast(prefix + "cast.csv", actorIds, actorCount, movieIds, movieCount,
+            static_cast<long long>(castRows), castRng, maxDegree, maxCast);
+    delete[] movieIds;
+    delete[] actorIds;
+    if (!ok) {
+        std::cerr << "[Error] Could not write the CSV files to " << outDir << ".\n";
+        return 1;
+    }
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Wrote " << actorCount << " actors, " << movieCount << " movies and "
+        << castRows << " cast rows to " << outDir << " (seed " << seed << ") in "
+        << seconds << " s.\n"
+        << "Largest cast: " << maxCast << " actors. Busiest actor: " << maxDegree << " movies.\n";
+    return 0;
+}
@@ -0,0 +1,182 @@
+#include "DenseTable.h"
+#include "Actor.h"
+#include "Movie.h"
+#include <functional>
+
+/**
+ * @brief Constructs an empty DenseTable.
+ *
+ * @tparam T The type of records stored in the table.
+ * @param initialCapacity Initial number of record slots.
+ */
+template <typename T>
+DenseTable<T>::DenseTable(int initialCapacity)
+    : ids(initialCapacity),
+    records(new T[initialCapacity]),
+    capacity(initialCapacity),
+    growCount(0)
+{
+}
+
+/**
+ * @brief Destructor for DenseTable.
+ *
+ * @tparam T The type of records stored in the table.
+ */
+template <typename T>
+DenseTable<T>::~DenseTable() {
+    delete[] records;
+    records = nullptr;
+}
+
+/**
+ * @brief Inserts or updates an item.
+ *
+ * A new key is assigned the next dense ID and appended to the record array,
+ * which doubles in size when full. An existing key is overwritten in place.
+ *
+ * @tparam T The type of records stored in the table.
+ * @param item The item to insert.
+ * @return int The dense ID of the item.
+ */
+template <typename T>
+int DenseTable<T>::insert(const T& item) {
+    int denseId = ids.assign(getKey(item));
+    if (denseId >= capacity) {
+        int newCapacity = capacity * 2;
+        T* newArr = new T[newCapacity];
+        for (int i = 0; i < denseId; ++i) {
+            newArr[i] = records[i];
+        }
+        delete[] records;
+        records = newArr;
+        capacity = newCapacity;
+        ++growCount;
+    }
+    records[denseId] = item;
+    return denseId;
+}
+
+/**
+ * @brief Finds an item by its external key.
+ *
+ * @tparam T The type of records stored in the table.
+ * @param key The external key.
+ * @return T* Pointer to the record, or nullptr if not found.
+ */
+template <typename T>
+T* DenseTable<T>::find(int key) const {
+    int denseId = ids.find(key);
+    return (denseId == -1) ? nullptr : &records[denseId];
+}
+
+/**
+ * @brief Translates an external key into a dense ID.
+ *
+ * @tparam T The type of records stored in the table.
+ * @param key The external key.
+ * @return int The dense ID, or -1 if not found.
+ */
+template <typename T>
+int DenseTable<T>::indexOf(int key) const {
+    return ids.find(key);
+}
+
+/**
+ * @brief Accesses a record by dense ID.
+ *
+ * @tparam T The type of records stored in the table.
+ * @param denseId The dense ID.
+ * @return T& Reference to the record.
+ */
+template <typename T>
+T& DenseTable<T>::at(int denseId) const {
+    return records[denseId];
+}
+
+/**
+ * @brief Returns the external key stored at a dense ID.
+ *
+ * @tparam T The type of records stored in the table.
+ * @param denseId The dense ID.
+ * @return int The external key.
+ */
+template <typename T>
+int DenseTable<T>::keyAt(int denseId) const {
+    return ids.externalOf(denseId);
+}
+
+/**
+ * @brief Checks whether the table is empty.
+ *
+ * @tparam T The type of records stored in the table.
+ * @return true if empty; false otherwise.
+ */
+template <typename T>
+bool DenseTable<T>::isEmpty() const {
+    return ids.size() == 0;
+}
+
+/**
+ * @brief Returns the number of stored items.
+ *
+ * @tparam T The type of records stored in the table.
+ * @return int The number of items.
+ */
+template <typename T>
+int DenseTable<T>::size() const {
+    return ids.size();
+}
+
+/**
+ * @brief Returns the allocated size of the records array.
+ *
+ * @tparam T The type of records stored in the table.
+ * @return int The record capacity.
+ */
+template <typename T>
+int DenseTable<T>::getCapacity() const {
+    return capacity;
+}
+
+/**
+ * @brief Returns how many times the records array has been doubled.
+ *
+ * @tparam T The type of records stored in the table.
+ * @return int The grow count.
+ */
+template <typename T>
+int DenseTable<T>::getGrowCount() const {
+    return growCount;
+}
+
+/**
+ * @brief Returns the external ID dictionary.
+ *
+ * @tparam T The type of records stored in the table.
+ * @return const IdDictionary& The dictionary.
+ */
+template <typename T>
+const IdDictionary& DenseTable<T>::getIds() const {
+    return ids;
+}
+
+/**
+ * @brief Iterates over all items in dense ID order.
+ *
+ * @tparam T The type of records stored in the table.
+ * @param fn A function that returns true to stop the iteration early.
+ */
+template <typename T>
+void DenseTable<T>::forEach(const std::function<bool(const T&)>& fn) const {
+    int n = ids.size();
+    for (int i = 0; i < n; ++i) {
+        if (fn(records[i])) {
+            return;
+        }
+    }
+}
+
+// ***** Explicit Template Instantiations *****
+template class DenseTable<Actor>;
+template class DenseTable<Movie>;
@@ -0,0 +1,144 @@
+#ifndef DENSE_TABLE_H
+#define DENSE_TABLE_H
+
+#include "HashTable.h"
+#include "IdDictionary.h"
+#include <functional>
+
+/***************************************************************************
+ * DenseTable.h
+ *
+ * Team:            Gearoid, Cedric
+ * Group:           1
+ * Student IDs:     S10241866, S10241549
+ *
+ * Features Highlight:
+ *   - Stores records in a plain array indexed by dense ID.
+ *   - Uses an IdDictionary to translate external IDs to array positions.
+ *   - Offers the same insert/find/forEach interface as HashTable, plus direct
+ *     access by dense ID for the graph and secondary indexes.
+ *
+ ***************************************************************************/
+
+ /**
+  * @brief A table of records addressed by dense ID.
+  *
+  * Items are keyed with getKey<T>(), exactly like HashTable. Inserting an
+  * existing key updates the record in place; records are never removed, so
+  * dense IDs stay valid for the lifetime of the table.
+  *
+  * @tparam T The type of records stored in the table.
+  */
+template <typename T>
+class DenseTable {
+private:
+    IdDictionary ids;  ///< External ID <-> dense ID dictionary.
+    T* records;        ///< Records indexed by dense ID.
+    int capacity;      ///< Allocated size of the records array.
+    int growCount;     ///< Number of times the records array has been doubled.
+
+public:
+    /**
+     * @brief Constructs an empty table.
+     *
+     * @param initialCapacity Initial number of record slots (default is 2000).
+     */
+    explicit DenseTable(int initialCapacity = 2000);
+
+    /**
+     * @brief Destructor.
+     *
+     * Releases the record array.
+     */
+    ~DenseTable();
+
+    // Copy constructor and assignment operator are disabled for simplicity.
+    DenseTable(const DenseTable&) = delete;
+    DenseTable& operator=(const DenseTable&) = delete;
+
+    /**
+     * @brief Inserts an item, or updates it if its key already exists.
+     *
+     * @param item The item to insert.
+     * @return int The dense ID of the item.
+     */
+    int insert(const T& item);
+
+    /**
+     * @brief Finds an item by its external key.
+     *
+     * @param key The external key of the item.
+     * @return T* Pointer to the item, or nullptr if not found.
+     */
+    T* find(int key) const;
+
+    /**
+     * @brief Translates an external key into a dense ID.
+     *
+     * @param key The external key.
+     * @return int The dense ID, or -1 if the key is not in the table.
+     */
+    int indexOf(int key) const;
+
+    /**
+     * @brief Accesses a record by dense ID.
+     *
+     * @param denseId A dense ID in the range [0, size()).
+     * @return T& Reference to the record.
+     */
+    T& at(int denseId) const;
+
+    /**
+     * @brief Returns the external key stored at a dense ID.
+     *
+     * @param denseId A dense ID in the range [0, size()).
+     * @return int The external key.
+     */
+    int keyAt(int denseId) const;
+
+    /**
+     * @brief Checks whether the table is empty.
+     *
+     * @return true if the table contains no items, false otherwise.
+     */
+    bool isEmpty() const;
+
+    /**
+     * @brief Returns the number of stored items.
+     *
+     * @return int The number of items (and the exclusive upper bound of dense IDs).
+     */
+    int size() const;
+
+    /**
+     * @brief Returns the allocated size of the records array.
+     *
+     * @return int The record capacity.
+     */
+    int getCapacity() const;
+
+    /**
+     * @brief Returns how many times the records array has been doubled.
+     *
+     * @return int The grow count.
+     */
+    int getGrowCount() const;
+
+    /**
+     * @brief Returns the external ID dictionary.
+     *
+     * @return const IdDictionary& The dictionary.
+     */
+    const IdDictionary& getIds() const;
+
+    /**
+     * @brief Iterates over all items in dense ID order.
+     *
+     * The iteration stops early if the function returns true.
+     *
+     * @param fn A function to apply to each item.
+     */
+    void forEach(const std::function<bool(const T&)>& fn) const;
+};
+
+#endif // DENSE_TABLE_H
@@ -0,0 +1,106 @@
+/***************************************************************************
+ * DurableFile.cpp
+ *
+ * Team:            Gearoid, Cedric
+ * Group:           1
+ * Student IDs:     S10241866, S10241549
+ *
+ * Features Highlight:
+ *   - File and directory flushing for Windows and POSIX.
+ *   - Atomic replace-by-rename.
+ ***************************************************************************/
+
+#include "DurableFile.h"
+#include <cstdio>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <fcntl.h>
+#include <io.h>
+#include <share.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+ /**
+  * @brief Flushes a file's contents to stable storage.
+  *
+  * @param path The file.
+  * @return bool True on success.
+  */
+bool syncFileAt(const std::string& path) {
+#ifdef _WIN32
+    int fd = -1;
+    // _commit needs a descriptor open for writing; nothing is written.
+    if (_sopen_s(&fd, path.c_str(), _O_WRONLY | _O_BINARY, _SH_DENYNO, 0) != 0) {
+        return false;
+    }
+    bool ok = _commit(fd) == 0;
+    _close(fd);
+    return ok;
+#else
+    int fd = ::open(path.c_str(), O_WRONLY);
+    if (fd == -1) {
+        return false;
+    }
+    bool ok = ::fsync(fd) == 0;
+    ::close(fd);
+    return ok;
+#endif
+}
+
+/**
+ * @brief Flushes the directory that holds a file.
+ *
+ * @param path A file inside the directory.
+ * @return bool True on success (always on Windows).
+ */
+bool syncParentDirectory(const std::string& path) {
+#ifdef _WIN32
+    (void)path;
+    return true;
+#else
+    size_t slash = path.find_last_of('/');
+    std::string directory = (slash == std::string::npos) ? "." : path.substr(0, slash + 1);
+    int fd = ::open(directory.c_str(), O_RDONLY);
+    if (fd == -1) {
+        return false;
+    }
+    bool ok = ::fsync(fd) == 0;
+    ::close(fd);
+    return ok;
+#endif
+}
+
+/**
+ * @brief Renames a file over another in one step.
+ *
+ * @param from The new file.
+ * @param to The file it replaces.
+ * @return bool True on success.
+ */
+bool replaceFile(const std::string& from, const std::string& to) {
+#ifdef _WIN32
+    return MoveFileExA(from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+    return std::rename(from.c_str(), to.c_str()) == 0;
+#endif
+}
+
+/**
+ * @brief Flushes, renames into place and flushes the directory.
+ *
+ * @param tempPath The new file.
+ * @param path The file it replaces.
+ * @return bool True on success.
+ */
+bool commitReplacement(const std::string& tempPath, const std::string& path) {
+    return syncFileAt(tempPath) && replaceFile(tempPath, path) && syncParentDirectory(path);
+}
@@ -0,0 +1,64 @@
+#ifndef DURABLE_FILE_H
+#define DURABLE_FILE_H
+
+#include <string>
+
+/***************************************************************************
+ * DurableFile.h
+ *
+ * Team:            Gearoid, Cedric
+ * Group:           1
+ * Student IDs:     S10241866, S10241549
+ *
+ * Features Highlight:
+ *   - Helpers for replacing a file so that a crash or power cut leaves
+ *     either the old contents or the new ones, never a torn or missing
+ *     file: flush the new file, rename it over the old one in a single
+ *     step, then flush the directory entry.
+ *   - Uses fsync and rename on POSIX, and _commit and
+ *     MoveFileEx(MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) on
+ *     Windows.
+ *
+ ***************************************************************************/
+
+ /**
+  * @brief Flushes a file's contents to stable storage.
+  *
+  * @param path The file, which must already be closed by its writer.
+  * @return bool True on success.
+  */
+bool syncFileAt(const std::string& path);
+
+/**
+ * @brief Flushes the directory holding a file, making a rename or create durable.
+ *
+ * On Windows directories cannot be flushed; replaceFile() asks for a
+ * write-through rename instead, so this always succeeds there.
+ *
+ * @param path A file inside the directory.
+ * @return bool True on success.
+ */
+bool syncParentDirectory(const std::string& path);
+
+/**
+ * @brief Renames a file over another in one atomic step.
+ *
+ * The target is never removed first, so there is no moment at which
+ * neither file exists.
+ *
+ * @param from The new file.
+ * @param to The file it replaces (created if missing).
+ * @return bool True on success.
+ */
+bool replaceFile(const std::string& from, const std::string& to);
+
+/**
+ * @brief Flushes a finished temporary file, renames it over a target and flushes the directory.
+ *
+ * @param tempPath The new file, already written and closed.
+ * @param path The file it replaces.
+ * @return bool True once the new contents are durable under path.
+ */
+bool commitReplacement(const std::string& tempPath, const std::string& path);
+
+#endif // DURABLE_FILE_H
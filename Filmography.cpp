@@ -0,0 +1,138 @@
+/***************************************************************************
+ * Filmography.cpp
+ *
+ * Team:            Gearoid, Cedric
+ * Group:           1
+ * Student IDs:     S10241866, S10241549
+ *
+ * Features Highlight:
+ *   - Growable movie ID array with capacity doubling.
+ *   - Deep-copy copy constructor and assignment operator.
+ *   - Presized, unchecked appends; duplicates are ruled out by the caller.
+ ***************************************************************************/
+
+#include "Filmography.h"
+
+ /**
+  * @brief Default constructor.
+  *
+  * Initializes an empty filmography that owns no storage yet.
+  */
+Filmography::Filmography()
+    : movieIds(nullptr), count(0), capacity(0)
+{
+}
+
+/**
+ * @brief Copy constructor.
+ *
+ * Allocates an array of the same size and copies every movie ID.
+ *
+ * @param other The filmography to copy from.
+ */
+Filmography::Filmography(const Filmography& other)
+    : movieIds(nullptr), count(other.count), capacity(other.count)
+{
+    if (count > 0) {
+        movieIds = new int[capacity];
+        for (int i = 0; i < count; ++i) {
+            movieIds[i] = other.movieIds[i];
+        }
+    }
+}
+
+/**
+ * @brief Copy assignment operator.
+ *
+ * Releases the current array and deep-copies the other filmography.
+ *
+ * @param other The filmography to copy from.
+ * @return Reference to this filmography.
+ */
+Filmography& Filmography::operator=(const Filmography& other) {
+    if (this != &other) {
+        delete[] movieIds;
+        movieIds = nullptr;
+        count = other.count;
+        capacity = other.count;
+        if (count > 0) {
+            movieIds = new int[capacity];
+            for (int i = 0; i < count; ++i) {
+                movieIds[i] = other.movieIds[i];
+            }
+        }
+    }
+    return *this;
+}
+
+/**
+ * @brief Destructor.
+ */
+Filmography::~Filmography() {
+    delete[] movieIds;
+}
+
+/**
+ * @brief Gets the number of movies stored.
+ *
+ * @return The movie count.
+ */
+int Filmography::getCount() const {
+    return count;
+}
+
+/**
+ * @brief Gets the movie ID at a position.
+ *
+ * @param index Position in the range [0, getCount()).
+ * @return The movie ID.
+ */
+int Filmography::getMovieIdAt(int index) const {
+    return movieIds[index];
+}
+
+/**
+ * @brief Checks whether a movie ID is already present.
+ *
+ * @param movieId The movie ID to search for.
+ * @return true if found; false otherwise.
+ */
+bool Filmography::contains(int movieId) const {
+    for (int i = 0; i < count; ++i) {
+        if (movieIds[i] == movieId) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Grows the array so that extra more IDs fit.
+ *
+ * @param extra The number of IDs about to be appended.
+ */
+void Filmography::reserve(int extra) {
+    if (count + extra <= capacity) {
+        return;
+    }
+    int newCapacity = count + extra;
+    int* newArr = new int[newCapacity];
+    for (int i = 0; i < count; ++i) {
+        newArr[i] = movieIds[i];
+    }
+    delete[] movieIds;
+    movieIds = newArr;
+    capacity = newCapacity;
+}
+
+/**
+ * @brief Appends a movie ID without checking for duplicates, doubling the array when it is full.
+ *
+ * @param movieId The movie ID to append.
+ */
+void Filmography::append(int movieId) {
+    if (count >= capacity) {
+        reserve(capacity == 0 ? 4 : capacity);
+    }
+    movieIds[count++] = movieId;
+}
@@ -0,0 +1,116 @@
+#ifndef FILMOGRAPHY_H
+#define FILMOGRAPHY_H
+
+/***************************************************************************
+ * Filmography.h
+ *
+ * Team:            Gearoid, Cedric
+ * Group:           1
+ * Student IDs:     S10241866, S10241549
+ *
+ * Features Highlight:
+ *   - Posting list of movie IDs for a single actor (actor -> movies index).
+ *   - Backed by a growable array so appends are amortised O(1).
+ *   - Appends do not scan for duplicates: MovieApp only links an actor to
+ *     a movie after checking the cast, so the list mirrors the movie casts.
+ *
+ ***************************************************************************/
+
+ /**
+  * @brief The Filmography class stores the IDs of every movie an actor appears in.
+  *
+  * It is the reverse of Movie::getActors() and lets MovieApp answer
+  * "which movies is this actor in?" without scanning every movie.
+  */
+class Filmography {
+private:
+    int* movieIds;    ///< Dynamic array of movie IDs.
+    int count;        ///< Number of movie IDs stored.
+    int capacity;     ///< Allocated size of the movieIds array.
+
+public:
+    // --------------------------
+    // Constructors and Destructor
+    // --------------------------
+
+    /**
+     * @brief Default constructor.
+     *
+     * Initializes an empty filmography.
+     */
+    Filmography();
+
+    /**
+     * @brief Copy constructor.
+     *
+     * Creates a deep copy of another filmography.
+     *
+     * @param other The filmography to copy.
+     */
+    Filmography(const Filmography& other);
+
+    /**
+     * @brief Assignment operator.
+     *
+     * @param other The filmography to assign from.
+     * @return A reference to this filmography after assignment.
+     */
+    Filmography& operator=(const Filmography& other);
+
+    /**
+     * @brief Destructor.
+     *
+     * Releases the movie ID array.
+     */
+    ~Filmography();
+
+    // --------------------------
+    // Accessors
+    // --------------------------
+
+    /**
+     * @brief Returns the number of movies in the filmography.
+     *
+     * @return The movie count.
+     */
+    int getCount() const;
+
+    /**
+     * @brief Retrieves the movie ID stored at the given position.
+     *
+     * @param index Position in the range [0, getCount()).
+     * @return The movie ID at that position.
+     */
+    int getMovieIdAt(int index) const;
+
+    // --------------------------
+    // Modifiers
+    // --------------------------
+
+    /**
+     * @brief Checks whether a movie ID is already in the filmography.
+     *
+     * @param movieId The movie ID to look for.
+     * @return true if present, false otherwise.
+     */
+    bool contains(int movieId) const;
+
+    /**
+     * @brief Makes room for more movie IDs without further reallocation.
+     *
+     * @param extra The number of IDs about to be appended.
+     */
+    void reserve(int extra);
+
+    /**
+     * @brief Appends a movie ID the caller knows is not present yet.
+     *
+     * Amortised O(1); the caller is responsible for duplicates (see
+     * MovieApp::isCastMember()).
+     *
+     * @param movieId The movie ID to append.
+     */
+    void append(int movieId);
+};
+
+#endif // FILMOGRAPHY_H
@@ -20,6 +20,15 @@ int getKey(const T& item) {
     return 0;
 }
 
+class Actor;
+class Movie;
+
+// Specializations are defined in HashTable.cpp; declaring them here lets other
+// containers (e.g. DenseTable) key records the same way.
+template <> int getKey<int>(const int& item);
+template <> int getKey<Actor>(const Actor& item);
+template <> int getKey<Movie>(const Movie& item);
+
 /**
  * @brief A simple separate-chaining hash table using linked-list chaining.
  *
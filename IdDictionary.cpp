@@ -0,0 +1,190 @@
+/***************************************************************************
+ * IdDictionary.cpp
+ *
+ * Team:            Gearoid, Cedric
+ * Group:           1
+ * Student IDs:     S10241866, S10241549
+ *
+ * Features Highlight:
+ *   - Open-addressing lookup from external to dense IDs: multiplicative
+ *     hashing, linear probing, grown before it is half full.
+ *   - Growable reverse array from dense to external IDs.
+ ***************************************************************************/
+
+#include "IdDictionary.h"
+
+/**
+ * @brief Returns the smallest power of two that is at least twice a count.
+ *
+ * @param count The number of entries expected.
+ * @return int The slot count.
+ */
+static int slotCountFor(int count) {
+    int slots = 16;
+    while (slots < count * 2) {
+        slots *= 2;
+    }
+    return slots;
+}
+
+ /**
+  * @brief Constructs an empty dictionary.
+  *
+  * @param initialCapacity Initial size of the reverse array; the slot table starts at twice this.
+  */
+IdDictionary::IdDictionary(int initialCapacity)
+    : slots(nullptr),
+    slotMask(slotCountFor(initialCapacity) - 1),
+    rehashCount(0),
+    externalIds(new int[initialCapacity]),
+    count(0),
+    capacity(initialCapacity)
+{
+    slots = new IdMapping[slotMask + 1];
+    for (int i = 0; i <= slotMask; ++i) {
+        slots[i].denseId = -1;
+    }
+}
+
+/**
+ * @brief Destructor.
+ */
+IdDictionary::~IdDictionary() {
+    delete[] slots;
+    delete[] externalIds;
+}
+
+/**
+ * @brief Returns the slot an external ID's probe sequence starts at.
+ *
+ * Sequential IDs would land in neighbouring slots under the identity hash
+ * and form long runs, so the ID is scrambled with a Fibonacci multiplier
+ * first.
+ *
+ * @param externalId The external ID.
+ * @return int The home slot.
+ */
+int IdDictionary::homeSlot(int externalId) const {
+    unsigned int h = static_cast<unsigned int>(externalId) * 2654435769u;
+    return static_cast<int>((h ^ (h >> 16)) & static_cast<unsigned int>(slotMask));
+}
+
+/**
+ * @brief Finds an external ID's slot, or the first empty slot of its probe sequence.
+ *
+ * The table is never more than half full, so the probe always ends.
+ *
+ * @param externalId The external ID.
+ * @return int The slot index.
+ */
+int IdDictionary::probe(int externalId) const {
+    int i = homeSlot(externalId);
+    while (slots[i].denseId != -1 && slots[i].externalId != externalId) {
+        i = (i + 1) & slotMask;
+    }
+    return i;
+}
+
+/**
+ * @brief Doubles the slot table and reinserts every mapping.
+ *
+ * The mappings are rebuilt from the reverse array, which already lists
+ * every assigned external ID by dense ID.
+ */
+void IdDictionary::growSlots() {
+    delete[] slots;
+    slotMask = (slotMask + 1) * 2 - 1;
+    slots = new IdMapping[slotMask + 1];
+    for (int i = 0; i <= slotMask; ++i) {
+        slots[i].denseId = -1;
+    }
+    for (int d = 0; d < count; ++d) {
+        int i = probe(externalIds[d]);
+        slots[i].externalId = externalIds[d];
+        slots[i].denseId = d;
+    }
+    ++rehashCount;
+}
+
+/**
+ * @brief Returns the dense ID for an external ID, assigning a new one if needed.
+ *
+ * New IDs are appended to the reverse array, which doubles when full. The
+ * slot table doubles before it would become more than half full.
+ *
+ * @param externalId The external ID.
+ * @return int The dense ID.
+ */
+int IdDictionary::assign(int externalId) {
+    int slot = probe(externalId);
+    if (slots[slot].denseId != -1) {
+        return slots[slot].denseId;
+    }
+    if (count >= capacity) {
+        int newCapacity = capacity * 2;
+        int* newArr = new int[newCapacity];
+        for (int i = 0; i < count; ++i) {
+            newArr[i] = externalIds[i];
+        }
+        delete[] externalIds;
+        externalIds = newArr;
+        capacity = newCapacity;
+    }
+    externalIds[count] = externalId;
+    if ((count + 1) * 2 > slotMask + 1) {
+        // growSlots() reinserts from externalIds, so the new ID is placed with the rest.
+        ++count;
+        growSlots();
+        return count - 1;
+    }
+    slots[slot].externalId = externalId;
+    slots[slot].denseId = count;
+    return count++;
+}
+
+/**
+ * @brief Looks up the dense ID for an external ID.
+ *
+ * @param externalId The external ID.
+ * @return int The dense ID, or -1 if not assigned.
+ */
+int IdDictionary::find(int externalId) const {
+    return slots[probe(externalId)].denseId;
+}
+
+/**
+ * @brief Converts a dense ID back to its external ID.
+ *
+ * @param denseId The dense ID.
+ * @return int The external ID.
+ */
+int IdDictionary::externalOf(int denseId) const {
+    return externalIds[denseId];
+}
+
+/**
+ * @brief Returns the number of IDs assigned.
+ *
+ * @return int The dictionary size.
+ */
+int IdDictionary::size() const {
+    return count;
+}
+
+/**
+ * @brief Returns the number of slots in the external ID lookup table.
+ *
+ * @return int The slot count.
+ */
+int IdDictionary::getBucketCount() const {
+    return slotMask + 1;
+}
+
+/**
+ * @brief Returns how many times the external ID lookup table has grown.
+ *
+ * @return int The rehash count.
+ */
+int IdDictionary::getRehashCount() const {
+    return rehashCount;
+}
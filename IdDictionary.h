@@ -0,0 +1,130 @@
+#ifndef ID_DICTIONARY_H
+#define ID_DICTIONARY_H
+
+
+/***************************************************************************
+ * IdDictionary.h
+ *
+ * Team:            Gearoid, Cedric
+ * Group:           1
+ * Student IDs:     S10241866, S10241549
+ *
+ * Features Highlight:
+ *   - Maps sparse external IDs (e.g. 418078) to dense internal IDs 0..n-1.
+ *   - Dense IDs are handed out in insertion order and never reused, so they
+ *     can index plain arrays in the tables, the actor graph and the indexes.
+ *   - Reverse lookup (dense -> external) is a single array access.
+ *   - Forward lookup (external -> dense) is a flat open-addressing table of
+ *     IdMapping slots, at most half full, so a lookup is usually one cache
+ *     line instead of a bucket pointer and a chain node. Every load, cast
+ *     link and actor graph build resolves IDs through it.
+ *
+ ***************************************************************************/
+
+ /**
+  * @brief A single external ID -> dense ID pair stored in the lookup table.
+  */
+struct IdMapping {
+    int externalId;  ///< ID as it appears in the CSV files and the UI.
+    int denseId;     ///< Position assigned by the dictionary (-1 marks an empty slot).
+};
+
+/**
+ * @brief Bidirectional dictionary between external IDs and dense internal IDs.
+ */
+class IdDictionary {
+private:
+    IdMapping* slots;             ///< External ID -> dense ID, linear probing.
+    int slotMask;                 ///< Slot count minus one (the slot count is a power of two).
+    int rehashCount;              ///< Times the slot table has grown.
+    int* externalIds;             ///< Dense ID -> external ID.
+    int count;                    ///< Number of IDs assigned so far.
+    int capacity;                 ///< Allocated size of externalIds.
+
+    /**
+     * @brief Returns the slot an external ID's probe sequence starts at.
+     *
+     * @param externalId The external ID.
+     * @return int The home slot.
+     */
+    int homeSlot(int externalId) const;
+
+    /**
+     * @brief Returns the slot holding an external ID, or the empty slot where it would go.
+     *
+     * @param externalId The external ID.
+     * @return int The slot index.
+     */
+    int probe(int externalId) const;
+
+    /**
+     * @brief Doubles the slot table and reinserts every mapping.
+     */
+    void growSlots();
+
+public:
+    /**
+     * @brief Constructs an empty dictionary.
+     *
+     * @param initialCapacity Initial size of the reverse array; the slot table starts at twice this.
+     */
+    explicit IdDictionary(int initialCapacity = 2000);
+
+    /**
+     * @brief Destructor.
+     *
+     * Releases the slot table and the reverse lookup array.
+     */
+    ~IdDictionary();
+
+    // Copying is disabled, matching HashTable.
+    IdDictionary(const IdDictionary&) = delete;
+    IdDictionary& operator=(const IdDictionary&) = delete;
+
+    /**
+     * @brief Returns the dense ID for an external ID, assigning the next one if new.
+     *
+     * @param externalId The external ID.
+     * @return int The dense ID in the range [0, size()).
+     */
+    int assign(int externalId);
+
+    /**
+     * @brief Looks up the dense ID for an external ID without assigning one.
+     *
+     * @param externalId The external ID.
+     * @return int The dense ID, or -1 if the external ID is unknown.
+     */
+    int find(int externalId) const;
+
+    /**
+     * @brief Converts a dense ID back into its external ID.
+     *
+     * @param denseId A dense ID in the range [0, size()).
+     * @return int The external ID.
+     */
+    int externalOf(int denseId) const;
+
+    /**
+     * @brief Returns the number of IDs assigned.
+     *
+     * @return int The number of dense IDs handed out.
+     */
+    int size() const;
+
+    /**
+     * @brief Returns the number of slots in the external ID lookup table.
+     *
+     * @return int The slot count.
+     */
+    int getBucketCount() const;
+
+    /**
+     * @brief Returns how many times the external ID lookup table has grown.
+     *
+     * @return int The rehash count.
+     */
+    int getRehashCount() const;
+};
+
+#endif // ID_DICTIONARY_H
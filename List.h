@@ -103,6 +103,14 @@ public:
      */
     void add(const T& item);
 
+    /**
+     * @brief Adds several items to the end of the list, walking to the tail only once.
+     *
+     * @param items The items to add, in order.
+     * @param count The number of items.
+     */
+    void addAll(const T* items, int count);
+
     /**
      * @brief Removes an item from the list.
      *
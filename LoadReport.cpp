@@ -0,0 +1,558 @@
+/***************************************************************************
+ * LoadReport.cpp
+ *
+ * Team:            Gearoid, Cedric
+ * Group:           1
+ * Student IDs:     S10241866, S10241549
+ *
+ * Features Highlight:
+ *   - Text and JSON forms of a catalogue load report.
+ *   - Thread and process CPU time and peak RSS for Windows and POSIX.
+ *   - Allocation counting through a replacement global operator new.
+ ***************************************************************************/
+
+#include "LoadReport.h"
+#include <atomic>
+#include <iostream>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <new>
+#include <sstream>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <ctime>
+#include <sys/resource.h>
+#endif
+
+// ---------------------------------------------------------------------------
+// Allocation Counter
+// ---------------------------------------------------------------------------
+
+/// Number of calls to the global operator new (the array and nothrow forms call it too).
+static std::atomic<unsigned long long> allocationCalls(0);
+
+ /**
+  * @brief Replacement global operator new that counts each call.
+  *
+  * The replacement applies to the whole program, not only to loads, so it
+  * keeps the standard behaviour: while malloc fails, the installed
+  * new_handler is called to free memory, and std::bad_alloc is thrown once
+  * there is none. The aligned forms (std::align_val_t) are not replaced and
+  * not counted; nothing in the program uses over-aligned types.
+  *
+  * @param size Bytes requested.
+  * @return void* The allocated block.
+  */
+void* operator new(std::size_t size) {
+    allocationCalls.fetch_add(1, std::memory_order_relaxed);
+    if (size == 0) {
+        size = 1;
+    }
+    while (true) {
+        void* block = std::malloc(size);
+        if (block != nullptr) {
+            return block;
+        }
+        std::new_handler handler = std::get_new_handler();
+        if (handler == nullptr) {
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+}
+
+/**
+ * @brief Nothrow form of the replacement operator new; counted through it.
+ *
+ * @param size Bytes requested.
+ * @return void* The allocated block, or nullptr.
+ */
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    try {
+        return operator new(size);
+    }
+    catch (const std::bad_alloc&) {
+        return nullptr;
+    }
+}
+
+/**
+ * @brief Array form of the replacement operator new; counted through it.
+ *
+ * @param size Bytes requested.
+ * @return void* The allocated block.
+ */
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+/**
+ * @brief Nothrow array form of the replacement operator new.
+ *
+ * @param size Bytes requested.
+ * @param tag std::nothrow.
+ * @return void* The allocated block, or nullptr.
+ */
+void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept {
+    return operator new(size, tag);
+}
+
+/**
+ * @brief Replacement global operator delete, matching operator new above.
+ *
+ * @param block The block to free.
+ */
+void operator delete(void* block) noexcept {
+    std::free(block);
+}
+
+/**
+ * @brief Sized form of the replacement operator delete.
+ *
+ * @param block The block to free.
+ */
+void operator delete(void* block, std::size_t) noexcept {
+    std::free(block);
+}
+
+/**
+ * @brief Nothrow form of the replacement operator delete.
+ *
+ * @param block The block to free.
+ */
+void operator delete(void* block, const std::nothrow_t&) noexcept {
+    std::free(block);
+}
+
+/**
+ * @brief Array form of the replacement operator delete.
+ *
+ * @param block The block to free.
+ */
+void operator delete[](void* block) noexcept {
+    std::free(block);
+}
+
+/**
+ * @brief Sized array form of the replacement operator delete.
+ *
+ * @param block The block to free.
+ */
+void operator delete[](void* block, std::size_t) noexcept {
+    std::free(block);
+}
+
+/**
+ * @brief Nothrow array form of the replacement operator delete.
+ *
+ * @param block The block to free.
+ */
+void operator delete[](void* block, const std::nothrow_t&) noexcept {
+    std::free(block);
+}
+
+/**
+ * @brief Returns how many times the global operator new has been called.
+ *
+ * @return unsigned long long The allocation count since startup.
+ */
+unsigned long long allocationCount() {
+    return allocationCalls.load(std::memory_order_relaxed);
+}
+
+// ---------------------------------------------------------------------------
+// Resource Usage
+// ---------------------------------------------------------------------------
+
+#ifdef _WIN32
+/**
+ * @brief Adds the user and kernel times reported by GetThreadTimes/GetProcessTimes.
+ *
+ * @param kernel Kernel time in 100 ns units.
+ * @param user User time in 100 ns units.
+ * @return double The total in milliseconds.
+ */
+static double fileTimesToMillis(const FILETIME& kernel, const FILETIME& user) {
+    ULARGE_INTEGER k;
+    ULARGE_INTEGER u;
+    k.LowPart = kernel.dwLowDateTime;
+    k.HighPart = kernel.dwHighDateTime;
+    u.LowPart = user.dwLowDateTime;
+    u.HighPart = user.dwHighDateTime;
+    return static_cast<double>(k.QuadPart + u.QuadPart) / 10000.0;
+}
+#endif
+
+/**
+ * @brief Returns the CPU time used by the calling thread.
+ *
+ * @return double User plus system time in milliseconds.
+ */
+double threadCpuMillis() {
+#ifdef _WIN32
+    FILETIME created, exited, kernel, user;
+    if (!GetThreadTimes(GetCurrentThread(), &created, &exited, &kernel, &user)) {
+        return 0.0;
+    }
+    return fileTimesToMillis(kernel, user);
+#else
+    timespec ts;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) != 0) {
+        return 0.0;
+    }
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+#endif
+}
+
+/**
+ * @brief Returns the CPU time used by the whole process.
+ *
+ * @return double User plus system time in milliseconds.
+ */
+double processCpuMillis() {
+#ifdef _WIN32
+    FILETIME created, exited, kernel, user;
+    if (!GetProcessTimes(GetCurrentProcess(), &created, &exited, &kernel, &user)) {
+        return 0.0;
+    }
+    return fileTimesToMillis(kernel, user);
+#else
+    rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0.0;
+    }
+    return (usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000.0
+        + (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1000.0;
+#endif
+}
+
+/**
+ * @brief Returns the peak resident set size of the process.
+ *
+ * @return unsigned long long Bytes (0 if unavailable).
+ */
+unsigned long long peakResidentBytes() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return 0;
+    }
+    return counters.PeakWorkingSetSize;
+#else
+    rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+#ifdef __APPLE__
+    return static_cast<unsigned long long>(usage.ru_maxrss);          // Bytes on macOS.
+#else
+    return static_cast<unsigned long long>(usage.ru_maxrss) * 1024;   // Kilobytes on Linux.
+#endif
+#endif
+}
+
+// ---------------------------------------------------------------------------
+// PhaseTimer
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Starts the timer.
+ */
+PhaseTimer::PhaseTimer()
+    : startWall(std::chrono::steady_clock::now()),
+    startCpu(threadCpuMillis())
+{
+}
+
+/**
+ * @brief Restarts the timer.
+ */
+void PhaseTimer::restart() {
+    startWall = std::chrono::steady_clock::now();
+    startCpu = threadCpuMillis();
+}
+
+/**
+ * @brief Stores the time since the timer (re)started.
+ *
+ * @param phase Receives the wall-clock and thread CPU time.
+ */
+void PhaseTimer::stop(PhaseTiming& phase) const {
+    phase.wallMillis = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - startWall).count();
+    phase.cpuMillis = threadCpuMillis() - startCpu;
+}
+
+// ---------------------------------------------------------------------------
+// LoadReport
+// ---------------------------------------------------------------------------
+
+/// Reject reasons as they appear in the text and JSON reports.
+static const char* REJECT_NAMES[REJECT_REASON_COUNT] = {
+    "missing_field", "unknown_actor", "unknown_movie", "duplicate_link", "bad_number"
+};
+
+/**
+ * @brief Constructs an empty report.
+ */
+LoadReport::LoadReport()
+    : actors(),
+    movies(),
+    cast(),
+    actorsParse(),
+    moviesParse(),
+    castTokenize(),
+    actorsMerge(),
+    moviesMerge(),
+    castWait(),
+    castLink(),
+    total(),
+    peakResidentBytes(0),
+    allocations(0),
+    tables(),
+    tableCount(0)
+{
+}
+
+/**
+ * @brief Records the shape of a table.
+ *
+ * @param name The table name (a string literal).
+ * @param size Stored entries.
+ * @param capacity Allocated slots or buckets.
+ * @param resizes Times the table grew.
+ */
+void LoadReport::addTable(const char* name, int size, int capacity, int resizes) {
+    if (tableCount >= MAX_TABLES) {
+        return;
+    }
+    TableStats& table = tables[tableCount++];
+    table.name = name;
+    table.size = size;
+    table.capacity = capacity;
+    table.resizes = resizes;
+}
+
+/**
+ * @brief Counts the rows rejected from a file for any reason.
+ *
+ * @param file The file's statistics.
+ * @return int The rejected row count.
+ */
+int LoadReport::rejectedRows(const FileLoadStats& file) {
+    int rejected = 0;
+    for (int r = 0; r < REJECT_REASON_COUNT; ++r) {
+        rejected += file.rejects[r];
+    }
+    return rejected;
+}
+
+/**
+ * @brief Computes how fast a file was parsed.
+ *
+ * @param file The file's statistics.
+ * @param parse The stage that parsed or tokenized the file.
+ * @return double Bytes per second of wall time (0 if the stage took no measurable time).
+ */
+static double parseBytesPerSecond(const FileLoadStats& file, const PhaseTiming& parse) {
+    return (parse.wallMillis > 0.0) ? static_cast<double>(file.bytes) * 1000.0 / parse.wallMillis : 0.0;
+}
+
+/**
+ * @brief Writes the line for one file.
+ *
+ * @param out The stream.
+ * @param file The file's statistics.
+ * @param wallMillis Time spent parsing and merging the file.
+ * @param parse The stage that parsed or tokenized the file.
+ */
+static void printFile(std::ostream& out, const FileLoadStats& file, double wallMillis,
+    const PhaseTiming& parse) {
+    if (file.filename.empty()) {
+        return;
+    }
+    double rowsPerSecond = (wallMillis > 0.0) ? file.rowsParsed * 1000.0 / wallMillis : 0.0;
+    out << "[Load] " << file.filename << ": " << file.bytes << " bytes, "
+        << file.rowsParsed << " rows, " << file.rowsLoaded << " loaded, "
+        << LoadReport::rejectedRows(file) << " rejected";
+    for (int r = 0; r < REJECT_REASON_COUNT; ++r) {
+        if (file.rejects[r] > 0) {
+            out << " (" << REJECT_NAMES[r] << " " << file.rejects[r] << ")";
+        }
+    }
+    if (file.duplicateIds > 0) {
+        out << ", " << file.duplicateIds << " duplicate IDs replaced";
+    }
+    out << ", " << rowsPerSecond << " rows/s, parsed at "
+        << parseBytesPerSecond(file, parse) / (1024.0 * 1024.0) << " MB/s\n";
+}
+
+/**
+ * @brief Writes the line for one stage.
+ *
+ * @param out The stream.
+ * @param name The stage name.
+ * @param phase The stage timing.
+ */
+static void printPhase(std::ostream& out, const char* name, const PhaseTiming& phase) {
+    out << "[Load] " << std::left << std::setw(14) << name << std::right
+        << std::setw(10) << phase.wallMillis << " ms wall" << std::setw(10)
+        << phase.cpuMillis << " ms cpu\n";
+}
+
+/**
+ * @brief Writes the report as text, one "[Load]" line per item.
+ *
+ * @param out The stream to write to.
+ */
+void LoadReport::print(std::ostream& out) const {
+    std::ios::fmtflags flags = out.flags();
+    std::streamsize precision = out.precision();
+    out << std::fixed << std::setprecision(1);
+
+    out << "[Load] source " << source << "\n";
+    printFile(out, actors, actorsParse.wallMillis + actorsMerge.wallMillis, actorsParse);
+    printFile(out, movies, moviesParse.wallMillis + moviesMerge.wallMillis, moviesParse);
+    printFile(out, cast, castTokenize.wallMillis + castLink.wallMillis, castTokenize);
+    if (source == "csv") {
+        printPhase(out, "parse actors", actorsParse);
+        printPhase(out, "parse movies", moviesParse);
+        printPhase(out, "tokenize cast", castTokenize);
+        printPhase(out, "merge actors", actorsMerge);
+        printPhase(out, "merge movies", moviesMerge);
+        printPhase(out, "cast wait", castWait);
+        printPhase(out, "link cast", castLink);
+    }
+    printPhase(out, "total", total);
+    out << "[Load] peak RSS " << peakResidentBytes / (1024.0 * 1024.0) << " MB, "
+        << allocations << " allocations\n";
+    for (int t = 0; t < tableCount; ++t) {
+        out << "[Load] table " << tables[t].name << ": " << tables[t].size << " entries, capacity "
+            << tables[t].capacity << ", " << tables[t].resizes << " resizes\n";
+    }
+
+    out.flags(flags);
+    out.precision(precision);
+}
+
+/**
+ * @brief Appends a JSON string literal, escaping quotes, backslashes and control characters.
+ *
+ * @param json The JSON text.
+ * @param text The string.
+ */
+static void appendJsonString(std::ostringstream& json, const std::string& text) {
+    json << '"';
+    for (size_t i = 0; i < text.size(); ++i) {
+        unsigned char c = static_cast<unsigned char>(text[i]);
+        if (c == '"' || c == '\\') {
+            json << '\\' << static_cast<char>(c);
+        }
+        else if (c < 0x20) {
+            char escaped[8];
+            std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+            json << escaped;
+        }
+        else {
+            json << static_cast<char>(c);
+        }
+    }
+    json << '"';
+}
+
+/**
+ * @brief Appends the JSON object for one file.
+ *
+ * @param json The JSON text.
+ * @param file The file's statistics.
+ * @param parse The stage that parsed or tokenized the file.
+ */
+static void appendJsonFile(std::ostringstream& json, const FileLoadStats& file, const PhaseTiming& parse) {
+    json << "{\"file\": ";
+    appendJsonString(json, file.filename);
+    json << ", \"bytes\": " << file.bytes << ", \"parse_bytes_per_second\": " << parseBytesPerSecond(file, parse)
+        << ", \"rows_parsed\": " << file.rowsParsed
+        << ", \"rows_loaded\": " << file.rowsLoaded << ", \"duplicate_ids\": " << file.duplicateIds
+        << ", \"rejects\": {";
+    for (int r = 0; r < REJECT_REASON_COUNT; ++r) {
+        json << (r > 0 ? ", " : "") << '"' << REJECT_NAMES[r] << "\": " << file.rejects[r];
+    }
+    json << "}}";
+}
+
+/**
+ * @brief Appends the JSON object for one stage.
+ *
+ * @param json The JSON text.
+ * @param name The stage key.
+ * @param phase The stage timing.
+ * @param last True for the final member of the enclosing object.
+ */
+static void appendJsonPhase(std::ostringstream& json, const char* name, const PhaseTiming& phase, bool last) {
+    json << "    \"" << name << "\": {\"wall_ms\": " << phase.wallMillis
+        << ", \"cpu_ms\": " << phase.cpuMillis << "}" << (last ? "\n" : ",\n");
+}
+
+/**
+ * @brief Formats the report as a JSON object.
+ *
+ * @return std::string The JSON text.
+ */
+std::string LoadReport::toJson() const {
+    std::ostringstream json;
+    json << std::fixed << std::setprecision(3);
+    json << "{\n  \"source\": ";
+    appendJsonString(json, source);
+    json << ",\n  \"files\": {\n    \"actors\": ";
+    appendJsonFile(json, actors, actorsParse);
+    json << ",\n    \"movies\": ";
+    appendJsonFile(json, movies, moviesParse);
+    json << ",\n    \"cast\": ";
+    appendJsonFile(json, cast, castTokenize);
+    json << "\n  },\n  \"phases\": {\n";
+    appendJsonPhase(json, "parse_actors", actorsParse, false);
+    appendJsonPhase(json, "parse_movies", moviesParse, false);
+    appendJsonPhase(json, "tokenize_cast", castTokenize, false);
+    appendJsonPhase(json, "merge_actors", actorsMerge, false);
+    appendJsonPhase(json, "merge_movies", moviesMerge, false);
+    appendJsonPhase(json, "cast_wait", castWait, false);
+    appendJsonPhase(json, "link_cast", castLink, false);
+    appendJsonPhase(json, "total", total, true);
+    json << "  },\n  \"peak_rss_bytes\": " << peakResidentBytes
+        << ",\n  \"allocations\": " << allocations << ",\n  \"tables\": [";
+    for (int t = 0; t < tableCount; ++t) {
+        json << (t > 0 ? ",\n" : "\n") << "    {\"name\": ";
+        appendJsonString(json, tables[t].name);
+        json << ", \"size\": " << tables[t].size << ", \"capacity\": " << tables[t].capacity
+            << ", \"resizes\": " << tables[t].resizes << "}";
+    }
+    json << "\n  ]\n}\n";
+    return json.str();
+}
+
+/**
+ * @brief Writes the JSON form of the report to a file.
+ *
+ * @param path The file to create or overwrite.
+ * @return true on success.
+ */
+bool LoadReport::writeJson(const std::string& path) const {
+    std::ofstream out(path.c_str(), std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        std::cerr << "[Error] Could not write load report to " << path << "\n";
+        return false;
+    }
+    out << toJson();
+    return out.good();
+}
@@ -0,0 +1,202 @@
+#ifndef LOAD_REPORT_H
+#define LOAD_REPORT_H
+
+#include <chrono>
+#include <ostream>
+#include <string>
+
+/***************************************************************************
+ * LoadReport.h
+ *
+ * Team:            Gearoid, Cedric
+ * Group:           1
+ * Student IDs:     S10241866, S10241549
+ *
+ * Features Highlight:
+ *   - What a catalogue load did: bytes and rows per file, how fast each
+ *     file was parsed (bytes per second of its parse stage), rows rejected
+ *     by reason, wall and CPU time per stage, peak RSS, heap allocations
+ *     and the final size, capacity and resize count of each table.
+ *   - Printed as text at startup or written as JSON, so ingest regressions
+ *     show up in a diff.
+ *   - Process-wide counters: CPU time, peak resident set size and the
+ *     number of operator new calls (counted by replacing the global
+ *     operator new in LoadReport.cpp; the plain, array and nothrow forms
+ *     are counted, the aligned forms are not).
+ *
+ ***************************************************************************/
+
+ /**
+  * @brief Reasons a CSV row is not loaded.
+  */
+enum RejectReason {
+    REJECT_MISSING_FIELD = 0,  ///< A required field is empty or absent.
+    REJECT_UNKNOWN_ACTOR = 1,  ///< Cast row names an actor that is not loaded.
+    REJECT_UNKNOWN_MOVIE = 2,  ///< Cast row names a movie that is not loaded.
+    REJECT_DUPLICATE_LINK = 3, ///< Cast row repeats a link that already exists.
+    REJECT_BAD_NUMBER = 4,     ///< An ID or year is not a whole number in int range.
+    REJECT_REASON_COUNT = 5
+};
+
+/**
+ * @brief Rows and bytes read from one CSV file.
+ */
+struct FileLoadStats {
+    std::string filename;            ///< The file (empty if not read).
+    unsigned long long bytes;        ///< Bytes read, header included on a full load.
+    int rowsParsed;                  ///< Non-empty rows found.
+    int rowsLoaded;                  ///< Rows inserted or linked.
+    int duplicateIds;                ///< Loaded rows that replaced an earlier row with the same ID.
+    int rejects[REJECT_REASON_COUNT];  ///< Rows not loaded, by reason.
+};
+
+/**
+ * @brief Wall-clock and CPU time of one load stage, in milliseconds.
+ *
+ * The CPU time of a parse stage is summed over its worker threads, so it
+ * can exceed the wall time.
+ */
+struct PhaseTiming {
+    double wallMillis;  ///< Elapsed time.
+    double cpuMillis;   ///< CPU time of the threads doing the stage.
+};
+
+/**
+ * @brief Final shape of one table after the load.
+ */
+struct TableStats {
+    const char* name;  ///< Table name.
+    int size;          ///< Stored entries.
+    int capacity;      ///< Allocated slots or buckets.
+    int resizes;       ///< Times the table grew (rehashes for hash tables).
+};
+
+/**
+ * @brief Everything measured during one catalogue load.
+ */
+class LoadReport {
+public:
+    static const int MAX_TABLES = 8;  ///< Tables a report can describe.
+
+    std::string source;        ///< "csv" or "snapshot".
+    FileLoadStats actors;      ///< actors.csv.
+    FileLoadStats movies;      ///< movies.csv.
+    FileLoadStats cast;        ///< cast.csv.
+
+    PhaseTiming actorsParse;   ///< Parsing actors.csv.
+    PhaseTiming moviesParse;   ///< Parsing movies.csv (concurrent with the actor stages).
+    PhaseTiming castTokenize;  ///< Tokenizing cast.csv (concurrent with the actor and movie stages).
+    PhaseTiming actorsMerge;   ///< Inserting actors into the table.
+    PhaseTiming moviesMerge;   ///< Inserting movies into the table.
+    PhaseTiming castWait;      ///< Waiting for the cast tokenizer after both tables were sealed.
+    PhaseTiming castLink;      ///< Linking the cast pairs.
+    PhaseTiming total;         ///< The whole load; CPU time is the whole process's.
+
+    unsigned long long peakResidentBytes;  ///< Peak resident set size of the process so far.
+    unsigned long long allocations;        ///< operator new calls during the load.
+
+    TableStats tables[MAX_TABLES];  ///< Table sizes after the load.
+    int tableCount;                 ///< Number of entries in tables.
+
+    /**
+     * @brief Constructs an empty report.
+     */
+    LoadReport();
+
+    /**
+     * @brief Records the shape of a table.
+     *
+     * @param name The table name (a string literal).
+     * @param size Stored entries.
+     * @param capacity Allocated slots or buckets.
+     * @param resizes Times the table grew.
+     */
+    void addTable(const char* name, int size, int capacity, int resizes);
+
+    /**
+     * @brief Counts the rows rejected from a file for any reason.
+     *
+     * @param file The file's statistics.
+     * @return int The rejected row count.
+     */
+    static int rejectedRows(const FileLoadStats& file);
+
+    /**
+     * @brief Writes the report as text, one "[Load]" line per item.
+     *
+     * @param out The stream to write to.
+     */
+    void print(std::ostream& out) const;
+
+    /**
+     * @brief Formats the report as a JSON object.
+     *
+     * @return std::string The JSON text.
+     */
+    std::string toJson() const;
+
+    /**
+     * @brief Writes the JSON form of the report to a file.
+     *
+     * @param path The file to create or overwrite.
+     * @return true on success.
+     */
+    bool writeJson(const std::string& path) const;
+};
+
+/**
+ * @brief Measures the wall-clock and CPU time of a stage on the calling thread.
+ */
+class PhaseTimer {
+private:
+    std::chrono::steady_clock::time_point startWall;  ///< When the timer started.
+    double startCpu;                                  ///< Thread CPU time when the timer started.
+
+public:
+    /**
+     * @brief Starts the timer.
+     */
+    PhaseTimer();
+
+    /**
+     * @brief Restarts the timer.
+     */
+    void restart();
+
+    /**
+     * @brief Stores the time since the timer (re)started.
+     *
+     * @param phase Receives the wall-clock and thread CPU time.
+     */
+    void stop(PhaseTiming& phase) const;
+};
+
+/**
+ * @brief Returns the CPU time used by the calling thread.
+ *
+ * @return double User plus system time in milliseconds.
+ */
+double threadCpuMillis();
+
+/**
+ * @brief Returns the CPU time used by the whole process.
+ *
+ * @return double User plus system time in milliseconds.
+ */
+double processCpuMillis();
+
+/**
+ * @brief Returns the peak resident set size of the process.
+ *
+ * @return unsigned long long Bytes (0 if unavailable).
+ */
+unsigned long long peakResidentBytes();
+
+/**
+ * @brief Returns how many times the global operator new has been called.
+ *
+ * @return unsigned long long The allocation count since startup.
+ */
+unsigned long long allocationCount();
+
+#endif // LOAD_REPORT_H
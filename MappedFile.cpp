@@ -0,0 +1,166 @@
+/***************************************************************************
+ * MappedFile.cpp
+ *
+ * Team:            Gearoid, Cedric
+ * Group:           1
+ * Student IDs:     S10241866, S10241549
+ *
+ * Features Highlight:
+ *   - Read-only file mapping for Windows and POSIX.
+ ***************************************************************************/
+
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+ /**
+  * @brief Constructs a closed mapping.
+  */
+MappedFile::MappedFile()
+    : base(nullptr),
+    length(0),
+    opened(false),
+#ifdef _WIN32
+    fileHandle(nullptr),
+    mappingHandle(nullptr)
+#else
+    fd(-1)
+#endif
+{
+}
+
+/**
+ * @brief Destructor.
+ */
+MappedFile::~MappedFile() {
+    close();
+}
+
+/**
+ * @brief Maps a file read-only.
+ *
+ * @param filename Path of the file.
+ * @return bool True if the file was opened and mapped.
+ */
+bool MappedFile::open(const std::string& filename) {
+    close();
+#ifdef _WIN32
+    HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+        OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize)) {
+        CloseHandle(file);
+        return false;
+    }
+    fileHandle = file;
+    length = static_cast<size_t>(fileSize.QuadPart);
+    if (length > 0) {
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping == nullptr) {
+            close();
+            return false;
+        }
+        mappingHandle = mapping;
+        base = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        if (base == nullptr) {
+            close();
+            return false;
+        }
+    }
+#else
+    fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close();
+        return false;
+    }
+    length = static_cast<size_t>(st.st_size);
+    if (length > 0) {
+        void* p = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p == MAP_FAILED) {
+            close();
+            return false;
+        }
+        madvise(p, length, MADV_SEQUENTIAL);
+        base = static_cast<const char*>(p);
+    }
+#endif
+    opened = true;
+    return true;
+}
+
+/**
+ * @brief Releases the mapping and the file handles.
+ */
+void MappedFile::close() {
+#ifdef _WIN32
+    if (base) {
+        UnmapViewOfFile(base);
+    }
+    if (mappingHandle) {
+        CloseHandle(static_cast<HANDLE>(mappingHandle));
+        mappingHandle = nullptr;
+    }
+    if (fileHandle) {
+        CloseHandle(static_cast<HANDLE>(fileHandle));
+        fileHandle = nullptr;
+    }
+#else
+    if (base) {
+        munmap(const_cast<char*>(base), length);
+    }
+    if (fd >= 0) {
+        ::close(fd);
+        fd = -1;
+    }
+#endif
+    base = nullptr;
+    length = 0;
+    opened = false;
+}
+
+/**
+ * @brief Checks whether a file is mapped.
+ *
+ * @return bool True if open.
+ */
+bool MappedFile::isOpen() const {
+    return opened;
+}
+
+/**
+ * @brief Returns the mapped bytes.
+ *
+ * @return const char* The first byte of the file.
+ */
+const char* MappedFile::data() const {
+    return base;
+}
+
+/**
+ * @brief Returns the file size.
+ *
+ * @return size_t The number of mapped bytes.
+ */
+size_t MappedFile::size() const {
+    return length;
+}
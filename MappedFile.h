@@ -0,0 +1,93 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+
+/***************************************************************************
+ * MappedFile.h
+ *
+ * Team:            Gearoid, Cedric
+ * Group:           1
+ * Student IDs:     S10241866, S10241549
+ *
+ * Features Highlight:
+ *   - Maps a whole file read-only into memory so loaders can parse it in
+ *     place, without copying lines into std::string buffers.
+ *   - Uses CreateFileMapping/MapViewOfFile on Windows and mmap elsewhere.
+ *
+ ***************************************************************************/
+
+ /**
+  * @brief A read-only memory mapping of a file.
+  *
+  * The mapping is released by close() or the destructor. An empty file opens
+  * successfully with size() == 0 and data() == nullptr.
+  */
+class MappedFile {
+private:
+    const char* base;     ///< First byte of the mapping (nullptr if empty or closed).
+    size_t length;        ///< Size of the file in bytes.
+    bool opened;          ///< True while a file is open.
+#ifdef _WIN32
+    void* fileHandle;     ///< Win32 file handle.
+    void* mappingHandle;  ///< Win32 file mapping handle.
+#else
+    int fd;               ///< POSIX file descriptor.
+#endif
+
+public:
+    /**
+     * @brief Constructs a closed mapping.
+     */
+    MappedFile();
+
+    /**
+     * @brief Destructor.
+     *
+     * Unmaps the file if it is still open.
+     */
+    ~MappedFile();
+
+    // Copy constructor and assignment operator are disabled for simplicity.
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * @brief Maps a file into memory.
+     *
+     * Any file already open is closed first.
+     *
+     * @param filename Path of the file.
+     * @return bool True on success.
+     */
+    bool open(const std::string& filename);
+
+    /**
+     * @brief Unmaps the file and closes its handles.
+     */
+    void close();
+
+    /**
+     * @brief Checks whether a file is mapped.
+     *
+     * @return bool True if open() succeeded and close() has not been called.
+     */
+    bool isOpen() const;
+
+    /**
+     * @brief Returns the mapped bytes.
+     *
+     * @return const char* Pointer to the first byte (not null-terminated).
+     */
+    const char* data() const;
+
+    /**
+     * @brief Returns the size of the mapped file.
+     *
+     * @return size_t The file size in bytes.
+     */
+    size_t size() const;
+};
+
+#endif // MAPPED_FILE_H
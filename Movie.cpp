@@ -6,13 +6,14 @@
  * Student IDs:     S10241866, S10241549
  *
  * Features Highlight:
- *   - Safe string copy using strncpy_s.
+ *   - Title stored as a handle into the shared StringArena.
+ *   - Plot stored as a reference into the cold, lazily loaded PlotStore.
  *   - Copy constructor and copy assignment operator implemented.
  *   - Actor list management and duplicate prevention.
  ***************************************************************************/
 
 #include "Movie.h"
-#include <cstring> // for strncpy_s
+#include <cstring> // for strcmp
 #include <iostream> // for std::cout, std::cerr
 
  /**
@@ -20,13 +21,16 @@
   *
   * Initializes a Movie object with default values:
   * - id = 0, releaseYear = 0, rating = 0.
-  * - title and plot are set to empty strings.
+  * - title, its collation key and plot are set to empty strings.
   */
 Movie::Movie()
-    : id(0), releaseYear(0), rating(0)
+    : id(0),
+    title(StringArena::shared().intern("")),
+    titleKey(title),
+    plotRef(0),
+    releaseYear(0),
+    rating(0)
 {
-    title[0] = '\0';
-    plot[0] = '\0';
 }
 
 /**
@@ -53,43 +57,58 @@ bool Movie::operator==(const Movie& other) const {
  * @param mid The movie ID.
  */
 Movie::Movie(const char* ttl, const char* plt, int rYear, int mid)
-    : id(mid), releaseYear(rYear), rating(0)
+    : id(mid),
+    title(StringArena::shared().intern(ttl)),
+    titleKey(makeCollationKey(ttl)),
+    plotRef(PlotStore::shared().addText(plt)),
+    releaseYear(rYear),
+    rating(0)
+{
+}
+
+/**
+ * @brief Constructs a Movie from pre-interned title handles and a plot reference.
+ *
+ * @param ttl Handle to the title in the shared StringArena.
+ * @param key Handle to the title's collation key.
+ * @param plot Reference to the plot in the shared PlotStore.
+ * @param rYear The release year of the movie.
+ * @param mid The movie ID.
+ */
+Movie::Movie(StringHandle ttl, StringHandle key, int plot, int rYear, int mid)
+    : id(mid),
+    title(ttl),
+    titleKey(key),
+    plotRef(plot),
+    releaseYear(rYear),
+    rating(0)
 {
-    if (ttl) {
-        strncpy_s(title, sizeof(title), ttl, _TRUNCATE);
-    }
-    else {
-        title[0] = '\0';
-    }
-    if (plt) {
-        strncpy_s(plot, sizeof(plot), plt, _TRUNCATE);
-    }
-    else {
-        plot[0] = '\0';
-    }
 }
 
 /**
  * @brief Copy constructor for Movie.
  *
- * Creates a deep copy of another Movie object.
+ * Copies another Movie object. The title handles and plot reference are
+ * shared; the cast list is deep-copied.
  *
  * @param other The Movie object to copy.
  */
 Movie::Movie(const Movie& other)
     : id(other.id),
+    title(other.title),
+    titleKey(other.titleKey),
+    plotRef(other.plotRef),
     releaseYear(other.releaseYear),
     actors(other.actors),
     rating(other.rating)
 {
-    strncpy_s(title, sizeof(title), other.title, _TRUNCATE);
-    strncpy_s(plot, sizeof(plot), other.plot, _TRUNCATE);
 }
 
 /**
  * @brief Copy assignment operator for Movie.
  *
- * Performs a deep copy of the other Movie object while avoiding self-assignment.
+ * Copies the other Movie object while avoiding self-assignment. The title
+ * handles and plot reference are shared; the cast list is deep-copied.
  *
  * @param other The Movie object to copy.
  * @return A reference to the current Movie object.
@@ -100,8 +119,9 @@ Movie& Movie::operator=(const Movie& other) {
         releaseYear = other.releaseYear;
         actors = other.actors;
         rating = other.rating; // copy rating
-        strncpy_s(title, sizeof(title), other.title, _TRUNCATE);
-        strncpy_s(plot, sizeof(plot), other.plot, _TRUNCATE);
+        title = other.title;
+        titleKey = other.titleKey;
+        plotRef = other.plotRef;
     }
     return *this;
 }
@@ -130,41 +150,80 @@ void Movie::setId(int newId) {
  * @return A constant character pointer to the movie title.
  */
 const char* Movie::getTitle() const {
+    return StringArena::shared().resolve(title);
+}
+
+/**
+ * @brief Gets the handle of the movie title.
+ *
+ * @return The title handle in the shared StringArena.
+ */
+StringHandle Movie::getTitleHandle() const {
     return title;
 }
 
+/**
+ * @brief Gets the collation key of the movie title.
+ *
+ * @return The case-folded key handle.
+ */
+StringHandle Movie::getTitleKey() const {
+    return titleKey;
+}
+
 /**
  * @brief Sets the movie title.
  *
- * Uses safe string copy to update the title.
+ * Interns the new title in the shared StringArena and rebuilds its collation key.
  *
  * @param newTitle The new title for the movie.
  */
 void Movie::setTitle(const char* newTitle) {
     if (newTitle) {
-        strncpy_s(title, sizeof(title), newTitle, _TRUNCATE);
+        title = StringArena::shared().intern(newTitle);
+        titleKey = makeCollationKey(newTitle);
     }
 }
 
 /**
  * @brief Gets the movie plot.
  *
+ * Reads the plot from the PlotStore, loading it from disk on first use.
+ *
  * @return A constant character pointer to the movie plot.
  */
 const char* Movie::getPlot() const {
-    return plot;
+    return PlotStore::shared().get(plotRef);
+}
+
+/**
+ * @brief Gets the movie's plot reference.
+ *
+ * @return The plot reference in the shared PlotStore.
+ */
+int Movie::getPlotRef() const {
+    return plotRef;
+}
+
+/**
+ * @brief Sets the movie's plot reference.
+ *
+ * @param ref An existing PlotStore reference.
+ */
+void Movie::setPlotRef(int ref) {
+    plotRef = ref;
 }
 
 /**
  * @brief Sets the movie plot.
  *
- * Uses safe string copy to update the plot.
+ * Stores the new plot in the cold PlotStore.
  *
  * @param newPlot The new plot for the movie.
  */
 void Movie::setPlot(const char* newPlot) {
     if (newPlot) {
-        strncpy_s(plot, sizeof(plot), newPlot, _TRUNCATE);
+        plotRef = PlotStore::shared().addText(newPlot);
     }
 }
 
@@ -280,8 +339,8 @@ const List<Actor>& Movie::getActors() const {
  */
 void Movie::displayDetails() const {
     std::cout << "Movie ID: " << id
-        << ", Title: " << title
-        << ", Plot: " << plot
+        << ", Title: " << getTitle()
+        << ", Plot: " << getPlot()
         << ", Year: " << releaseYear
         << ", Rating: " << rating
         << std::endl;
@@ -3,6 +3,9 @@
 
 #include "Actor.h"
 #include "List.h"
+#include "StringArena.h"
+#include "PlotStore.h"
+#include "Collation.h"
 #include <iostream>
 #include <cstring>
 
@@ -16,6 +19,11 @@
  * Features Highlight:
  *   - Represents a movie with a unique identifier, title, plot description,
  *     release year, rating, and a list of actors.
+ *   - The title is interned in the shared StringArena; the plot lives in the
+ *     cold PlotStore and is only read when displayed or edited. A movie
+ *     record carries an 8-byte title handle and a 4-byte plot reference.
+ *   - Keeps a case-folded collation key for its title, rebuilt whenever the
+ *     title changes.
  *   - Provides operations to manage movie details, including adding actors,
  *     updating information, and displaying details.
  *
@@ -27,8 +35,9 @@
 class Movie {
 private:
     int id;                  ///< Unique movie identifier.
-    char title[100];         ///< Title of the movie.
-    char plot[500];          ///< Short description of the movie's plot.
+    StringHandle title;      ///< Handle to the title of the movie.
+    StringHandle titleKey;   ///< Case-folded collation key of the title.
+    int plotRef;             ///< Reference to the plot in the shared PlotStore.
     int releaseYear;         ///< Year the movie was released.
     List<Actor> actors;      ///< List of actors in the movie.
     int rating;              ///< Movie rating (0 to 10).
@@ -67,10 +76,24 @@ public:
      */
     Movie(const char* ttl, const char* plt, int rYear, int mid);
 
+    /**
+     * @brief Constructs a Movie from text that is already stored.
+     *
+     * Used by the bulk loaders, which intern titles and register plots themselves.
+     *
+     * @param ttl Handle to the title.
+     * @param key Handle to the title's collation key.
+     * @param plot PlotStore reference of the plot.
+     * @param rYear The release year of the movie.
+     * @param mid The unique movie identifier.
+     */
+    Movie(StringHandle ttl, StringHandle key, int plot, int rYear, int mid);
+
     /**
      * @brief Copy constructor.
      *
-     * Creates a deep copy of another movie.
+     * Copies another movie; title handle and plot reference are shared, the
+     * cast list is deep-copied.
      *
      * @param other The movie to copy.
      */
@@ -118,6 +141,20 @@ public:
      */
     const char* getTitle() const;
 
+    /**
+     * @brief Retrieves the handle of the movie's title in the shared StringArena.
+     *
+     * @return The title handle.
+     */
+    StringHandle getTitleHandle() const;
+
+    /**
+     * @brief Retrieves the case-folded collation key of the movie's title.
+     *
+     * @return The key handle (see Collation.h).
+     */
+    StringHandle getTitleKey() const;
+
     /**
      * @brief Updates the movie's title.
      *
@@ -128,10 +165,28 @@ public:
     /**
      * @brief Retrieves the movie's plot.
      *
+     * The text is fetched from the PlotStore, which may read it from disk.
+     *
      * @return A constant pointer to the movie's plot description.
      */
     const char* getPlot() const;
 
+    /**
+     * @brief Retrieves the movie's plot reference in the shared PlotStore.
+     *
+     * @return The plot reference (0 for an empty plot).
+     */
+    int getPlotRef() const;
+
+    /**
+     * @brief Points the movie at an existing PlotStore entry.
+     *
+     * Used by loaders that register plots lazily.
+     *
+     * @param ref The plot reference.
+     */
+    void setPlotRef(int ref);
+
     /**
      * @brief Updates the movie's plot.
      *
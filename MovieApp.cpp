@@ -7,51 +7,45 @@
  *
  * Features Highlight:
  *   - CSV reading and parsing for actors, movies, and casts.
+ *   - Bulk cast linking: pairs counting-sorted by movie, casts built per run.
  *   - Case-insensitive string comparisons and trimming utilities.
- *   - Dynamic arrays and merge sort for movies and actors.
+ *   - Merge sort of dense IDs over the actor and movie columns.
  *   - Administrative and user operations including ratings and recommendations.
+ *   - Image mode: queries served from a mapped CatalogImage plus an overlay.
+ *   - Admin changes logged to a MutationLog, replayed and checkpointed.
+ *   - Tail mode: rows appended to the CSV files are ingested incrementally.
+ *   - Load report: rows and rejects per file, stage timings, table sizes.
  ***************************************************************************/
 
 #include "MovieApp.h"
-#include "ActorGraph.h"            // If you still use ActorGraph utilities
+#include "PlotStore.h"
+#include "Collation.h"
+#include "ChunkedCsv.h"
+#include "MappedFile.h"
+#include "Snapshot.h"
+#include "CatalogImage.h"
+#include "MutationLog.h"
+#include "DurableFile.h"
+#include <chrono>
+#include <filesystem>
 #include <iostream>
 #include <fstream>
 #include <sstream>
+#include <iomanip>
 #include <cstring>
+#include <cstdio>      // For std::rename/std::remove
 #include <cstdlib>     // For atoi
 #include <ctime>       // For date-based logic (e.g., recent movies)
 #include <cassert>     // For debugging purposes
 #include <limits>      // For std::numeric_limits
+#include <thread>
 
  // ---------------------------------------------------------------------------
  // Helper Functions
  // ---------------------------------------------------------------------------
 
- /**
-  * @brief Case-insensitive comparison of two C-strings.
-  *
-  * Compares characters in a case-insensitive manner until a difference is found
-  * or both strings terminate.
-  *
-  * @param s1 First C-string.
-  * @param s2 Second C-string.
-  * @return Negative if s1 < s2, positive if s1 > s2, zero if equal.
-  */
-static int caseInsensitiveCompareStrings(const char* s1, const char* s2) {
-    while (*s1 && *s2) {
-        unsigned char c1 = static_cast<unsigned char>(std::tolower(*s1));
-        unsigned char c2 = static_cast<unsigned char>(std::tolower(*s2));
-        if (c1 < c2) return -1;
-        if (c1 > c2) return 1;
-        ++s1;
-        ++s2;
-    }
-    unsigned char c1 = static_cast<unsigned char>(std::tolower(*s1));
-    unsigned char c2 = static_cast<unsigned char>(std::tolower(*s2));
-    if (c1 < c2) return -1;
-    if (c1 > c2) return 1;
-    return 0;
-}
+// Log size at which admin changes are folded into the snapshot.
+static const uint64_t LOG_CHECKPOINT_BYTES = 1 << 20;
 
 /**
  * @brief Trims leading/trailing quotes and spaces from a string.
@@ -83,6 +77,39 @@ static std::string trim(const std::string& str) {
     return str.substr(start, end - start + 1);
 }
 
+/**
+ * @brief Builds an Actor from a catalogue image record.
+ *
+ * @param image The open image.
+ * @param rec The actor record.
+ * @return Actor The actor, with its text interned in the shared StringArena.
+ */
+static Actor actorFromImage(const CatalogImage& image, const ImageActor& rec) {
+    StringArena& arena = StringArena::shared();
+    Actor actor(arena.intern(image.textOf(rec.name)), arena.intern(image.textOf(rec.key)),
+        rec.birthYear, rec.id);
+    actor.setRating(rec.rating);
+    return actor;
+}
+
+/**
+ * @brief Builds a Movie from a catalogue image record.
+ *
+ * The plot is copied into the PlotStore, since the record is about to be
+ * changed independently of the image.
+ *
+ * @param image The open image.
+ * @param rec The movie record.
+ * @return Movie The movie, without its cast.
+ */
+static Movie movieFromImage(const CatalogImage& image, const ImageMovie& rec) {
+    StringArena& arena = StringArena::shared();
+    Movie movie(arena.intern(image.textOf(rec.title)), arena.intern(image.textOf(rec.key)),
+        PlotStore::shared().addText(image.textOf(rec.plot)), rec.releaseYear, rec.id);
+    movie.setRating(rec.rating);
+    return movie;
+}
+
 // ---------------------------------------------------------------------------
 // MovieApp Constructor and Admin Mode Methods
 // ---------------------------------------------------------------------------
@@ -90,16 +117,30 @@ static std::string trim(const std::string& str) {
 /**
  * @brief Constructs a new MovieApp instance.
  *
- * Initializes the actor and movie hash tables with capacity 2000, sets the
- * next available IDs, and defaults to user mode.
+ * Initializes the actor and movie tables and the filmography index with
+ * capacity 2000, sets the next available IDs, and defaults to user mode.
  */
 MovieApp::MovieApp()
     : actorTable(2000),
     movieTable(2000),
+    filmographies(new Filmography[2000]),
+    filmographyCapacity(2000),
+    actorGraphReady(false),
     nextActorId(1000),
     nextMovieId(5000),
-    isAdmin(false)
+    isAdmin(false),
+    logSequence(0)
 {
+    actorsFeed.offset = 0;
+    moviesFeed.offset = 0;
+    castFeed.offset = 0;
+}
+
+/**
+ * @brief Destroys the MovieApp instance.
+ */
+MovieApp::~MovieApp() {
+    delete[] filmographies;
 }
 
 /**
@@ -126,322 +167,1305 @@ bool MovieApp::isAdminMode() const {
     return isAdmin;
 }
 
-// ---------------------------------------------------------------------------
-// CSV Reading Methods
-// ---------------------------------------------------------------------------
+/**
+ * @brief Returns the filmography of an actor, growing the index if needed.
+ *
+ * The index is a plain array indexed by dense actor ID; it doubles in size
+ * whenever an actor beyond its current capacity is referenced.
+ *
+ * @param actorDenseId The actor's dense ID.
+ * @return Filmography& The actor's filmography.
+ */
+Filmography& MovieApp::filmographyOf(int actorDenseId) {
+    if (actorDenseId >= filmographyCapacity) {
+        int newCapacity = filmographyCapacity * 2;
+        while (actorDenseId >= newCapacity) {
+            newCapacity *= 2;
+        }
+        Filmography* newArr = new Filmography[newCapacity];
+        for (int i = 0; i < filmographyCapacity; ++i) {
+            newArr[i] = filmographies[i];
+        }
+        delete[] filmographies;
+        filmographies = newArr;
+        filmographyCapacity = newCapacity;
+    }
+    return filmographies[actorDenseId];
+}
 
 /**
- * @brief Reads actor data from a CSV file.
+ * @brief Links an actor to a movie and keeps the filmography index and the
+ *        actor graph in sync.
  *
- * Parses each row to extract actor ID, name, and birth year, then creates
- * Actor objects and inserts them into the actor hash table.
+ * The actor is only added to the movie's cast (and the movie to the actor's
+ * filmography) if they are not already linked. Once the actor graph has been
+ * built, the actor also gains an edge to every existing cast member.
  *
- * @param filename The path to the CSV file.
+ * @param actorDenseId The dense ID of the actor to add.
+ * @param movieDenseId The dense ID of the movie to add the actor to.
+ * @return true if a new link was created; false if it already existed.
  */
-void MovieApp::readActors(const std::string& filename) {
-    std::ifstream fin(filename.c_str());
-    if (!fin.is_open()) {
-        std::cerr << "[Error] Could not open file: " << filename << "\n";
-        return;
+bool MovieApp::linkActorToMovie(int actorDenseId, int movieDenseId) {
+    if (isCastMember(actorDenseId, movieDenseId)) {
+        return false;
     }
+    Movie& movie = movieTable.at(movieDenseId);
+    if (actorGraphReady) {
+        movie.getActors().forEach([&](const Actor& castActor) -> bool {
+            actorGraph.addEdge(actorDenseId, actorTable.indexOf(castActor.getId()), movie.getReleaseYear());
+            return false;
+            });
+    }
+    movie.addActor(actorTable.at(actorDenseId));
+    // isCastMember() above already ruled out a duplicate.
+    filmographyOf(actorDenseId).append(movieDenseId);
+    return true;
+}
 
-    std::string header;
-    if (!std::getline(fin, header)) {
-        std::cerr << "[Error] File is empty: " << filename << "\n";
-        fin.close();
+/**
+ * @brief Copies an actor's name and birth year into every cast it is in.
+ *
+ * Casts hold copies of Actor records, so they must be refreshed when the
+ * record in the actor table changes. The filmography lists exactly the
+ * movies to visit.
+ *
+ * @param actorDenseId The actor's dense ID.
+ */
+void MovieApp::refreshCastCopies(int actorDenseId) {
+    if (actorDenseId >= filmographyCapacity) {
         return;
     }
+    const Actor& actor = actorTable.at(actorDenseId);
+    const Filmography& films = filmographies[actorDenseId];
+    for (int i = 0; i < films.getCount(); ++i) {
+        Movie& movie = movieTable.at(films.getMovieIdAt(i));
+        movie.getActors().forEach([&](const Actor& castActor) -> bool {
+            if (castActor.getId() == actor.getId()) {
+                Actor& mutableActor = const_cast<Actor&>(castActor);
+                mutableActor.setName(actor.getName());
+                mutableActor.setBirthYear(actor.getBirthYear());
+                return true; // Each actor appears at most once per cast.
+            }
+            return false; // Continue iteration.
+            });
+    }
+}
 
-    std::string line;
-    while (std::getline(fin, line)) {
-        if (line.empty()) continue;
-
-        std::stringstream ss(line);
-        std::string idStr, nameStr, birthStr;
-        std::getline(ss, idStr, ',');
-        std::getline(ss, nameStr, ',');
-        std::getline(ss, birthStr, ',');
+/**
+ * @brief Checks whether an actor is in a movie's cast.
+ *
+ * @param actorDenseId The dense ID of the actor.
+ * @param movieDenseId The dense ID of the movie.
+ * @return true if the overlay or the image links them.
+ */
+bool MovieApp::isCastMember(int actorDenseId, int movieDenseId) const {
+    int actorId = actorTable.at(actorDenseId).getId();
+    const Movie& movie = movieTable.at(movieDenseId);
+    if (movie.hasActor(actorId)) {
+        return true;
+    }
+    return image.isOpen() && imageHasLink(actorId, movie.getId());
+}
 
-        // Skip malformed rows.
-        if (idStr.empty() || nameStr.empty() || birthStr.empty()) {
-            continue;
-        }
+// ---------------------------------------------------------------------------
+// CSV Reading Methods
+// ---------------------------------------------------------------------------
 
-        int id = std::atoi(idStr.c_str());
-        int birth = std::atoi(birthStr.c_str());
-        nameStr = trimQuotes(nameStr);
+/**
+ * @brief Returns the milliseconds elapsed since a point in time.
+ *
+ * @param start The starting point.
+ * @return double Elapsed wall-clock time in milliseconds.
+ */
+static double millisSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
 
-        Actor actor(nameStr.c_str(), birth, id);
-        actorTable.insert(actor);
-        if (id >= nextActorId) {
-            nextActorId = id + 1;
-        }
+/**
+ * @brief Reads actor data from a CSV file.
+ *
+ * Maps the file and splits it into line-aligned chunks that are parsed in
+ * parallel into per-thread staging buffers (ID, birth year, name position and
+ * folded name key). The buffers are then merged into the actor table in chunk
+ * order on this thread, so a duplicate ID ends up with the values from its
+ * last row in the file, exactly as with a sequential read.
+ *
+ * @param filename The path to the CSV file.
+ */
+void MovieApp::readActors(const std::string& filename) {
+    CsvStage<StagedActorRow> stage;
+    if (!stage.open(filename)) {
+        return;
     }
-    fin.close();
+    stage.parseAll();
+    FileLoadStats stats = FileLoadStats();
+    mergeActors(stage, stats);
 }
 
 /**
  * @brief Reads movie data from a CSV file.
  *
- * Parses each row to extract movie ID, title, plot, and release year,
- * creates Movie objects, and inserts them into the movie hash table.
+ * Uses the same parallel parse / ordered merge scheme as readActors(). Fields
+ * are tokenized per RFC 4180, so quoted titles may contain commas. Rows
+ * with a missing field or a bad number are staged as malformed and reported
+ * during the merge, so warnings still appear in file order. Plots are not
+ * copied into memory: only their byte range in the file is recorded in the
+ * PlotStore, which reads the text the first time a plot is displayed.
  *
  * @param filename The path to the CSV file.
  */
 void MovieApp::readMovies(const std::string& filename) {
-    std::ifstream fin(filename.c_str());
-    if (!fin.is_open()) {
-        std::cerr << "[Error] Could not open file: " << filename << "\n";
+    CsvStage<StagedMovieRow> stage;
+    if (!stage.open(filename)) {
         return;
     }
+    stage.parseAll();
+    FileLoadStats stats = FileLoadStats();
+    mergeMovies(stage, filename, stats);
+}
 
-    std::string header;
-    if (!std::getline(fin, header)) {
-        std::cerr << "[Error] File is empty: " << filename << "\n";
-        fin.close();
+/**
+ * @brief Reads cast data from a CSV file.
+ *
+ * The file is tokenized into (actor ID, movie ID) pairs in parallel chunks,
+ * then the pairs are linked in file order on this thread.
+ *
+ * @param filename The path to the CSV file.
+ */
+void MovieApp::readCast(const std::string& filename) {
+    CsvStage<StagedCastRow> stage;
+    if (!stage.open(filename)) {
         return;
     }
+    stage.parseAll();
+    FileLoadStats stats = FileLoadStats();
+    linkCast(stage, stats);
+}
 
-    std::string line;
-    while (std::getline(fin, line)) {
-        if (line.empty()) continue;
+/**
+ * @brief Loads the three CSV files as a pipeline.
+ *
+ * Stage dependencies:
+ *   parse actors  -> merge actors  --+
+ *   parse movies  -> merge movies  --+--> link cast
+ *   tokenize cast -------------------+
+ * The three parses run at the same time (movies and cast on threads of their
+ * own). Merges stay on this thread because they intern text into the shared
+ * StringArena; the actor merge overlaps the other two parses. Linking starts
+ * once both tables are sealed and the cast pairs are ready.
+ *
+ * @param actorsFile The actors CSV file.
+ * @param moviesFile The movies CSV file.
+ * @param castFile The cast CSV file.
+ * @param report Receives per-file row counts, stage timings and table sizes.
+ */
+void MovieApp::loadCsvFiles(const std::string& actorsFile, const std::string& moviesFile,
+    const std::string& castFile, LoadReport& report) {
+    PhaseTimer whole;
+    double startCpu = processCpuMillis();
+    unsigned long long startAllocations = allocationCount();
+    report = LoadReport();
+    report.source = "csv";
 
-        std::stringstream ss(line);
-        std::string idStr, titleStr, plotStr, yearStr;
-        std::getline(ss, idStr, ',');
-        std::getline(ss, titleStr, ',');
-        std::getline(ss, plotStr, ',');
-        std::getline(ss, yearStr, ',');
+    CsvStage<StagedActorRow> actors;
+    CsvStage<StagedMovieRow> movies;
+    CsvStage<StagedCastRow> cast;
+    bool haveActors = actors.open(actorsFile);
+    bool haveMovies = movies.open(moviesFile);
+    bool haveCast = cast.open(castFile);
 
-        // Validate basic row structure.
-        if (idStr.empty() || titleStr.empty() || plotStr.empty() || yearStr.empty()) {
-            std::cerr << "[Warning] Malformed row: " << line << "\n";
-            continue;
+    // Parse CPU time is summed over each stage's chunk workers.
+    std::thread movieParser([&]() {
+        PhaseTimer t;
+        if (haveMovies) {
+            movies.parseAll();
         }
+        t.stop(report.moviesParse);
+        report.moviesParse.cpuMillis = movies.getParseCpuMillis();
+        });
+    std::thread castTokenizer([&]() {
+        PhaseTimer t;
+        if (haveCast) {
+            cast.parseAll();
+        }
+        t.stop(report.castTokenize);
+        report.castTokenize.cpuMillis = cast.getParseCpuMillis();
+        });
+
+    PhaseTimer t;
+    if (haveActors) {
+        actors.parseAll();
+    }
+    t.stop(report.actorsParse);
+    report.actorsParse.cpuMillis = actors.getParseCpuMillis();
+    t.restart();
+    if (haveActors) {
+        report.actors.filename = actorsFile;
+        report.actors.bytes = actors.getEnd();
+        mergeActors(actors, report.actors);
+    }
+    t.stop(report.actorsMerge);
+
+    movieParser.join();
+    t.restart();
+    if (haveMovies) {
+        report.movies.filename = moviesFile;
+        report.movies.bytes = movies.getEnd();
+        mergeMovies(movies, moviesFile, report.movies);
+    }
+    t.stop(report.moviesMerge);
+
+    // Both tables are sealed; linking only waits for the cast pairs now.
+    t.restart();
+    castTokenizer.join();
+    t.stop(report.castWait);
+    t.restart();
+    if (haveCast) {
+        report.cast.filename = castFile;
+        report.cast.bytes = cast.getEnd();
+        linkCast(cast, report.cast);
+    }
+    t.stop(report.castLink);
+    whole.stop(report.total);
+    report.total.cpuMillis = processCpuMillis() - startCpu;
+    report.allocations = allocationCount() - startAllocations;
+    report.peakResidentBytes = peakResidentBytes();
+    describeTables(report);
+
+    // Later calls to ingestAppendedRows() pick up where this load ended.
+    actorsFeed.filename = actorsFile;
+    actorsFeed.offset = haveActors ? actors.getEnd() : 0;
+    moviesFeed.filename = moviesFile;
+    moviesFeed.offset = haveMovies ? movies.getEnd() : 0;
+    castFeed.filename = castFile;
+    castFeed.offset = haveCast ? cast.getEnd() : 0;
+}
 
-        int id = std::atoi(idStr.c_str());
-        int year = std::atoi(yearStr.c_str());
-        titleStr = trimQuotes(titleStr);
-        plotStr = trimQuotes(plotStr);
+/**
+ * @brief Adds the size, capacity and resize count of each table to a load report.
+ *
+ * @param report The report to fill.
+ */
+void MovieApp::describeTables(LoadReport& report) const {
+    const StringArena& arena = StringArena::shared();
+    report.addTable("actors", actorTable.size(), actorTable.getCapacity(), actorTable.getGrowCount());
+    report.addTable("actor_ids", actorTable.getIds().size(), actorTable.getIds().getBucketCount(),
+        actorTable.getIds().getRehashCount());
+    report.addTable("movies", movieTable.size(), movieTable.getCapacity(), movieTable.getGrowCount());
+    report.addTable("movie_ids", movieTable.getIds().size(), movieTable.getIds().getBucketCount(),
+        movieTable.getIds().getRehashCount());
+    report.addTable("strings", arena.getStringCount(), arena.getSlotCapacity(), arena.getSlotGrowCount());
+}
+
+/**
+ * @brief Merges parsed actor rows into the actor table.
+ *
+ * Chunks are merged in file order, so later rows overwrite earlier ones.
+ * A row for an actor that is already loaded keeps the actor's rating and
+ * updates the copies of the actor in its casts.
+ *
+ * @param stage The parsed actors file.
+ * @param stats Receives the rows parsed, loaded and rejected.
+ */
+void MovieApp::mergeActors(const CsvStage<StagedActorRow>& stage, FileLoadStats& stats) {
+    stats.rowsParsed += stage.getRowCount() + stage.getRejectedCount() + stage.getBadNumberCount();
+    stats.rejects[REJECT_MISSING_FIELD] += stage.getRejectedCount();
+    stats.rejects[REJECT_BAD_NUMBER] += stage.getBadNumberCount();
+    StringArena& arena = StringArena::shared();
+    const char* data = stage.data();
+    for (int c = 0; c < stage.getChunkCount(); ++c) {
+        const StagingBuffer<StagedActorRow>& in = stage.rowsOf(c);
+        for (int i = 0; i < in.size(); ++i) {
+            const StagedActorRow& row = in.at(i);
+            const char* name = (row.nameInText ? in.text.data() : data) + row.nameOffset;
+            Actor actor(arena.intern(name, row.nameLength),
+                arena.intern(in.keys.data() + row.keyOffset, row.keyLength),
+                row.birthYear, row.id);
+            int existing = overlayActor(row.id);
+            if (existing != -1) {
+                actor.setRating(actorTable.at(existing).getRating());
+                ++stats.duplicateIds;
+            }
+            ++stats.rowsLoaded;
+            int actorDenseId = actorTable.insert(actor);
+            actorColumns.set(actorDenseId, actor);
+            if (existing != -1) {
+                refreshCastCopies(actorDenseId);
+            }
+            if (row.id >= nextActorId) {
+                nextActorId = row.id + 1;
+            }
+        }
+    }
+}
 
-        Movie movie(titleStr.c_str(), plotStr.c_str(), year, id);
-        movieTable.insert(movie);
-        if (id >= nextMovieId) {
-            nextMovieId = id + 1;
+/**
+ * @brief Merges parsed movie rows into the movie table.
+ *
+ * Chunks are merged in file order, so later rows overwrite earlier ones and
+ * malformed rows are reported in file order. A row for a movie that is
+ * already loaded keeps the movie's rating and cast.
+ *
+ * @param stage The parsed movies file.
+ * @param filename The file, registered with the PlotStore for lazy plots.
+ * @param stats Receives the rows parsed, loaded and rejected.
+ */
+void MovieApp::mergeMovies(const CsvStage<StagedMovieRow>& stage, const std::string& filename,
+    FileLoadStats& stats) {
+    stats.rowsParsed += stage.getRowCount();
+    StringArena& arena = StringArena::shared();
+    PlotStore& plots = PlotStore::shared();
+    int source = plots.addSource(filename);
+    const char* data = stage.data();
+    for (int c = 0; c < stage.getChunkCount(); ++c) {
+        const StagingBuffer<StagedMovieRow>& in = stage.rowsOf(c);
+        for (int i = 0; i < in.size(); ++i) {
+            const StagedMovieRow& row = in.at(i);
+            if (row.malformed) {
+                std::cerr << "[Warning] Malformed row: "
+                    << std::string_view(data + row.rowOffset, row.rowLength) << "\n";
+                ++stats.rejects[row.badNumber ? REJECT_BAD_NUMBER : REJECT_MISSING_FIELD];
+                continue;
+            }
+            const char* title = (row.titleInText ? in.text.data() : data) + row.titleOffset;
+            Movie movie(arena.intern(title, row.titleLength),
+                arena.intern(in.keys.data() + row.keyOffset, row.keyLength),
+                plots.addDeferred(source, static_cast<long long>(row.plotOffset),
+                    static_cast<int>(row.plotLength), row.plotEscaped),
+                row.releaseYear, row.id);
+            int existing = overlayMovie(row.id);
+            if (existing != -1) {
+                const Movie& old = movieTable.at(existing);
+                movie.setRating(old.getRating());
+                movie.getActors() = old.getActors();
+                ++stats.duplicateIds;
+            }
+            ++stats.rowsLoaded;
+            movieColumns.set(movieTable.insert(movie), movie);
+            if (row.id >= nextMovieId) {
+                nextMovieId = row.id + 1;
+            }
         }
     }
-    fin.close();
 }
 
 /**
- * @brief Reads cast data from a CSV file.
+ * @brief Links tokenized cast pairs with one sort instead of a lookup per link.
  *
- * Parses each row to extract actor and movie IDs, then links actors to movies
- * by adding the actor to the corresponding movie's cast.
+ * Linking pair by pair walks the movie's cast list twice per row (duplicate
+ * check, then append) and scans the actor's filmography for duplicates.
+ * Instead the pairs are resolved to dense IDs once and counting-sorted by
+ * movie, which is a one-digit radix sort over the dense movie range. The sort
+ * is stable, so each movie's run stays in file order. Each run is deduplicated
+ * with a per-actor stamp and appended to the cast in one go, while the
+ * filmographies, presized from per-actor counts, are filled in the same pass.
  *
- * @param filename The path to the CSV file.
+ * The resulting casts and filmographies contain the same links as a
+ * row-by-row load, with casts in file order and filmographies in movie
+ * order (the order loadSnapshot() produces). Image mode and small batches
+ * keep the row-by-row path; in image mode links may already exist in the image.
+ *
+ * @param stage The tokenized cast file.
+ * @param stats Receives the rows parsed, linked and rejected.
  */
-void MovieApp::readCast(const std::string& filename) {
-    std::ifstream fin(filename.c_str());
-    if (!fin.is_open()) {
-        std::cerr << "[Error] Could not open file: " << filename << "\n";
+void MovieApp::linkCast(const CsvStage<StagedCastRow>& stage, FileLoadStats& stats) {
+    int pairCount = stage.getRowCount();
+    stats.rowsParsed += pairCount + stage.getRejectedCount() + stage.getBadNumberCount();
+    stats.rejects[REJECT_MISSING_FIELD] += stage.getRejectedCount();
+    stats.rejects[REJECT_BAD_NUMBER] += stage.getBadNumberCount();
+    int actorCount = actorTable.size();
+    int movieCount = movieTable.size();
+    if (pairCount == 0) {
         return;
     }
-
-    std::string header;
-    if (!std::getline(fin, header)) {
-        std::cerr << "[Error] File is empty: " << filename << "\n";
-        fin.close();
+    // The sort costs O(actors + movies) however few pairs there are, so
+    // small batches such as appended rows are linked one by one.
+    if (image.isOpen() || static_cast<long long>(pairCount) * 16 < actorCount + movieCount) {
+        for (int c = 0; c < stage.getChunkCount(); ++c) {
+            const StagingBuffer<StagedCastRow>& in = stage.rowsOf(c);
+            for (int i = 0; i < in.size(); ++i) {
+                int actorDenseId = overlayActor(in.at(i).actorId);
+                int movieDenseId = overlayMovie(in.at(i).movieId);
+                if (actorDenseId == -1) {
+                    ++stats.rejects[REJECT_UNKNOWN_ACTOR];
+                }
+                else if (movieDenseId == -1) {
+                    ++stats.rejects[REJECT_UNKNOWN_MOVIE];
+                }
+                else if (linkActorToMovie(actorDenseId, movieDenseId)) {
+                    ++stats.rowsLoaded;
+                }
+                else {
+                    ++stats.rejects[REJECT_DUPLICATE_LINK];
+                }
+            }
+        }
+        return;
+    }
+    if (actorCount == 0 || movieCount == 0) {
+        stats.rejects[actorCount == 0 ? REJECT_UNKNOWN_ACTOR : REJECT_UNKNOWN_MOVIE] += pairCount;
         return;
     }
+    // A batch this large is cheaper to rebuild the actor graph from than to
+    // add edge by edge, so the graph is rebuilt by the next query instead.
+    actorGraphReady = false;
+
+    // Resolve IDs in file order and count the pairs of each movie.
+    int* pairActor = new int[pairCount];
+    int* pairMovie = new int[pairCount];
+    int* movieStart = new int[movieCount + 1]();
+    int resolved = 0;
+    for (int c = 0; c < stage.getChunkCount(); ++c) {
+        const StagingBuffer<StagedCastRow>& in = stage.rowsOf(c);
+        for (int i = 0; i < in.size(); ++i) {
+            int actorDenseId = actorTable.indexOf(in.at(i).actorId);
+            int movieDenseId = movieTable.indexOf(in.at(i).movieId);
+            if (actorDenseId == -1) {
+                ++stats.rejects[REJECT_UNKNOWN_ACTOR];
+            }
+            else if (movieDenseId == -1) {
+                ++stats.rejects[REJECT_UNKNOWN_MOVIE];
+            }
+            else {
+                pairActor[resolved] = actorDenseId;
+                pairMovie[resolved] = movieDenseId;
+                ++movieStart[movieDenseId + 1];
+                ++resolved;
+            }
+        }
+    }
 
-    std::string line;
-    while (std::getline(fin, line)) {
-        if (line.empty()) continue;
+    // Counting sort by movie: prefix sums give each run's start, then scatter.
+    for (int m = 0; m < movieCount; ++m) {
+        movieStart[m + 1] += movieStart[m];
+    }
+    int* sortedActors = new int[resolved > 0 ? resolved : 1];
+    int* next = new int[movieCount];
+    int* actorLinks = new int[actorCount]();
+    for (int m = 0; m < movieCount; ++m) {
+        next[m] = movieStart[m];
+    }
+    for (int i = 0; i < resolved; ++i) {
+        sortedActors[next[pairMovie[i]]++] = pairActor[i];
+        ++actorLinks[pairActor[i]];
+    }
+    delete[] next;
+    delete[] pairActor;
+    delete[] pairMovie;
 
-        std::stringstream ss(line);
-        std::string actorIdStr, movieIdStr;
-        std::getline(ss, actorIdStr, ',');
-        std::getline(ss, movieIdStr, ',');
+    filmographyOf(actorCount - 1); // Grow the index once, up front.
+    for (int a = 0; a < actorCount; ++a) {
+        if (actorLinks[a] > 0) {
+            filmographies[a].reserve(actorLinks[a]);
+        }
+    }
+    delete[] actorLinks;
 
-        if (actorIdStr.empty() || movieIdStr.empty()) {
+    // Walk the runs: drop repeats, then append each cast in one pass.
+    int* stamp = new int[actorCount];
+    for (int a = 0; a < actorCount; ++a) {
+        stamp[a] = -1;
+    }
+    int longestRun = 0;
+    for (int m = 0; m < movieCount; ++m) {
+        if (movieStart[m + 1] - movieStart[m] > longestRun) {
+            longestRun = movieStart[m + 1] - movieStart[m];
+        }
+    }
+    Actor* batch = new Actor[longestRun > 0 ? longestRun : 1];
+    for (int m = 0; m < movieCount; ++m) {
+        if (movieStart[m] == movieStart[m + 1]) {
             continue;
         }
-
-        int aId = std::atoi(actorIdStr.c_str());
-        int mId = std::atoi(movieIdStr.c_str());
-
-        // Link the actor and movie if both exist.
-        Actor* actor = actorTable.find(aId);
-        Movie* movie = movieTable.find(mId);
-        if (actor && movie) {
-            movie->addActor(*actor);
+        Movie& movie = movieTable.at(m);
+        // A movie that already has a cast (readCast() called twice) may
+        // repeat an existing link, which the stamps cannot see.
+        bool hadCast = !movie.getActors().isEmpty();
+        int batchCount = 0;
+        for (int i = movieStart[m]; i < movieStart[m + 1]; ++i) {
+            int a = sortedActors[i];
+            if (stamp[a] == m) {
+                ++stats.rejects[REJECT_DUPLICATE_LINK];
+                continue;
+            }
+            stamp[a] = m;
+            if (hadCast && movie.hasActor(actorTable.at(a).getId())) {
+                ++stats.rejects[REJECT_DUPLICATE_LINK];
+                continue;
+            }
+            filmographies[a].append(m);
+            batch[batchCount++] = actorTable.at(a);
         }
+        movie.getActors().addAll(batch, batchCount);
+        stats.rowsLoaded += batchCount;
     }
-    fin.close();
+    delete[] batch;
+    delete[] stamp;
+    delete[] sortedActors;
+    delete[] movieStart;
 }
 
 // ---------------------------------------------------------------------------
-// Next ID Accessors and ID Checks
+// Tail Mode
 // ---------------------------------------------------------------------------
 
 /**
- * @brief Gets the next available actor ID.
+ * @brief Starts following one CSV file.
  *
- * @return The next actor ID.
+ * @param feed The file's cursor.
+ * @param filename The file.
  */
-int MovieApp::getNextActorId() const {
-    return nextActorId;
+static void followFeed(FeedCursor& feed, const std::string& filename) {
+    if (feed.filename == filename) {
+        return; // Already positioned by loadCsvFiles().
+    }
+    std::error_code ec;
+    uintmax_t size = std::filesystem::file_size(filename, ec);
+    feed.filename = filename;
+    feed.offset = ec ? 0 : static_cast<size_t>(size);
 }
 
 /**
- * @brief Gets the next available movie ID.
+ * @brief Checks whether a followed file has grown (or shrunk) since it was last read.
  *
- * @return The next movie ID.
+ * @param feed The file's cursor.
+ * @return true if its size differs from the cursor.
  */
-int MovieApp::getNextMovieId() const {
-    return nextMovieId;
+static bool feedChanged(const FeedCursor& feed) {
+    if (feed.filename.empty()) {
+        return false;
+    }
+    std::error_code ec;
+    uintmax_t size = std::filesystem::file_size(feed.filename, ec);
+    return !ec && size != feed.offset;
 }
 
 /**
- * @brief Checks whether an actor ID is already used.
+ * @brief Returns how long ago a file was last modified.
  *
- * @param id The actor ID to check.
- * @return true if the actor ID is used; false otherwise.
+ * @param filename The file.
+ * @return double The age in milliseconds (0 if unknown).
  */
-bool MovieApp::isActorIdUsed(int id) const {
-    return (actorTable.find(id) != nullptr);
+static double modifiedMillisAgo(const std::string& filename) {
+    std::error_code ec;
+    std::filesystem::file_time_type modified = std::filesystem::last_write_time(filename, ec);
+    if (ec) {
+        return 0.0;
+    }
+    return std::chrono::duration<double, std::milli>(
+        std::filesystem::file_time_type::clock::now() - modified).count();
 }
 
 /**
- * @brief Checks whether a movie ID is already used.
+ * @brief Starts following the three CSV files.
  *
- * @param id The movie ID to check.
- * @return true if the movie ID is used; false otherwise.
+ * @param actorsFile The actors CSV file.
+ * @param moviesFile The movies CSV file.
+ * @param castFile The cast CSV file.
  */
-bool MovieApp::isMovieIdUsed(int id) const {
-    return (movieTable.find(id) != nullptr);
+void MovieApp::followCsvFiles(const std::string& actorsFile, const std::string& moviesFile,
+    const std::string& castFile) {
+    followFeed(actorsFeed, actorsFile);
+    followFeed(moviesFeed, moviesFile);
+    followFeed(castFeed, castFile);
 }
 
-// ---------------------------------------------------------------------------
-// Adding and Updating Actors and Movies
-// ---------------------------------------------------------------------------
-
 /**
- * @brief Adds a new actor to the system.
+ * @brief Applies rows appended to the followed files.
  *
- * Validates input, ensures a unique actor ID, creates an Actor, and inserts it
- * into the actor hash table.
+ * Each file is stat'ed first and only mapped if its size changed. New rows
+ * go through the same staging, merge and link steps as a full load, which
+ * upsert into the existing tables.
  *
- * @param name The name of the actor.
- * @param birthYear The birth year of the actor.
+ * @param stats Receives what was ingested.
+ * @return true if any rows were read.
  */
-void MovieApp::addNewActor(const std::string& name, int birthYear) {
-    if (!isAdmin) {
-        std::cout << "[Error] Only administrators can add new actors.\n";
-        return;
-    }
-    std::string trimmedName = trim(name);
-    if (trimmedName.empty()) {
-        std::cout << "[Error] Actor name cannot be empty.\n";
-        return;
-    }
-    if (birthYear <= 0 || birthYear > 2025) {
-        std::cout << "[Error] Invalid birth year.\n";
-        return;
+bool MovieApp::ingestAppendedRows(IngestStats& stats) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    stats = IngestStats();
+    bool actorsChanged = feedChanged(actorsFeed);
+    bool moviesChanged = feedChanged(moviesFeed);
+    bool castChanged = feedChanged(castFeed);
+    if (!actorsChanged && !moviesChanged && !castChanged) {
+        return false;
     }
-    // Ensure a unique actor ID.
-    while (isActorIdUsed(nextActorId)) {
-        ++nextActorId;
+
+    CsvStage<StagedActorRow> actors;
+    CsvStage<StagedMovieRow> movies;
+    CsvStage<StagedCastRow> cast;
+    FileLoadStats actorStats = FileLoadStats();
+    FileLoadStats movieStats = FileLoadStats();
+    FileLoadStats castStats = FileLoadStats();
+    if (actorsChanged && actors.openAppended(actorsFeed.filename, actorsFeed.offset)) {
+        actors.parseAll();
+        mergeActors(actors, actorStats);
+    }
+    if (moviesChanged && movies.openAppended(moviesFeed.filename, moviesFeed.offset)) {
+        movies.parseAll();
+        mergeMovies(movies, moviesFeed.filename, movieStats);
+    }
+    if (castChanged && cast.openAppended(castFeed.filename, castFeed.offset)) {
+        cast.parseAll();
+        linkCast(cast, castStats);
+    }
+    stats.actorRows = actorStats.rowsLoaded;
+    stats.movieRows = movieStats.rowsLoaded;
+    stats.castRows = cast.getRowCount();
+
+    // Advance the cursors and measure how stale the newest rows were.
+    FeedCursor* feeds[] = { &actorsFeed, &moviesFeed, &castFeed };
+    size_t ends[] = { actors.getEnd(), movies.getEnd(), cast.getEnd() };
+    bool changed[] = { actorsChanged, moviesChanged, castChanged };
+    for (int f = 0; f < 3; ++f) {
+        if (!changed[f] || ends[f] == feeds[f]->offset) {
+            continue;
+        }
+        stats.bytes += (ends[f] > feeds[f]->offset) ? ends[f] - feeds[f]->offset : ends[f];
+        feeds[f]->offset = ends[f];
+        double lag = modifiedMillisAgo(feeds[f]->filename);
+        if (lag > stats.lagMillis) {
+            stats.lagMillis = lag;
+        }
     }
-    Actor actor(trimmedName.c_str(), birthYear, nextActorId);
-    actorTable.insert(actor);
-    std::cout << "[Success] Added new actor: \"" << trimmedName
-        << "\" (ID=" << actor.getId() << ")\n";
-    ++nextActorId;
+    stats.millis = millisSince(start);
+    int rows = stats.actorRows + stats.movieRows + stats.castRows;
+    stats.rowsPerSecond = (stats.millis > 0.0) ? rows * 1000.0 / stats.millis : 0.0;
+    return stats.bytes > 0;
 }
 
+// ---------------------------------------------------------------------------
+// Snapshot Methods
+// ---------------------------------------------------------------------------
+
 /**
- * @brief Adds a new movie to the system.
+ * @brief Appends text to a snapshot's text section.
  *
- * Validates input, ensures a unique movie ID, creates a Movie, and inserts it
- * into the movie hash table.
+ * @param text The text section being built.
+ * @param s Pointer to the text.
+ * @param length Number of bytes.
+ * @return uint32_t Offset of the text within the section.
+ */
+static uint32_t appendSnapshotText(std::string& text, const char* s, size_t length) {
+    uint32_t offset = static_cast<uint32_t>(text.size());
+    text.append(s, length);
+    return offset;
+}
+
+/**
+ * @brief Rounds a file offset up to the next multiple of 8.
  *
- * @param title The title of the movie.
- * @param plot The plot of the movie.
- * @param releaseYear The release year of the movie.
+ * @param offset The offset.
+ * @return uint64_t The aligned offset.
  */
-void MovieApp::addNewMovie(const std::string& title, const std::string& plot, int releaseYear) {
-    if (!isAdmin) {
-        std::cout << "[Error] Only administrators can add new movies.\n";
-        return;
-    }
-    std::string trimmedTitle = trimQuotes(title);
-    if (trimmedTitle.empty()) {
-        std::cout << "[Error] Movie title cannot be empty.\n";
-        return;
-    }
-    if (releaseYear <= 1887 || releaseYear > 2025) {
-        std::cout << "[Error] Invalid release year.\n";
-        return;
-    }
-    while (isMovieIdUsed(nextMovieId)) {
-        ++nextMovieId;
-    }
-    Movie movie(trimmedTitle.c_str(), plot.c_str(), releaseYear, nextMovieId);
-    movieTable.insert(movie);
-    std::cout << "[Success] Added new movie: \"" << trimmedTitle
-        << "\" (ID=" << movie.getId() << ")\n";
-    ++nextMovieId;
+static uint64_t alignSnapshotOffset(uint64_t offset) {
+    return (offset + 7) & ~static_cast<uint64_t>(7);
 }
 
 /**
- * @brief Links an actor to a movie using their IDs.
+ * @brief Checks that a text range lies inside the snapshot's text section.
  *
- * Looks up the actor and movie in their respective hash tables and adds the actor
- * to the movie's cast.
+ * @param offset Offset of the range.
+ * @param length Length of the range.
+ * @param textBytes Size of the text section.
+ * @return true if the range is valid.
+ */
+static bool snapshotTextInRange(uint32_t offset, uint32_t length, uint64_t textBytes) {
+    return static_cast<uint64_t>(offset) + length <= textBytes;
+}
+
+/**
+ * @brief Writes the application state to a binary snapshot.
  *
- * @param actorId The actor's ID.
- * @param movieId The movie's ID.
- * @param isAdmin Flag indicating whether the operation is performed in admin mode.
+ * Records are written in dense ID order and cast links movie by movie in
+ * cast order, so loading the snapshot rebuilds the same tables. Plots that
+ * are still on disk are copied from their source file without being loaded,
+ * and once the new snapshot is in place they are pointed at it, so none is
+ * left pointing into the file that was replaced.
+ *
+ * @param path The snapshot file.
+ * @return true on success.
  */
-void MovieApp::addActorToMovieById(int actorId, int movieId, bool isAdmin) {
-    if (!isAdmin) {
-        std::cout << "[Error] Only administrators can add actors to movies.\n";
-        return;
+bool MovieApp::saveSnapshot(const std::string& path) const {
+    const StringArena& arena = StringArena::shared();
+    PlotStore& plots = PlotStore::shared();
+    uint32_t actorCount = static_cast<uint32_t>(actorTable.size());
+    uint32_t movieCount = static_cast<uint32_t>(movieTable.size());
+    std::string text;
+
+    SnapshotActor* actors = new SnapshotActor[actorCount > 0 ? actorCount : 1];
+    for (uint32_t i = 0; i < actorCount; ++i) {
+        const Actor& a = actorTable.at(static_cast<int>(i));
+        StringHandle name = a.getNameHandle();
+        StringHandle key = a.getNameKey();
+        SnapshotActor& rec = actors[i];
+        rec.id = a.getId();
+        rec.birthYear = a.getBirthYear();
+        rec.rating = a.getRating();
+        rec.nameOffset = appendSnapshotText(text, arena.resolve(name), name.length);
+        rec.nameLength = name.length;
+        rec.keyOffset = appendSnapshotText(text, arena.resolve(key), key.length);
+        rec.keyLength = key.length;
+        rec.reserved = 0;
     }
-    Actor* actor = actorTable.find(actorId);
-    if (!actor) {
-        std::cout << "[Error] Actor ID " << actorId << " not found.\n";
-        return;
+
+    uint32_t linkCount = 0;
+    bool plotsRead = true;
+    SnapshotMovie* movies = new SnapshotMovie[movieCount > 0 ? movieCount : 1];
+    for (uint32_t i = 0; i < movieCount; ++i) {
+        const Movie& m = movieTable.at(static_cast<int>(i));
+        StringHandle title = m.getTitleHandle();
+        StringHandle key = m.getTitleKey();
+        SnapshotMovie& rec = movies[i];
+        rec.id = m.getId();
+        rec.releaseYear = m.getReleaseYear();
+        rec.rating = m.getRating();
+        rec.titleOffset = appendSnapshotText(text, arena.resolve(title), title.length);
+        rec.titleLength = title.length;
+        rec.keyOffset = appendSnapshotText(text, arena.resolve(key), key.length);
+        rec.keyLength = key.length;
+        rec.plotOffset = static_cast<uint32_t>(text.size());
+        plotsRead = plotsRead && plots.appendTo(m.getPlotRef(), text);
+        rec.plotLength = static_cast<uint32_t>(text.size() - rec.plotOffset);
+        rec.reserved = 0;
+        linkCount += static_cast<uint32_t>(m.getActors().getSize());
     }
-    Movie* movie = movieTable.find(movieId);
-    if (!movie) {
-        std::cout << "[Error] Movie ID " << movieId << " not found.\n";
-        return;
+
+    SnapshotLink* links = new SnapshotLink[linkCount > 0 ? linkCount : 1];
+    uint32_t linkIndex = 0;
+    for (uint32_t i = 0; i < movieCount; ++i) {
+        movieTable.at(static_cast<int>(i)).getActors().forEach([&](const Actor& a) -> bool {
+            int actorDenseId = actorTable.indexOf(a.getId());
+            if (actorDenseId != -1) {
+                links[linkIndex].actorIndex = actorDenseId;
+                links[linkIndex].movieIndex = static_cast<int32_t>(i);
+                ++linkIndex;
+            }
+            return false;
+            });
     }
-    movie->addActor(*actor);
-    std::cout << "[Success] Actor \"" << actor->getName()
-        << "\" added to movie \"" << movie->getTitle() << "\"\n";
+    linkCount = linkIndex;
+
+    SnapshotHeader header = {};
+    header.magic = SNAPSHOT_MAGIC;
+    header.version = SNAPSHOT_VERSION;
+    header.actorCount = actorCount;
+    header.movieCount = movieCount;
+    header.linkCount = linkCount;
+    header.nextActorId = nextActorId;
+    header.nextMovieId = nextMovieId;
+    header.actorsOffset = alignSnapshotOffset(sizeof(SnapshotHeader));
+    header.moviesOffset = alignSnapshotOffset(header.actorsOffset + sizeof(SnapshotActor) * actorCount);
+    header.linksOffset = alignSnapshotOffset(header.moviesOffset + sizeof(SnapshotMovie) * movieCount);
+    header.textOffset = alignSnapshotOffset(header.linksOffset + sizeof(SnapshotLink) * linkCount);
+    header.textBytes = text.size();
+    header.logSequence = logSequence;
+
+    // Write to a temporary file first so a failed save never leaves a torn snapshot.
+    // A plot that could not be copied fails the save rather than being left empty.
+    std::string tempPath = path + ".tmp";
+    std::ofstream out(tempPath.c_str(), std::ios::binary | std::ios::trunc);
+    bool ok = plotsRead && out.is_open();
+    if (ok) {
+        const char padding[8] = { 0 };
+        uint64_t written = 0;
+        auto writeSection = [&](uint64_t offset, const void* bytes, uint64_t size) {
+            out.write(padding, static_cast<std::streamsize>(offset - written));
+            out.write(static_cast<const char*>(bytes), static_cast<std::streamsize>(size));
+            written = offset + size;
+        };
+        writeSection(0, &header, sizeof(header));
+        writeSection(header.actorsOffset, actors, sizeof(SnapshotActor) * actorCount);
+        writeSection(header.moviesOffset, movies, sizeof(SnapshotMovie) * movieCount);
+        writeSection(header.linksOffset, links, sizeof(SnapshotLink) * linkCount);
+        writeSection(header.textOffset, text.data(), text.size());
+        out.close();
+        ok = !out.fail();
+    }
+    delete[] actors;
+
+    if (ok) {
+        plots.closeReader(); // It may be open on the old snapshot.
+        ok = commitReplacement(tempPath, path);
+    }
+    if (ok) {
+        int source = plots.addSource(path);
+        for (uint32_t i = 0; i < movieCount; ++i) {
+            plots.relocate(movieTable.at(static_cast<int>(i)).getPlotRef(), source,
+                static_cast<long long>(header.textOffset + movies[i].plotOffset),
+                static_cast<int>(movies[i].plotLength));
+        }
+    }
+    delete[] movies;
+    delete[] links;
+    if (!ok) {
+        std::remove(tempPath.c_str());
+        std::cerr << "[Error] Could not write snapshot: " << path << "\n";
+    }
+    return ok;
 }
 
 /**
- * @brief Updates an actor's details.
+ * @brief Restores the application state from a binary snapshot.
  *
- * Looks up the actor by ID, validates the new details, and updates the actor in
- * both the actor table and in all movies containing that actor.
+ * The file is mapped and validated as a whole before anything is inserted.
+ * Names, keys and titles are interned straight from the mapping; plots are
+ * left in the file and registered with the PlotStore for lazy loading.
  *
- * @param actorId The actor's ID.
- * @param newName The new name.
- * @param newYearOfBirth The new birth year.
+ * @param path The snapshot file.
+ * @return true on success.
  */
-void MovieApp::updateActorDetails(int actorId, const std::string& newName, int newYearOfBirth) {
-    if (!isAdmin) {
-        std::cout << "[Error] Only administrators can update actor details.\n";
-        return;
+bool MovieApp::loadSnapshot(const std::string& path) {
+    MappedFile file;
+    if (!file.open(path)) {
+        std::cerr << "[Error] Could not open snapshot: " << path << "\n";
+        return false;
     }
-    Actor* actor = actorTable.find(actorId);
-    if (!actor) {
+    SnapshotHeader header;
+    if (file.size() < sizeof(header)) {
+        std::cerr << "[Error] Not a snapshot file: " << path << "\n";
+        return false;
+    }
+    std::memcpy(&header, file.data(), sizeof(header));
+    if (header.magic != SNAPSHOT_MAGIC) {
+        std::cerr << "[Error] Not a snapshot file: " << path << "\n";
+        return false;
+    }
+    if (header.version != SNAPSHOT_VERSION) {
+        std::cerr << "[Error] Unsupported snapshot version " << header.version << ": " << path << "\n";
+        return false;
+    }
+
+    // Validate every section and record before touching the tables.
+    uint64_t size = file.size();
+    bool valid = header.actorsOffset + sizeof(SnapshotActor) * static_cast<uint64_t>(header.actorCount) <= size
+        && header.moviesOffset + sizeof(SnapshotMovie) * static_cast<uint64_t>(header.movieCount) <= size
+        && header.linksOffset + sizeof(SnapshotLink) * static_cast<uint64_t>(header.linkCount) <= size
+        && header.textOffset + header.textBytes <= size
+        && header.actorsOffset % 8 == 0 && header.moviesOffset % 8 == 0 && header.linksOffset % 8 == 0;
+    const SnapshotActor* actors = reinterpret_cast<const SnapshotActor*>(file.data() + header.actorsOffset);
+    const SnapshotMovie* movies = reinterpret_cast<const SnapshotMovie*>(file.data() + header.moviesOffset);
+    const SnapshotLink* links = reinterpret_cast<const SnapshotLink*>(file.data() + header.linksOffset);
+    const char* text = file.data() + header.textOffset;
+    for (uint32_t i = 0; valid && i < header.actorCount; ++i) {
+        valid = snapshotTextInRange(actors[i].nameOffset, actors[i].nameLength, header.textBytes)
+            && snapshotTextInRange(actors[i].keyOffset, actors[i].keyLength, header.textBytes);
+    }
+    for (uint32_t i = 0; valid && i < header.movieCount; ++i) {
+        valid = snapshotTextInRange(movies[i].titleOffset, movies[i].titleLength, header.textBytes)
+            && snapshotTextInRange(movies[i].keyOffset, movies[i].keyLength, header.textBytes)
+            && snapshotTextInRange(movies[i].plotOffset, movies[i].plotLength, header.textBytes);
+    }
+    for (uint32_t i = 0; valid && i < header.linkCount; ++i) {
+        valid = links[i].actorIndex >= 0 && static_cast<uint32_t>(links[i].actorIndex) < header.actorCount
+            && links[i].movieIndex >= 0 && static_cast<uint32_t>(links[i].movieIndex) < header.movieCount;
+    }
+    if (!valid) {
+        std::cerr << "[Error] Snapshot is corrupt: " << path << "\n";
+        return false;
+    }
+
+    StringArena& arena = StringArena::shared();
+    int* actorDense = new int[header.actorCount > 0 ? header.actorCount : 1];
+    for (uint32_t i = 0; i < header.actorCount; ++i) {
+        const SnapshotActor& rec = actors[i];
+        Actor actor(arena.intern(text + rec.nameOffset, rec.nameLength),
+            arena.intern(text + rec.keyOffset, rec.keyLength), rec.birthYear, rec.id);
+        actor.setRating(rec.rating);
+        actorDense[i] = actorTable.insert(actor);
+        actorColumns.set(actorDense[i], actor);
+        if (rec.rating > 0) {
+            actorRatings.insert(actor);
+        }
+    }
+
+    PlotStore& plots = PlotStore::shared();
+    int source = plots.addSource(path);
+    int* movieDense = new int[header.movieCount > 0 ? header.movieCount : 1];
+    for (uint32_t i = 0; i < header.movieCount; ++i) {
+        const SnapshotMovie& rec = movies[i];
+        Movie movie(arena.intern(text + rec.titleOffset, rec.titleLength),
+            arena.intern(text + rec.keyOffset, rec.keyLength),
+            plots.addDeferred(source, static_cast<long long>(header.textOffset + rec.plotOffset),
+                static_cast<int>(rec.plotLength)),
+            rec.releaseYear, rec.id);
+        movie.setRating(rec.rating);
+        movieDense[i] = movieTable.insert(movie);
+        movieColumns.set(movieDense[i], movie);
+        if (rec.rating > 0) {
+            movieRatings.insert(movie);
+        }
+    }
+
+    for (uint32_t i = 0; i < header.linkCount; ++i) {
+        linkActorToMovie(actorDense[links[i].actorIndex], movieDense[links[i].movieIndex]);
+    }
+    delete[] actorDense;
+    delete[] movieDense;
+
+    if (header.nextActorId > nextActorId) {
+        nextActorId = header.nextActorId;
+    }
+    if (header.nextMovieId > nextMovieId) {
+        nextMovieId = header.nextMovieId;
+    }
+    logSequence = header.logSequence;
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// Mutation Log
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Replays the change history and the write-ahead log into the tables.
+ *
+ * The history goes first: after a CSV load logSequence is 0 and every
+ * checkpointed change is replayed from it, while after a snapshot load the
+ * ones the snapshot contains are skipped. The log then continues from the
+ * last sequence applied.
+ *
+ * @param logFile The log file.
+ * @param historyFile The change history.
+ * @param snapshotFile The snapshot used for checkpoints.
+ * @return int The number of changes replayed, or -1.
+ */
+int MovieApp::openLog(const std::string& logFile, const std::string& historyFile,
+    const std::string& snapshotFile) {
+    snapshotPath = snapshotFile;
+    historyPath = historyFile;
+    auto apply = [this](const MutationRecord& record) {
+        applyMutation(record);
+        };
+    int fromHistory = MutationLog::replayFile(historyFile, logSequence, apply);
+    if (fromHistory == -1) {
+        std::cerr << "[Error] Could not read change history: " << historyFile << "\n";
+        return -1;
+    }
+    int replayed = mutationLog.open(logFile, logSequence, apply);
+    if (replayed == -1) {
+        std::cerr << "[Error] Could not open change log: " << logFile << "\n";
+        return -1;
+    }
+    return fromHistory + replayed;
+}
+
+/**
+ * @brief Applies one change to the tables.
+ *
+ * In image mode, actors and movies are copied into the overlay first.
+ * Changes to an ID that does not exist are ignored.
+ *
+ * @param record The change.
+ */
+void MovieApp::applyMutation(const MutationRecord& record) {
+    switch (record.type) {
+    case MUTATION_ADD_ACTOR: {
+        if (!isActorIdUsed(record.id)) {
+            Actor actor(record.text.c_str(), record.value, record.id);
+            actorColumns.set(actorTable.insert(actor), actor);
+        }
+        if (record.id >= nextActorId) {
+            nextActorId = record.id + 1;
+        }
+        break;
+    }
+    case MUTATION_ADD_MOVIE: {
+        if (!isMovieIdUsed(record.id)) {
+            Movie movie(record.text.c_str(), record.plot.c_str(), record.value, record.id);
+            movieColumns.set(movieTable.insert(movie), movie);
+        }
+        if (record.id >= nextMovieId) {
+            nextMovieId = record.id + 1;
+        }
+        break;
+    }
+    case MUTATION_LINK: {
+        int actorDenseId = overlayActor(record.id);
+        int movieDenseId = overlayMovie(record.otherId);
+        if (actorDenseId != -1 && movieDenseId != -1) {
+            linkActorToMovie(actorDenseId, movieDenseId);
+        }
+        break;
+    }
+    case MUTATION_UPDATE_ACTOR: {
+        int actorDenseId = overlayActor(record.id);
+        if (actorDenseId == -1) {
+            break;
+        }
+        // Update the actor in the actor table, then in every cast.
+        Actor& actor = actorTable.at(actorDenseId);
+        actor.setName(record.text.c_str());
+        actor.setBirthYear(record.value);
+        actorColumns.set(actorDenseId, actor);
+        refreshCastCopies(actorDenseId);
+        break;
+    }
+    case MUTATION_UPDATE_MOVIE: {
+        int movieDenseId = overlayMovie(record.id);
+        if (movieDenseId == -1) {
+            break;
+        }
+        Movie& movie = movieTable.at(movieDenseId);
+        movie.setTitle(record.text.c_str());
+        movie.setPlot(record.plot.c_str());
+        movie.setReleaseYear(record.value);
+        movieColumns.set(movieDenseId, movie);
+        break;
+    }
+    case MUTATION_RATE_ACTOR: {
+        int actorDenseId = overlayActor(record.id);
+        if (actorDenseId == -1) {
+            break;
+        }
+        Actor& actor = actorTable.at(actorDenseId);
+        actor.setRating(record.value);
+        actorRatings.insert(actor);
+        actorColumns.set(actorDenseId, actor);
+        break;
+    }
+    case MUTATION_RATE_MOVIE: {
+        int movieDenseId = overlayMovie(record.id);
+        if (movieDenseId == -1) {
+            break;
+        }
+        Movie& movie = movieTable.at(movieDenseId);
+        movie.setRating(record.value);
+        movieRatings.insert(movie);
+        movieColumns.set(movieDenseId, movie);
+        break;
+    }
+    }
+    if (record.sequence > logSequence) {
+        logSequence = record.sequence;
+    }
+}
+
+/**
+ * @brief Logs a change, applies it, waits for it to be durable and checkpoints a large log.
+ *
+ * The record is queued before the tables change, so a change is never
+ * visible without having been handed to the log, and the tables are
+ * updated while the flusher writes it. Checkpoints are skipped in image
+ * mode, where the tables only hold the overlay.
+ *
+ * @param record The validated change.
+ * @return true once the change is applied and, if the log is open, synced to it.
+ */
+bool MovieApp::commitMutation(MutationRecord& record) {
+    record.sequence = 0;
+    if (mutationLog.isOpen()) {
+        mutationLog.append(record);
+    }
+    applyMutation(record);
+    if (mutationLog.isOpen() && !mutationLog.waitFor(record.sequence)) {
+        std::cout << "[Error] The change could not be saved to the change log and will be lost on exit.\n";
+        return false;
+    }
+    if (mutationLog.isOpen() && !image.isOpen() && mutationLog.getSize() >= LOG_CHECKPOINT_BYTES) {
+        checkpoint();
+    }
+    return true;
+}
+
+/**
+ * @brief Saves the logged changes to the history and a snapshot, then empties the log.
+ *
+ * The history comes first because it is what survives a reload from the
+ * CSV files, which replaces the snapshot with one built from the CSV
+ * files alone. The log is only emptied once both are durable; if the
+ * process stops before that, the next start skips the log records the
+ * history or snapshot already contains by sequence number.
+ *
+ * @return true on success.
+ */
+bool MovieApp::checkpoint() {
+    if (!mutationLog.saveToHistory(historyPath)) {
+        std::cerr << "[Error] Could not save changes to the change history: " << historyPath << "\n";
+        return false;
+    }
+    if (!saveSnapshot(snapshotPath)) {
+        return false;
+    }
+    if (!mutationLog.reset(logSequence)) {
+        std::cerr << "[Error] Could not reset change log.\n";
+        return false;
+    }
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// Next ID Accessors and ID Checks
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Gets the next available actor ID.
+ *
+ * @return The next actor ID.
+ */
+int MovieApp::getNextActorId() const {
+    return nextActorId;
+}
+
+/**
+ * @brief Gets the next available movie ID.
+ *
+ * @return The next movie ID.
+ */
+int MovieApp::getNextMovieId() const {
+    return nextMovieId;
+}
+
+/**
+ * @brief Checks whether an actor ID is already used.
+ *
+ * @param id The actor ID to check.
+ * @return true if the actor ID is used; false otherwise.
+ */
+bool MovieApp::isActorIdUsed(int id) const {
+    return (actorTable.find(id) != nullptr || image.findActor(id) != -1);
+}
+
+/**
+ * @brief Checks whether a movie ID is already used.
+ *
+ * @param id The movie ID to check.
+ * @return true if the movie ID is used; false otherwise.
+ */
+bool MovieApp::isMovieIdUsed(int id) const {
+    return (movieTable.find(id) != nullptr || image.findMovie(id) != -1);
+}
+
+// ---------------------------------------------------------------------------
+// Adding and Updating Actors and Movies
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Adds a new actor to the system.
+ *
+ * Validates input, ensures a unique actor ID, creates an Actor, and inserts it
+ * into the actor table.
+ *
+ * @param name The name of the actor.
+ * @param birthYear The birth year of the actor.
+ */
+void MovieApp::addNewActor(const std::string& name, int birthYear) {
+    if (!isAdmin) {
+        std::cout << "[Error] Only administrators can add new actors.\n";
+        return;
+    }
+    std::string trimmedName = trim(name);
+    if (trimmedName.empty()) {
+        std::cout << "[Error] Actor name cannot be empty.\n";
+        return;
+    }
+    if (birthYear <= 0 || birthYear > 2025) {
+        std::cout << "[Error] Invalid birth year.\n";
+        return;
+    }
+    // Ensure a unique actor ID.
+    while (isActorIdUsed(nextActorId)) {
+        ++nextActorId;
+    }
+    MutationRecord record = { 0, MUTATION_ADD_ACTOR, nextActorId, 0, birthYear, trimmedName, "" };
+    if (!commitMutation(record)) {
+        return;
+    }
+    std::cout << "[Success] Added new actor: \"" << trimmedName
+        << "\" (ID=" << record.id << ")\n";
+}
+
+/**
+ * @brief Adds a new movie to the system.
+ *
+ * Validates input, ensures a unique movie ID, creates a Movie, and inserts it
+ * into the movie table.
+ *
+ * @param title The title of the movie.
+ * @param plot The plot of the movie.
+ * @param releaseYear The release year of the movie.
+ */
+void MovieApp::addNewMovie(const std::string& title, const std::string& plot, int releaseYear) {
+    if (!isAdmin) {
+        std::cout << "[Error] Only administrators can add new movies.\n";
+        return;
+    }
+    std::string trimmedTitle = trimQuotes(title);
+    if (trimmedTitle.empty()) {
+        std::cout << "[Error] Movie title cannot be empty.\n";
+        return;
+    }
+    if (releaseYear <= 1887 || releaseYear > 2025) {
+        std::cout << "[Error] Invalid release year.\n";
+        return;
+    }
+    while (isMovieIdUsed(nextMovieId)) {
+        ++nextMovieId;
+    }
+    MutationRecord record = { 0, MUTATION_ADD_MOVIE, nextMovieId, 0, releaseYear, trimmedTitle, plot };
+    if (!commitMutation(record)) {
+        return;
+    }
+    std::cout << "[Success] Added new movie: \"" << trimmedTitle
+        << "\" (ID=" << record.id << ")\n";
+}
+
+/**
+ * @brief Links an actor to a movie using their IDs.
+ *
+ * Looks up the actor and movie in their respective tables, adds the actor
+ * to the movie's cast and records the movie in the actor's filmography.
+ * When serving an image, both are first copied into the overlay.
+ *
+ * @param actorId The actor's ID.
+ * @param movieId The movie's ID.
+ * @param isAdmin Flag indicating whether the operation is performed in admin mode.
+ */
+void MovieApp::addActorToMovieById(int actorId, int movieId, bool isAdmin) {
+    if (!isAdmin) {
+        std::cout << "[Error] Only administrators can add actors to movies.\n";
+        return;
+    }
+    int actorDenseId = overlayActor(actorId);
+    if (actorDenseId == -1) {
+        std::cout << "[Error] Actor ID " << actorId << " not found.\n";
+        return;
+    }
+    int movieDenseId = overlayMovie(movieId);
+    if (movieDenseId == -1) {
+        std::cout << "[Error] Movie ID " << movieId << " not found.\n";
+        return;
+    }
+    const Actor* actor = &actorTable.at(actorDenseId);
+    const Movie* movie = &movieTable.at(movieDenseId);
+    if (isCastMember(actorDenseId, movieDenseId)) {
+        std::cout << "[Info] Actor \"" << actor->getName()
+            << "\" is already in movie \"" << movie->getTitle() << "\"\n";
+        return;
+    }
+    MutationRecord record = { 0, MUTATION_LINK, actorId, movieId, 0, "", "" };
+    if (!commitMutation(record)) {
+        return;
+    }
+    std::cout << "[Success] Actor \"" << actor->getName()
+        << "\" added to movie \"" << movie->getTitle() << "\"\n";
+}
+
+/**
+ * @brief Updates an actor's details.
+ *
+ * Looks up the actor by ID, validates the new details, and updates the actor in
+ * both the actor table and in all movies of the actor's filmography.
+ *
+ * @param actorId The actor's ID.
+ * @param newName The new name.
+ * @param newYearOfBirth The new birth year.
+ */
+void MovieApp::updateActorDetails(int actorId, const std::string& newName, int newYearOfBirth) {
+    if (!isAdmin) {
+        std::cout << "[Error] Only administrators can update actor details.\n";
+        return;
+    }
+    if (overlayActor(actorId) == -1) {
         std::cout << "[Error] Actor ID " << actorId << " not found.\n";
         return;
     }
@@ -454,26 +1478,10 @@ void MovieApp::updateActorDetails(int actorId, const std::string& newName, int n
         std::cout << "[Error] Invalid year of birth.\n";
         return;
     }
-    // Update the actor in the hash table.
-    actor->setName(trimmedName.c_str());
-    actor->setBirthYear(newYearOfBirth);
-    actorTable.insert(*actor);
-
-    // Update actor details in all movies.
-    movieTable.forEach([&](const Movie& movieRef) -> bool {
-        Movie& movie = const_cast<Movie&>(movieRef);
-        if (movie.hasActor(actorId)) {
-            movie.getActors().forEach([&](const Actor& castActor) -> bool {
-                Actor& mutableActor = const_cast<Actor&>(castActor);
-                if (mutableActor.getId() == actorId) {
-                    mutableActor.setName(trimmedName.c_str());
-                    mutableActor.setBirthYear(newYearOfBirth);
-                }
-                return false; // Continue iteration.
-                });
-        }
-        return false;
-        });
+    MutationRecord record = { 0, MUTATION_UPDATE_ACTOR, actorId, 0, newYearOfBirth, trimmedName, "" };
+    if (!commitMutation(record)) {
+        return;
+    }
     std::cout << "[Success] Updated Actor ID " << actorId << "\n";
 }
 
@@ -496,8 +1504,7 @@ void MovieApp::updateMovieDetails(int movieId,
         std::cout << "[Error] Only administrators can update movie details.\n";
         return;
     }
-    Movie* movie = movieTable.find(movieId);
-    if (!movie) {
+    if (overlayMovie(movieId) == -1) {
         std::cout << "[Error] Movie ID " << movieId << " not found.\n";
         return;
     }
@@ -510,29 +1517,51 @@ void MovieApp::updateMovieDetails(int movieId,
         std::cout << "[Error] Invalid release year.\n";
         return;
     }
-    movie->setTitle(trimmedTitle.c_str());
-    movie->setPlot(newPlot.c_str());
-    movie->setReleaseYear(newReleaseYear);
-    movieTable.insert(*movie);
+    MutationRecord record = { 0, MUTATION_UPDATE_MOVIE, movieId, 0, newReleaseYear, trimmedTitle, newPlot };
+    if (!commitMutation(record)) {
+        return;
+    }
     std::cout << "[Success] Updated Movie ID " << movieId << "\n";
 }
 
 /**
  * @brief Finds actors by name.
  *
- * Iterates over all actors in the actor table and adds those that match the
- * provided name (case-insensitive) to the result list.
+ * Folds the search name once, then scans the name key column for the same
+ * interned key, so each row costs a handle comparison.
  *
  * @param name The actor name to search for.
  * @param result The list to populate with matching actors.
  */
 void MovieApp::findActorsByName(const std::string& name, List<Actor>& result) const {
-    actorTable.forEach([&](const Actor& a) -> bool {
-        if (caseInsensitiveCompareStrings(a.getName(), name.c_str()) == 0) {
-            result.add(a);
+    if (image.isOpen()) {
+        int* slots = nullptr;
+        int count = actorSlotsNamed(name, slots);
+        for (int i = 0; i < count; ++i) {
+            int actorDenseId = (slots[i] < image.getActorCount())
+                ? actorTable.indexOf(image.actorAt(slots[i]).id)
+                : slots[i] - image.getActorCount();
+            if (actorDenseId != -1) {
+                result.add(actorTable.at(actorDenseId));
+            }
+            else {
+                result.add(actorFromImage(image, image.actorAt(slots[i])));
+            }
         }
-        return false; // Continue iterating.
-        });
+        delete[] slots;
+        return;
+    }
+    StringHandle key;
+    if (!findCollationKey(name.c_str(), key)) {
+        return; // No stored name folds to this key.
+    }
+    int total = actorColumns.size();
+    const StringHandle* nameKeys = actorColumns.getNameKeys();
+    for (int i = 0; i < total; ++i) {
+        if (sameCollationKey(nameKeys[i], key)) {
+            result.add(actorTable.at(i));
+        }
+    }
 }
 
 // ---------------------------------------------------------------------------
@@ -540,75 +1569,166 @@ void MovieApp::findActorsByName(const std::string& name, List<Actor>& result) co
 // ---------------------------------------------------------------------------
 
 /**
- * @brief Merge sort helper for sorting Movie objects alphabetically by title.
+ * @brief Merge sort helper that orders dense IDs by an integer column.
  *
- * @param arr The array of Movie objects.
+ * The sort is stable, so rows with equal keys keep their dense ID order.
+ *
+ * @param ids The array of dense IDs to sort.
+ * @param temp Scratch buffer with room for at least right + 1 entries.
  * @param left The left index.
  * @param right The right index.
+ * @param key The column to sort by, indexed by dense ID.
  */
-static void mergeSortMovies(Movie* arr, int left, int right) {
+static void mergeSortIdsByKey(int* ids, int* temp, int left, int right, const int* key) {
     if (left >= right) return;
     int mid = (left + right) / 2;
-    mergeSortMovies(arr, left, mid);
-    mergeSortMovies(arr, mid + 1, right);
-    int size = right - left + 1;
-    Movie* temp = new Movie[size];
-    int i = left, j = mid + 1, k = 0;
+    mergeSortIdsByKey(ids, temp, left, mid, key);
+    mergeSortIdsByKey(ids, temp, mid + 1, right, key);
+    int i = left, j = mid + 1, k = left;
     while (i <= mid && j <= right) {
-        if (caseInsensitiveCompareStrings(arr[i].getTitle(), arr[j].getTitle()) <= 0) {
-            temp[k++] = arr[i++];
+        if (key[ids[i]] <= key[ids[j]]) {
+            temp[k++] = ids[i++];
         }
         else {
-            temp[k++] = arr[j++];
+            temp[k++] = ids[j++];
         }
     }
     while (i <= mid) {
-        temp[k++] = arr[i++];
+        temp[k++] = ids[i++];
     }
     while (j <= right) {
-        temp[k++] = arr[j++];
+        temp[k++] = ids[j++];
     }
-    for (int p = 0; p < size; ++p) {
-        arr[left + p] = temp[p];
+    for (int p = left; p <= right; ++p) {
+        ids[p] = temp[p];
     }
-    delete[] temp;
 }
 
 /**
- * @brief Displays all movies sorted alphabetically by title with pagination.
+ * @brief Merge sort helper that orders dense IDs alphabetically by a collation key column.
+ *
+ * @param ids The array of dense IDs to sort.
+ * @param temp Scratch buffer with room for at least right + 1 entries.
+ * @param left The left index.
+ * @param right The right index.
+ * @param keys The name or title key column to sort by, indexed by dense ID.
  */
-void MovieApp::displayAllMovies() const {
-    if (movieTable.isEmpty()) {
-        std::cout << "No movies found.\n";
-        return;
-    }
-    int capacity = 100, count = 0;
-    Movie* arr = new Movie[capacity];
-    movieTable.forEach([&](const Movie& m) -> bool {
-        if (count >= capacity) {
-            int newCapacity = capacity * 2;
-            Movie* newArr = new Movie[newCapacity];
-            for (int i = 0; i < count; i++) {
-                newArr[i] = arr[i];
-            }
-            delete[] arr;
-            arr = newArr;
-            capacity = newCapacity;
+static void mergeSortIdsByText(int* ids, int* temp, int left, int right, const StringHandle* keys) {
+    if (left >= right) return;
+    int mid = (left + right) / 2;
+    mergeSortIdsByText(ids, temp, left, mid, keys);
+    mergeSortIdsByText(ids, temp, mid + 1, right, keys);
+    int i = left, j = mid + 1, k = left;
+    while (i <= mid && j <= right) {
+        if (compareCollationKeys(keys[ids[i]], keys[ids[j]]) <= 0) {
+            temp[k++] = ids[i++];
         }
-        arr[count++] = m;
-        return false;
-        });
-    if (count == 0) {
-        std::cout << "No movies found.\n";
-        delete[] arr;
+        else {
+            temp[k++] = ids[j++];
+        }
+    }
+    while (i <= mid) {
+        temp[k++] = ids[i++];
+    }
+    while (j <= right) {
+        temp[k++] = ids[j++];
+    }
+    for (int p = left; p <= right; ++p) {
+        ids[p] = temp[p];
+    }
+}
+
+/**
+ * @brief Sorts an array of dense IDs by an integer column.
+ *
+ * @param ids The dense IDs.
+ * @param count Number of IDs.
+ * @param key The column to sort by.
+ */
+static void sortIdsByKey(int* ids, int count, const int* key) {
+    if (count < 2) return;
+    int* temp = new int[count];
+    mergeSortIdsByKey(ids, temp, 0, count - 1, key);
+    delete[] temp;
+}
+
+/**
+ * @brief Sorts an array of dense IDs by a collation key column.
+ *
+ * @param ids The dense IDs.
+ * @param count Number of IDs.
+ * @param keys The key column to sort by.
+ */
+static void sortIdsByText(int* ids, int count, const StringHandle* keys) {
+    if (count < 2) return;
+    int* temp = new int[count];
+    mergeSortIdsByText(ids, temp, 0, count - 1, keys);
+    delete[] temp;
+}
+
+/**
+ * @brief Displays all movies sorted alphabetically by title with pagination.
+ *
+ * Sorting works on dense IDs and the title column; full records are only
+ * touched when printed.
+ */
+void MovieApp::displayAllMovies() const {
+    if (image.isOpen()) {
+        displayAllMoviesFromImage();
         return;
     }
-    mergeSortMovies(arr, 0, count - 1);
+    int count = movieColumns.size();
+    if (count == 0) {
+        std::cout << "No movies found.\n";
+        return;
+    }
+    int* ids = new int[count];
+    for (int i = 0; i < count; i++) {
+        ids[i] = i;
+    }
+    sortIdsByText(ids, count, movieColumns.getTitleKeys());
     std::cout << "All Movies (alphabetical):\n";
     const int pageSize = 8000; // Movies per page.
     int linesPrinted = 0;
     for (int i = 0; i < count; i++) {
-        arr[i].displayDetails();
+        movieTable.at(ids[i]).displayDetails();
+        linesPrinted++;
+        if (linesPrinted % pageSize == 0 && i < count - 1) {
+            std::cout << "\n-- Press Enter to continue --";
+            std::cout.flush();
+            std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+            std::cout << "\n";
+        }
+    }
+    delete[] ids;
+}
+
+/**
+ * @brief Displays all actors sorted alphabetically by name with pagination.
+ *
+ * Sorting works on dense IDs and the name column; full records are only
+ * touched when printed.
+ */
+void MovieApp::displayAllActors() const {
+    if (image.isOpen()) {
+        displayAllActorsFromImage();
+        return;
+    }
+    int count = actorColumns.size();
+    if (count == 0) {
+        std::cout << "No actors found.\n";
+        return;
+    }
+    int* ids = new int[count];
+    for (int i = 0; i < count; i++) {
+        ids[i] = i;
+    }
+    sortIdsByText(ids, count, actorColumns.getNameKeys());
+    std::cout << "All Actors (alphabetical):\n";
+    const int pageSize = 8000;
+    int linesPrinted = 0;
+    for (int i = 0; i < count; i++) {
+        actorTable.at(ids[i]).displayDetails();
         linesPrinted++;
         if (linesPrinted % pageSize == 0 && i < count - 1) {
             std::cout << "\n-- Press Enter to continue --";
@@ -617,463 +1737,1610 @@ void MovieApp::displayAllMovies() const {
             std::cout << "\n";
         }
     }
-    delete[] arr;
+    delete[] ids;
+}
+
+/**
+ * @brief Displays actors whose ages fall within a given range, sorted by age.
+ *
+ * Filters and sorts using only the birth year and name columns.
+ *
+ * @param minAge The minimum age.
+ * @param maxAge The maximum age.
+ */
+void MovieApp::displayActorsByAge(int minAge, int maxAge) const {
+    if (image.isOpen()) {
+        displayActorsByAgeFromImage(minAge, maxAge);
+        return;
+    }
+    if (archive.isOpen()) {
+        displayActorsByAgeFromArchive(minAge, maxAge);
+        return;
+    }
+    int total = actorColumns.size();
+    const int* birthYears = actorColumns.getBirthYears();
+    // Translate the age range into a birth year range once instead of per row.
+    int minBirth = Actor::ageForBirthYear(0) - maxAge;
+    int maxBirth = Actor::ageForBirthYear(0) - minAge;
+    int count = 0;
+    int* ids = new int[total > 0 ? total : 1];
+    for (int i = 0; i < total; ++i) {
+        if (birthYears[i] >= minBirth && birthYears[i] <= maxBirth) {
+            ids[count++] = i;
+        }
+    }
+    if (count == 0) {
+        std::cout << "No actors found in age range [" << minAge << ", " << maxAge << "].\n";
+        delete[] ids;
+        return;
+    }
+    // Ages are only computed for the matching rows; other slots stay unused.
+    int* ageKey = new int[total];
+    for (int i = 0; i < count; ++i) {
+        ageKey[ids[i]] = Actor::ageForBirthYear(birthYears[ids[i]]);
+    }
+    sortIdsByKey(ids, count, ageKey);
+    const StringHandle* names = actorColumns.getNames();
+    const StringArena& arena = StringArena::shared();
+    std::cout << "Actors in age range [" << minAge << ", " << maxAge << "] (sorted by age):\n";
+    for (int i = 0; i < count; ++i) {
+        std::cout << arena.resolve(names[ids[i]]) << " (Age=" << ageKey[ids[i]] << ")\n";
+    }
+    delete[] ageKey;
+    delete[] ids;
+}
+
+/**
+ * @brief Displays recent movies (released within the last 3 years) sorted by release year.
+ *
+ * Filters and sorts using only the release year and title columns.
+ */
+void MovieApp::displayRecentMovies() const {
+    time_t now = time(0);
+    struct tm localTime;
+    localtime_s(&localTime, &now);
+    int currentYear = localTime.tm_year + 1900;
+    int cutoff = currentYear - 3;
+    if (image.isOpen()) {
+        displayRecentMoviesFromImage(cutoff);
+        return;
+    }
+    if (archive.isOpen()) {
+        displayRecentMoviesFromArchive(cutoff);
+        return;
+    }
+    int total = movieColumns.size();
+    const int* years = movieColumns.getReleaseYears();
+    int count = 0;
+    int* ids = new int[total > 0 ? total : 1];
+    for (int i = 0; i < total; ++i) {
+        if (years[i] >= cutoff) {
+            ids[count++] = i;
+        }
+    }
+    if (count == 0) {
+        std::cout << "No movies found in the last 3 years.\n";
+        delete[] ids;
+        return;
+    }
+    sortIdsByKey(ids, count, years);
+    const StringHandle* titles = movieColumns.getTitles();
+    const StringArena& arena = StringArena::shared();
+    std::cout << "Recent Movies (in ascending order of release year):\n";
+    for (int i = 0; i < count; ++i) {
+        std::cout << arena.resolve(titles[ids[i]])
+            << " (" << years[ids[i]] << ")\n";
+    }
+    delete[] ids;
+}
+
+/**
+ * @brief Displays movies featuring a given actor.
+ *
+ * Looks up the actor's filmography, sorts its k dense movie IDs alphabetically
+ * by the title column, and displays the results in O(k log k).
+ *
+ * @param actorId The actor's ID.
+ */
+void MovieApp::displayMoviesOfActor(int actorId) const {
+    if (image.isOpen()) {
+        displayMoviesOfActorFromImage(actorId);
+        return;
+    }
+    int actorDenseId = actorTable.indexOf(actorId);
+    if (actorDenseId == -1) {
+        std::cout << "Actor ID " << actorId << " not found.\n";
+        return;
+    }
+    if (actorDenseId >= filmographyCapacity || filmographies[actorDenseId].getCount() == 0) {
+        std::cout << "No movies found for actor ID " << actorId << ".\n";
+        return;
+    }
+    const Filmography& films = filmographies[actorDenseId];
+    int count = films.getCount();
+    int* ids = new int[count];
+    for (int i = 0; i < count; ++i) {
+        ids[i] = films.getMovieIdAt(i);
+    }
+    const StringHandle* titles = movieColumns.getTitles();
+    const int* years = movieColumns.getReleaseYears();
+    const StringArena& arena = StringArena::shared();
+    sortIdsByText(ids, count, movieColumns.getTitleKeys());
+    std::cout << "Movies for actor ID " << actorId << ":\n";
+    for (int i = 0; i < count; ++i) {
+        std::cout << " - " << arena.resolve(titles[ids[i]])
+            << " (" << years[ids[i]] << ")\n";
+    }
+    delete[] ids;
+}
+
+/**
+ * @brief Displays actors in a movie specified by title.
+ *
+ * Scans the title key column for the folded title, sorts its
+ * cast alphabetically by the name column, and displays the actor names and ages.
+ *
+ * @param movieTitle The title of the movie.
+ */
+void MovieApp::displayActorsInMovie(const std::string& movieTitle) const {
+    if (image.isOpen()) {
+        displayActorsInMovieFromImage(movieTitle);
+        return;
+    }
+    int total = movieColumns.size();
+    const StringHandle* titleKeys = movieColumns.getTitleKeys();
+    const StringArena& arena = StringArena::shared();
+    int movieDenseId = -1;
+    StringHandle key;
+    if (findCollationKey(movieTitle.c_str(), key)) {
+        for (int i = 0; i < total; ++i) {
+            if (sameCollationKey(titleKeys[i], key)) {
+                movieDenseId = i; // Stop at the first matching movie.
+                break;
+            }
+        }
+    }
+    if (movieDenseId == -1) {
+        std::cout << "Movie \"" << movieTitle << "\" not found.\n";
+        return;
+    }
+    const List<Actor>& cast = movieTable.at(movieDenseId).getActors();
+    int count = 0;
+    int* ids = new int[cast.getSize() > 0 ? cast.getSize() : 1];
+    cast.forEach([&](const Actor& a) -> bool {
+        int idx = actorTable.indexOf(a.getId());
+        if (idx != -1) {
+            ids[count++] = idx;
+        }
+        return false;
+        });
+    const StringHandle* names = actorColumns.getNames();
+    const int* birthYears = actorColumns.getBirthYears();
+    sortIdsByText(ids, count, actorColumns.getNameKeys());
+    std::cout << "Actors in \"" << movieTitle << "\":\n";
+    for (int i = 0; i < count; ++i) {
+        std::cout << " - " << arena.resolve(names[ids[i]])
+            << " (Age: " << Actor::ageForBirthYear(birthYears[ids[i]]) << ")\n";
+    }
+    delete[] ids;
+}
+
+/**
+ * @brief Displays actors known by a given actor (up to 2 levels).
+ *
+ * Finds the actor by name and uses breadth-first search on the actor graph
+ * to determine which actors are connected within 2 levels. The search is
+ * direction-optimizing, so the second level from a well-connected actor
+ * is found bottom-up and listed in load order. The graph is built by the
+ * first call and then kept up to date by linkActorToMovie(), so later
+ * calls only pay for the search.
+ *
+ * @param actorName The name of the starting actor.
+ */
+void MovieApp::displayActorsKnownBy(const std::string& actorName) const {
+    if (image.isOpen()) {
+        displayActorsKnownByFromImage(actorName);
+        return;
+    }
+    int startIndex = -1;
+    int total = actorColumns.size();
+    const StringHandle* names = actorColumns.getNames();
+    const StringHandle* nameKeys = actorColumns.getNameKeys();
+    const StringArena& arena = StringArena::shared();
+    StringHandle key;
+    if (findCollationKey(actorName.c_str(), key)) {
+        for (int i = 0; i < total; ++i) {
+            if (sameCollationKey(nameKeys[i], key)) {
+                startIndex = i; // Stop once found.
+                break;
+            }
+        }
+    }
+    if (startIndex == -1) {
+        std::cout << "[Error] Actor \"" << actorName << "\" not found.\n";
+        return;
+    }
+    if (!actorGraphReady) {
+        actorGraph.build(actorTable, movieTable);
+        actorGraphReady = true;
+    }
+    int totalActors = actorGraph.getVertexCount();
+    List<int> discovered = actorGraph.findConnectedActorsDirectionOptimizing(startIndex, 2);
+    if (discovered.isEmpty()) {
+        std::cout << "No actors found that \"" << actorName << "\" knows (up to 2 levels).\n";
+        return;
+    }
+    std::cout << "Actors known by \"" << actorName << "\" (up to 2 levels):\n";
+    discovered.forEach([&](int idx) {
+        if (idx < 0 || idx >= totalActors) return false;
+        std::cout << " - " << arena.resolve(names[idx]) << "\n";
+        return false;
+        });
+}
+
+/**
+ * @brief Times the actor ID lookups, graph builds and searches on the loaded catalogue.
+ *
+ * @param rounds Number of graph builds to time.
+ */
+void MovieApp::benchmarkActorGraph(int rounds) const {
+    int movieCount = movieTable.size();
+    long long lookups = 0;
+    long long found = 0;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int m = 0; m < movieCount; ++m) {
+        movieTable.at(m).getActors().forEach([&](const Actor& a) -> bool {
+            ++lookups;
+            if (actorTable.indexOf(a.getId()) != -1) {
+                ++found;
+            }
+            return false;
+            });
+    }
+    double lookupMillis = millisSince(start);
+    std::cout << "[Bench] Cast ID lookups: " << lookups << " (" << found << " found) in "
+        << std::fixed << std::setprecision(1) << lookupMillis << " ms, "
+        << std::setprecision(1) << (lookups > 0 ? lookupMillis * 1e6 / lookups : 0.0) << " ns each\n";
+
+    double best = 0;
+    double sum = 0;
+    ActorGraph graph;
+    for (int r = 0; r < rounds; ++r) {
+        start = std::chrono::steady_clock::now();
+        graph.build(actorTable, movieTable);
+        double millis = millisSince(start);
+        sum += millis;
+        if (r == 0 || millis < best) {
+            best = millis;
+        }
+    }
+    std::cout << "[Bench] Actor graph build: " << actorTable.size() << " actors, "
+        << graph.getNeighborCount() << " neighbor entries, "
+        << std::setprecision(1) << (graph.getBytes() / 1048576.0) << " MB; best "
+        << best << " ms, mean " << (rounds > 0 ? sum / rounds : 0.0) << " ms over "
+        << rounds << " builds\n";
+
+    // Compare the two searches from the best- and least-connected actors.
+    int hub = -1;
+    int leaf = -1;
+    for (int v = 0; v < graph.getVertexCount(); ++v) {
+        int degree = graph.getDegree(v);
+        if (degree > 0 && (hub == -1 || degree > graph.getDegree(hub))) {
+            hub = v;
+        }
+        if (degree > 0 && (leaf == -1 || degree < graph.getDegree(leaf))) {
+            leaf = v;
+        }
+    }
+    const char* labels[2] = { "hub", "leaf" };
+    int starts[2] = { hub, leaf };
+    for (int k = 0; k < 2 && starts[k] != -1; ++k) {
+        double topDown = 0;
+        double hybrid = 0;
+        int topDownFound = 0;
+        int hybridFound = 0;
+        for (int r = 0; r < rounds; ++r) {
+            start = std::chrono::steady_clock::now();
+            topDownFound = graph.findConnectedActors(starts[k], 2).getSize();
+            double millis = millisSince(start);
+            topDown = (r == 0 || millis < topDown) ? millis : topDown;
+            start = std::chrono::steady_clock::now();
+            hybridFound = graph.findConnectedActorsDirectionOptimizing(starts[k], 2).getSize();
+            millis = millisSince(start);
+            hybrid = (r == 0 || millis < hybrid) ? millis : hybrid;
+        }
+        std::cout << "[Bench] Depth-2 BFS from " << labels[k] << " (degree " << graph.getDegree(starts[k])
+            << "): top-down " << std::setprecision(2) << topDown << " ms (" << topDownFound
+            << " found), direction-optimizing " << hybrid << " ms (" << hybridFound << " found)\n";
+    }
+    std::cout.unsetf(std::ios::floatfield);
+    std::cout << std::setprecision(6);
+}
+
+// ---------------------------------------------------------------------------
+// Rating and Recommendation Methods
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Sets the rating for an actor.
+ *
+ * Validates the rating value, updates the actor's rating, and re-inserts the
+ * updated actor into the actor table.
+ *
+ * @param actorId The actor's ID.
+ * @param rating The new rating (1-10).
+ */
+void MovieApp::setActorRating(int actorId, int rating) {
+    if (rating < 1 || rating > 10) {
+        std::cout << "[Error] Invalid rating. Must be between 1 and 10.\n";
+        return;
+    }
+    if (overlayActor(actorId) == -1) {
+        std::cout << "[Error] Actor ID " << actorId << " not found.\n";
+        return;
+    }
+    MutationRecord record = { 0, MUTATION_RATE_ACTOR, actorId, 0, rating, "", "" };
+    if (!commitMutation(record)) {
+        return;
+    }
+    std::cout << "[Success] Actor (ID=" << actorId << ") rating updated to " << rating << "\n";
+}
+
+/**
+ * @brief Sets the rating for a movie.
+ *
+ * Validates the rating value, updates the movie's rating, and re-inserts the
+ * updated movie into the movie table.
+ *
+ * @param movieId The movie's ID.
+ * @param rating The new rating (1-10).
+ */
+void MovieApp::setMovieRating(int movieId, int rating) {
+    if (rating < 1 || rating > 10) {
+        std::cout << "[Error] Invalid rating. Must be between 1 and 10.\n";
+        return;
+    }
+    if (overlayMovie(movieId) == -1) {
+        std::cout << "[Error] Movie ID " << movieId << " not found.\n";
+        return;
+    }
+    MutationRecord record = { 0, MUTATION_RATE_MOVIE, movieId, 0, rating, "", "" };
+    if (!commitMutation(record)) {
+        return;
+    }
+    std::cout << "[Success] Movie (ID=" << movieId << ") rating updated to " << rating << "\n";
+}
+
+/**
+ * @brief Recommends movies within a specified rating range.
+ *
+ * Displays movies from the movieRatings hash table that have ratings between
+ * minRating and maxRating.
+ *
+ * @param minRating The minimum rating.
+ * @param maxRating The maximum rating.
+ */
+void MovieApp::recommendMoviesByRating(int minRating, int maxRating) const {
+    std::cout << "Movies with rating between " << minRating << " and " << maxRating << ":\n";
+    if (image.isOpen()) {
+        recommendMoviesFromImage(minRating, maxRating);
+        return;
+    }
+    movieRatings.displayMoviesInRange(minRating, maxRating);
+}
+
+/**
+ * @brief Recommends actors within a specified rating range.
+ *
+ * Displays actors from the actorRatings hash table that have ratings between
+ * minRating and maxRating.
+ *
+ * @param minRating The minimum rating.
+ * @param maxRating The maximum rating.
+ */
+void MovieApp::recommendActorsByRating(int minRating, int maxRating) const {
+    std::cout << "Actors with rating between " << minRating << " and " << maxRating << ":\n";
+    if (image.isOpen()) {
+        recommendActorsFromImage(minRating, maxRating);
+        return;
+    }
+    actorRatings.displayActorsInRange(minRating, maxRating);
+}
+
+
+// ---------------------------------------------------------------------------
+// Catalogue Image Methods
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Appends a NUL-terminated string to an image's text section.
+ *
+ * @param text The text section being built.
+ * @param s Pointer to the text.
+ * @param length Number of bytes.
+ * @return ImageText Reference to the stored string.
+ */
+static ImageText appendImageText(std::string& text, const char* s, size_t length) {
+    ImageText ref = { static_cast<uint32_t>(text.size()), static_cast<uint32_t>(length) };
+    text.append(s, length);
+    text.push_back('\0');
+    return ref;
+}
+
+/**
+ * @brief Writes the catalogue as a CatalogImage.
+ *
+ * Besides the records, the writer precomputes everything the image mode
+ * queries would otherwise build at startup: ID indexes, name and title
+ * orders, rating orders and both directions of the cast links as CSR
+ * arrays. Filmographies list movies in dense ID order, which is the order
+ * the in-memory actor graph visits them in.
+ *
+ * @param path The image file.
+ * @return true on success.
+ */
+bool MovieApp::writeImage(const std::string& path) const {
+    if (image.isOpen()) {
+        std::cerr << "[Error] Cannot write an image while serving one: " << path << "\n";
+        return false;
+    }
+    const StringArena& arena = StringArena::shared();
+    int actorCount = actorTable.size();
+    int movieCount = movieTable.size();
+    std::string text(1, '\0'); // Offset 0 is the empty string.
+
+    ImageActor* actors = new ImageActor[actorCount > 0 ? actorCount : 1];
+    for (int i = 0; i < actorCount; ++i) {
+        const Actor& a = actorTable.at(i);
+        StringHandle name = a.getNameHandle();
+        StringHandle key = a.getNameKey();
+        ImageActor& rec = actors[i];
+        rec.id = a.getId();
+        rec.birthYear = a.getBirthYear();
+        rec.rating = a.getRating();
+        rec.name = appendImageText(text, arena.resolve(name), name.length);
+        rec.key = appendImageText(text, arena.resolve(key), key.length);
+        rec.reserved = 0;
+    }
+
+    // Cast CSR, in the same movie-major cast order as the snapshot.
+    uint32_t* castStart = new uint32_t[movieCount + 1];
+    uint32_t castCount = 0;
+    for (int i = 0; i < movieCount; ++i) {
+        castCount += static_cast<uint32_t>(movieTable.at(i).getActors().getSize());
+    }
+    uint32_t* castActors = new uint32_t[castCount > 0 ? castCount : 1];
+    castCount = 0;
+    ImageMovie* movies = new ImageMovie[movieCount > 0 ? movieCount : 1];
+    std::string plot;
+    bool plotsRead = true;
+    for (int i = 0; i < movieCount; ++i) {
+        const Movie& m = movieTable.at(i);
+        StringHandle title = m.getTitleHandle();
+        StringHandle key = m.getTitleKey();
+        ImageMovie& rec = movies[i];
+        rec.id = m.getId();
+        rec.releaseYear = m.getReleaseYear();
+        rec.rating = m.getRating();
+        rec.title = appendImageText(text, arena.resolve(title), title.length);
+        rec.key = appendImageText(text, arena.resolve(key), key.length);
+        // Copied from the source file so the plot is not loaded into memory.
+        plot.clear();
+        plotsRead = plotsRead && PlotStore::shared().appendTo(m.getPlotRef(), plot);
+        rec.plot = appendImageText(text, plot.data(), plot.size());
+        rec.reserved = 0;
+        castStart[i] = castCount;
+        m.getActors().forEach([&](const Actor& a) -> bool {
+            int actorDenseId = actorTable.indexOf(a.getId());
+            if (actorDenseId != -1) {
+                castActors[castCount++] = static_cast<uint32_t>(actorDenseId);
+            }
+            return false;
+            });
+    }
+    castStart[movieCount] = castCount;
+
+    // Filmography CSR: count per actor, prefix sums, then fill in movie order.
+    uint32_t* filmStart = new uint32_t[actorCount + 1]();
+    for (uint32_t i = 0; i < castCount; ++i) {
+        ++filmStart[castActors[i] + 1];
+    }
+    for (int i = 0; i < actorCount; ++i) {
+        filmStart[i + 1] += filmStart[i];
+    }
+    uint32_t* filmMovies = new uint32_t[castCount > 0 ? castCount : 1];
+    uint32_t* filmFill = new uint32_t[actorCount > 0 ? actorCount : 1];
+    for (int i = 0; i < actorCount; ++i) {
+        filmFill[i] = filmStart[i];
+    }
+    for (int i = 0; i < movieCount; ++i) {
+        for (uint32_t c = castStart[i]; c < castStart[i + 1]; ++c) {
+            filmMovies[filmFill[castActors[c]]++] = static_cast<uint32_t>(i);
+        }
+    }
+    delete[] filmFill;
+
+    // ID, key and rating orders, sorted with the same stable merge sorts as the displays.
+    int* actorIdOrder = new int[actorCount > 0 ? actorCount : 1];
+    int* actorNameOrder = new int[actorCount > 0 ? actorCount : 1];
+    int* actorRatingOrder = new int[actorCount > 0 ? actorCount : 1];
+    int ratedActorCount = 0;
+    const int* actorRatingColumn = actorColumns.getRatings();
+    for (int i = 0; i < actorCount; ++i) {
+        actorIdOrder[i] = i;
+        actorNameOrder[i] = i;
+        if (actorRatingColumn[i] > 0) {
+            actorRatingOrder[ratedActorCount++] = i;
+        }
+    }
+    sortIdsByKey(actorIdOrder, actorCount, actorColumns.getIds());
+    sortIdsByText(actorNameOrder, actorCount, actorColumns.getNameKeys());
+    sortIdsByKey(actorRatingOrder, ratedActorCount, actorRatingColumn);
+
+    int* movieIdOrder = new int[movieCount > 0 ? movieCount : 1];
+    int* movieTitleOrder = new int[movieCount > 0 ? movieCount : 1];
+    int* movieRatingOrder = new int[movieCount > 0 ? movieCount : 1];
+    int ratedMovieCount = 0;
+    const int* movieRatingColumn = movieColumns.getRatings();
+    for (int i = 0; i < movieCount; ++i) {
+        movieIdOrder[i] = i;
+        movieTitleOrder[i] = i;
+        if (movieRatingColumn[i] > 0) {
+            movieRatingOrder[ratedMovieCount++] = i;
+        }
+    }
+    sortIdsByKey(movieIdOrder, movieCount, movieColumns.getIds());
+    sortIdsByText(movieTitleOrder, movieCount, movieColumns.getTitleKeys());
+    sortIdsByKey(movieRatingOrder, ratedMovieCount, movieRatingColumn);
+
+    ImageHeader header = {};
+    header.magic = CATALOG_IMAGE_MAGIC;
+    header.version = CATALOG_IMAGE_VERSION;
+    header.actorCount = static_cast<uint32_t>(actorCount);
+    header.movieCount = static_cast<uint32_t>(movieCount);
+    header.castCount = castCount;
+    header.ratedActorCount = static_cast<uint32_t>(ratedActorCount);
+    header.ratedMovieCount = static_cast<uint32_t>(ratedMovieCount);
+    header.nextActorId = nextActorId;
+    header.nextMovieId = nextMovieId;
+    header.logSequence = logSequence;
+    uint64_t actorIndexBytes = sizeof(uint32_t) * static_cast<uint64_t>(actorCount);
+    uint64_t movieIndexBytes = sizeof(uint32_t) * static_cast<uint64_t>(movieCount);
+    header.actorsOffset = alignSnapshotOffset(sizeof(ImageHeader));
+    header.moviesOffset = alignSnapshotOffset(header.actorsOffset + sizeof(ImageActor) * static_cast<uint64_t>(actorCount));
+    header.actorIdOrderOffset = alignSnapshotOffset(header.moviesOffset + sizeof(ImageMovie) * static_cast<uint64_t>(movieCount));
+    header.movieIdOrderOffset = alignSnapshotOffset(header.actorIdOrderOffset + actorIndexBytes);
+    header.actorNameOrderOffset = alignSnapshotOffset(header.movieIdOrderOffset + movieIndexBytes);
+    header.movieTitleOrderOffset = alignSnapshotOffset(header.actorNameOrderOffset + actorIndexBytes);
+    header.actorRatingOrderOffset = alignSnapshotOffset(header.movieTitleOrderOffset + movieIndexBytes);
+    header.movieRatingOrderOffset = alignSnapshotOffset(header.actorRatingOrderOffset + sizeof(uint32_t) * static_cast<uint64_t>(ratedActorCount));
+    header.castStartOffset = alignSnapshotOffset(header.movieRatingOrderOffset + sizeof(uint32_t) * static_cast<uint64_t>(ratedMovieCount));
+    header.castActorsOffset = alignSnapshotOffset(header.castStartOffset + movieIndexBytes + sizeof(uint32_t));
+    header.filmStartOffset = alignSnapshotOffset(header.castActorsOffset + sizeof(uint32_t) * static_cast<uint64_t>(castCount));
+    header.filmMoviesOffset = alignSnapshotOffset(header.filmStartOffset + actorIndexBytes + sizeof(uint32_t));
+    header.textOffset = alignSnapshotOffset(header.filmMoviesOffset + sizeof(uint32_t) * static_cast<uint64_t>(castCount));
+    header.textBytes = text.size();
+
+    // A plot that could not be copied fails the write rather than being left empty.
+    std::string tempPath = path + ".tmp";
+    std::ofstream out(tempPath.c_str(), std::ios::binary | std::ios::trunc);
+    bool ok = plotsRead && out.is_open();
+    if (ok) {
+        const char padding[8] = { 0 };
+        uint64_t written = 0;
+        auto writeSection = [&](uint64_t offset, const void* bytes, uint64_t size) {
+            out.write(padding, static_cast<std::streamsize>(offset - written));
+            out.write(static_cast<const char*>(bytes), static_cast<std::streamsize>(size));
+            written = offset + size;
+        };
+        // The int order arrays hold non-negative dense IDs, so they are written as uint32.
+        writeSection(0, &header, sizeof(header));
+        writeSection(header.actorsOffset, actors, sizeof(ImageActor) * static_cast<uint64_t>(actorCount));
+        writeSection(header.moviesOffset, movies, sizeof(ImageMovie) * static_cast<uint64_t>(movieCount));
+        writeSection(header.actorIdOrderOffset, actorIdOrder, actorIndexBytes);
+        writeSection(header.movieIdOrderOffset, movieIdOrder, movieIndexBytes);
+        writeSection(header.actorNameOrderOffset, actorNameOrder, actorIndexBytes);
+        writeSection(header.movieTitleOrderOffset, movieTitleOrder, movieIndexBytes);
+        writeSection(header.actorRatingOrderOffset, actorRatingOrder, sizeof(uint32_t) * static_cast<uint64_t>(ratedActorCount));
+        writeSection(header.movieRatingOrderOffset, movieRatingOrder, sizeof(uint32_t) * static_cast<uint64_t>(ratedMovieCount));
+        writeSection(header.castStartOffset, castStart, movieIndexBytes + sizeof(uint32_t));
+        writeSection(header.castActorsOffset, castActors, sizeof(uint32_t) * static_cast<uint64_t>(castCount));
+        writeSection(header.filmStartOffset, filmStart, actorIndexBytes + sizeof(uint32_t));
+        writeSection(header.filmMoviesOffset, filmMovies, sizeof(uint32_t) * static_cast<uint64_t>(castCount));
+        writeSection(header.textOffset, text.data(), text.size());
+        out.close();
+        ok = !out.fail();
+    }
+    delete[] actors;
+    delete[] movies;
+    delete[] castStart;
+    delete[] castActors;
+    delete[] filmStart;
+    delete[] filmMovies;
+    delete[] actorIdOrder;
+    delete[] actorNameOrder;
+    delete[] actorRatingOrder;
+    delete[] movieIdOrder;
+    delete[] movieTitleOrder;
+    delete[] movieRatingOrder;
+
+    if (ok) {
+        std::remove(path.c_str());
+        ok = std::rename(tempPath.c_str(), path.c_str()) == 0;
+    }
+    if (!ok) {
+        std::remove(tempPath.c_str());
+        std::cerr << "[Error] Could not write catalogue image: " << path << "\n";
+    }
+    return ok;
+}
+
+/**
+ * @brief Starts serving queries from a catalogue image.
+ *
+ * @param path The image file.
+ * @return true on success.
+ */
+bool MovieApp::openImage(const std::string& path) {
+    if (actorTable.size() > 0 || movieTable.size() > 0) {
+        std::cerr << "[Error] A catalogue image must be opened before any data is loaded.\n";
+        return false;
+    }
+    if (!image.open(path)) {
+        std::cerr << "[Error] Could not open catalogue image: " << path << "\n";
+        return false;
+    }
+    if (image.getNextActorId() > nextActorId) {
+        nextActorId = image.getNextActorId();
+    }
+    if (image.getNextMovieId() > nextMovieId) {
+        nextMovieId = image.getNextMovieId();
+    }
+    logSequence = image.getLogSequence();
+    return true;
+}
+
+/**
+ * @brief Checks whether queries are served from a catalogue image.
+ *
+ * @return true if an image is open.
+ */
+bool MovieApp::isServingImage() const {
+    return image.isOpen();
+}
+
+/**
+ * @brief Writes the actor and movie records as a compressed archive.
+ *
+ * The writer needs every word count before it can choose its dictionary,
+ * so the tables are walked twice.
+ *
+ * @param path The archive file.
+ * @return true on success.
+ */
+bool MovieApp::writeArchive(const std::string& path) const {
+    if (image.isOpen()) {
+        std::cerr << "[Error] A catalogue archive cannot be written while serving an image.\n";
+        return false;
+    }
+    const StringArena& arena = StringArena::shared();
+    int actorCount = actorTable.size();
+    int movieCount = movieTable.size();
+    CatalogArchiveWriter writer;
+    for (int i = 0; i < actorCount; ++i) {
+        writer.countText(arena.resolve(actorTable.at(i).getNameHandle()));
+    }
+    // Plots are copied from their source file each pass rather than loaded.
+    PlotStore& plots = PlotStore::shared();
+    std::string plot;
+    for (int i = 0; i < movieCount; ++i) {
+        const Movie& m = movieTable.at(i);
+        writer.countText(arena.resolve(m.getTitleHandle()));
+        plot.clear();
+        if (!plots.appendTo(m.getPlotRef(), plot)) {
+            std::cerr << "[Error] Could not write catalogue archive: " << path << "\n";
+            return false;
+        }
+        writer.countText(plot.c_str());
+    }
+    for (int i = 0; i < actorCount; ++i) {
+        const Actor& a = actorTable.at(i);
+        writer.addActor(a.getId(), a.getBirthYear(), a.getRating(), arena.resolve(a.getNameHandle()));
+    }
+    for (int i = 0; i < movieCount; ++i) {
+        const Movie& m = movieTable.at(i);
+        plot.clear();
+        if (!plots.appendTo(m.getPlotRef(), plot)) {
+            std::cerr << "[Error] Could not write catalogue archive: " << path << "\n";
+            return false;
+        }
+        writer.addMovie(m.getId(), m.getReleaseYear(), m.getRating(),
+            arena.resolve(m.getTitleHandle()), plot.c_str());
+    }
+    if (!writer.write(path, nextActorId, nextMovieId)) {
+        std::cerr << "[Error] Could not write catalogue archive: " << path << "\n";
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Starts serving scans from a catalogue archive.
+ *
+ * @param path The archive file.
+ * @return true on success.
+ */
+bool MovieApp::openArchive(const std::string& path) {
+    if (actorTable.size() > 0 || movieTable.size() > 0 || image.isOpen()) {
+        std::cerr << "[Error] A catalogue archive must be opened before any data is loaded.\n";
+        return false;
+    }
+    if (!archive.open(path)) {
+        std::cerr << "[Error] Could not open catalogue archive: " << path << "\n";
+        return false;
+    }
+    if (archive.getNextActorId() > nextActorId) {
+        nextActorId = archive.getNextActorId();
+    }
+    if (archive.getNextMovieId() > nextMovieId) {
+        nextMovieId = archive.getNextMovieId();
+    }
+    return true;
+}
+
+/**
+ * @brief Stops serving scans from the archive.
+ */
+void MovieApp::closeArchive() {
+    archive.close();
+}
+
+/**
+ * @brief Checks whether scans are served from a catalogue archive.
+ *
+ * @return true if an archive is open.
+ */
+bool MovieApp::isServingArchive() const {
+    return archive.isOpen();
+}
+
+/**
+ * @brief Copies an image actor into the overlay (copy-on-write).
+ *
+ * Later reads find the overlay record first, so the image record is hidden
+ * from then on. Outside image mode this is a plain dense ID lookup.
+ *
+ * @param actorId The actor's ID.
+ * @return int The dense ID in actorTable, or -1.
+ */
+int MovieApp::overlayActor(int actorId) {
+    int actorDenseId = actorTable.indexOf(actorId);
+    if (actorDenseId != -1 || !image.isOpen()) {
+        return actorDenseId;
+    }
+    int index = image.findActor(actorId);
+    if (index == -1) {
+        return -1;
+    }
+    Actor actor = actorFromImage(image, image.actorAt(index));
+    actorDenseId = actorTable.insert(actor);
+    actorColumns.set(actorDenseId, actor);
+    if (actor.getRating() > 0) {
+        actorRatings.insert(actor); // Takes over from the image's rating order.
+    }
+    return actorDenseId;
+}
+
+/**
+ * @brief Copies an image movie into the overlay (copy-on-write).
+ *
+ * The overlay movie starts with an empty cast: links from the image stay in
+ * the image and are combined with overlay links when read.
+ *
+ * @param movieId The movie's ID.
+ * @return int The dense ID in movieTable, or -1.
+ */
+int MovieApp::overlayMovie(int movieId) {
+    int movieDenseId = movieTable.indexOf(movieId);
+    if (movieDenseId != -1 || !image.isOpen()) {
+        return movieDenseId;
+    }
+    int index = image.findMovie(movieId);
+    if (index == -1) {
+        return -1;
+    }
+    Movie movie = movieFromImage(image, image.movieAt(index));
+    movieDenseId = movieTable.insert(movie);
+    movieColumns.set(movieDenseId, movie);
+    if (movie.getRating() > 0) {
+        movieRatings.insert(movie);
+    }
+    return movieDenseId;
+}
+
+/**
+ * @brief Returns the slot of an actor.
+ *
+ * @param actorId The actor's ID.
+ * @return int The image record index, the overlay slot, or -1.
+ */
+int MovieApp::actorSlotOf(int actorId) const {
+    int index = image.findActor(actorId);
+    if (index != -1) {
+        return index;
+    }
+    int actorDenseId = actorTable.indexOf(actorId);
+    return (actorDenseId == -1) ? -1 : image.getActorCount() + actorDenseId;
+}
+
+/**
+ * @brief Returns the slot of a movie.
+ *
+ * @param movieId The movie's ID.
+ * @return int The image record index, the overlay slot, or -1.
+ */
+int MovieApp::movieSlotOf(int movieId) const {
+    int index = image.findMovie(movieId);
+    if (index != -1) {
+        return index;
+    }
+    int movieDenseId = movieTable.indexOf(movieId);
+    return (movieDenseId == -1) ? -1 : image.getMovieCount() + movieDenseId;
+}
+
+/**
+ * @brief Returns the current fields of an actor slot.
+ *
+ * @param slot The slot.
+ * @return CatalogActorRow The row.
+ */
+CatalogActorRow MovieApp::actorRowAt(int slot) const {
+    int imageCount = image.getActorCount();
+    int actorDenseId = slot - imageCount;
+    if (slot < imageCount) {
+        const ImageActor& rec = image.actorAt(slot);
+        actorDenseId = actorTable.indexOf(rec.id);
+        if (actorDenseId == -1) {
+            const char* key = image.textOf(rec.key);
+            // textOf() gives "" for a bad reference; keys never start with NUL otherwise.
+            CatalogActorRow row = { rec.id, rec.birthYear, rec.rating, image.textOf(rec.name),
+                key, (key[0] != '\0') ? rec.key.length : 0u };
+            return row;
+        }
+    }
+    const Actor& actor = actorTable.at(actorDenseId);
+    StringHandle key = actor.getNameKey();
+    CatalogActorRow row = { actor.getId(), actor.getBirthYear(), actor.getRating(), actor.getName(),
+        StringArena::shared().resolve(key), key.length };
+    return row;
+}
+
+/**
+ * @brief Returns the current fields of a movie slot.
+ *
+ * @param slot The slot.
+ * @return CatalogMovieRow The row.
+ */
+CatalogMovieRow MovieApp::movieRowAt(int slot) const {
+    int imageCount = image.getMovieCount();
+    int movieDenseId = slot - imageCount;
+    if (slot < imageCount) {
+        const ImageMovie& rec = image.movieAt(slot);
+        movieDenseId = movieTable.indexOf(rec.id);
+        if (movieDenseId == -1) {
+            const char* key = image.textOf(rec.key);
+            CatalogMovieRow row = { rec.id, rec.releaseYear, rec.rating, image.textOf(rec.title),
+                key, (key[0] != '\0') ? rec.key.length : 0u };
+            return row;
+        }
+    }
+    const Movie& movie = movieTable.at(movieDenseId);
+    StringHandle key = movie.getTitleKey();
+    CatalogMovieRow row = { movie.getId(), movie.getReleaseYear(), movie.getRating(), movie.getTitle(),
+        StringArena::shared().resolve(key), key.length };
+    return row;
+}
+
+/**
+ * @brief Returns the plot of a movie slot.
+ *
+ * Image plots are read straight from the mapping.
+ *
+ * @param slot The slot.
+ * @return const char* The plot.
+ */
+const char* MovieApp::moviePlotAt(int slot) const {
+    int imageCount = image.getMovieCount();
+    int movieDenseId = slot - imageCount;
+    if (slot < imageCount) {
+        const ImageMovie& rec = image.movieAt(slot);
+        movieDenseId = movieTable.indexOf(rec.id);
+        if (movieDenseId == -1) {
+            return image.textOf(rec.plot);
+        }
+    }
+    return movieTable.at(movieDenseId).getPlot();
+}
+
+/**
+ * @brief Collects the actor slots of a movie's cast.
+ *
+ * @param movieSlot The movie slot.
+ * @param slots Receives the slots.
+ * @return int The number of slots.
+ */
+int MovieApp::castSlotsOf(int movieSlot, int*& slots) const {
+    int imageCount = 0;
+    const uint32_t* imageCast = image.castOf(movieSlot, imageCount);
+    int movieDenseId = (movieSlot < image.getMovieCount())
+        ? movieTable.indexOf(image.movieAt(movieSlot).id)
+        : movieSlot - image.getMovieCount();
+    const List<Actor>* overlayCast = (movieDenseId != -1) ? &movieTable.at(movieDenseId).getActors() : nullptr;
+    int capacity = imageCount + (overlayCast ? overlayCast->getSize() : 0);
+    slots = new int[capacity > 0 ? capacity : 1];
+    int count = 0;
+    for (int i = 0; i < imageCount; ++i) {
+        if (imageCast[i] < static_cast<uint32_t>(image.getActorCount())) {
+            slots[count++] = static_cast<int>(imageCast[i]);
+        }
+    }
+    if (overlayCast) {
+        overlayCast->forEach([&](const Actor& a) -> bool {
+            int slot = actorSlotOf(a.getId());
+            if (slot != -1) {
+                slots[count++] = slot;
+            }
+            return false;
+            });
+    }
+    return count;
+}
+
+/**
+ * @brief Collects the movie slots of an actor's filmography.
+ *
+ * @param actorSlot The actor slot.
+ * @param slots Receives the slots.
+ * @return int The number of slots.
+ */
+int MovieApp::filmSlotsOf(int actorSlot, int*& slots) const {
+    int imageCount = 0;
+    const uint32_t* imageFilms = image.filmsOf(actorSlot, imageCount);
+    int actorDenseId = (actorSlot < image.getActorCount())
+        ? actorTable.indexOf(image.actorAt(actorSlot).id)
+        : actorSlot - image.getActorCount();
+    const Filmography* films = (actorDenseId != -1 && actorDenseId < filmographyCapacity)
+        ? &filmographies[actorDenseId] : nullptr;
+    int capacity = imageCount + (films ? films->getCount() : 0);
+    slots = new int[capacity > 0 ? capacity : 1];
+    int count = 0;
+    for (int i = 0; i < imageCount; ++i) {
+        if (imageFilms[i] < static_cast<uint32_t>(image.getMovieCount())) {
+            slots[count++] = static_cast<int>(imageFilms[i]);
+        }
+    }
+    for (int i = 0; films && i < films->getCount(); ++i) {
+        int slot = movieSlotOf(movieTable.at(films->getMovieIdAt(i)).getId());
+        if (slot != -1) {
+            slots[count++] = slot;
+        }
+    }
+    return count;
 }
 
 /**
- * @brief Merge sort helper for sorting Actor objects by age in ascending order.
+ * @brief Stable merge sort of slots with a caller-supplied ordering.
  *
- * @param arr The array of Actor objects.
+ * @param slots The slots to sort.
+ * @param temp Scratch buffer with room for at least right + 1 entries.
  * @param left The left index.
  * @param right The right index.
+ * @param before Returns true if the first slot must come before the second.
  */
-static void mergeSortActorsByAge(Actor* arr, int left, int right) {
+template <typename Before>
+static void mergeSortSlots(int* slots, int* temp, int left, int right, const Before& before) {
     if (left >= right) return;
     int mid = (left + right) / 2;
-    mergeSortActorsByAge(arr, left, mid);
-    mergeSortActorsByAge(arr, mid + 1, right);
-    int size = right - left + 1;
-    Actor* temp = new Actor[size];
-    int i = left, j = mid + 1, k = 0;
+    mergeSortSlots(slots, temp, left, mid, before);
+    mergeSortSlots(slots, temp, mid + 1, right, before);
+    int i = left, j = mid + 1, k = left;
     while (i <= mid && j <= right) {
-        if (arr[i].getAge() <= arr[j].getAge()) {
-            temp[k++] = arr[i++];
+        if (!before(slots[j], slots[i])) {
+            temp[k++] = slots[i++];
         }
         else {
-            temp[k++] = arr[j++];
+            temp[k++] = slots[j++];
         }
     }
     while (i <= mid) {
-        temp[k++] = arr[i++];
+        temp[k++] = slots[i++];
     }
     while (j <= right) {
-        temp[k++] = arr[j++];
+        temp[k++] = slots[j++];
     }
-    for (int p = 0; p < size; ++p) {
-        arr[left + p] = temp[p];
+    for (int p = left; p <= right; ++p) {
+        slots[p] = temp[p];
     }
+}
+
+/**
+ * @brief Sorts slots with a caller-supplied ordering.
+ *
+ * @param slots The slots.
+ * @param count Number of slots.
+ * @param before Returns true if the first slot must come before the second.
+ */
+template <typename Before>
+static void sortSlots(int* slots, int count, const Before& before) {
+    if (count < 2) return;
+    int* temp = new int[count];
+    mergeSortSlots(slots, temp, 0, count - 1, before);
     delete[] temp;
 }
 
 /**
- * @brief Merge sort helper for sorting Actor objects alphabetically by name.
+ * @brief Orders two collation keys given as text.
  *
- * @param arr The array of Actor objects.
- * @param left The left index.
- * @param right The right index.
+ * @param a The first key.
+ * @param aLength Length of the first key.
+ * @param b The second key.
+ * @param bLength Length of the second key.
+ * @return int Negative, zero or positive, like compareCollationKeys().
  */
-static void mergeSortActors(Actor* arr, int left, int right) {
-    if (left >= right) return;
-    int mid = (left + right) / 2;
-    mergeSortActors(arr, left, mid);
-    mergeSortActors(arr, mid + 1, right);
-    int size = right - left + 1;
-    Actor* temp = new Actor[size];
-    int i = left, j = mid + 1, k = 0;
-    while (i <= mid && j <= right) {
-        if (caseInsensitiveCompareStrings(arr[i].getName(), arr[j].getName()) <= 0) {
-            temp[k++] = arr[i++];
-        }
-        else {
-            temp[k++] = arr[j++];
+static int compareKeyText(const char* a, unsigned int aLength, const char* b, unsigned int bLength) {
+    unsigned int n = (aLength < bLength) ? aLength : bLength;
+    int cmp = std::memcmp(a, b, n);
+    if (cmp != 0) {
+        return cmp;
+    }
+    if (aLength < bLength) return -1;
+    if (aLength > bLength) return 1;
+    return 0;
+}
+
+/**
+ * @brief Prints an actor row in the format of Actor::displayDetails().
+ *
+ * @param row The row.
+ */
+static void displayActorRow(const CatalogActorRow& row) {
+    std::cout << "Actor ID: " << row.id
+        << ", Name: " << row.name
+        << ", Birth Year: " << row.birthYear
+        << ", Age: " << Actor::ageForBirthYear(row.birthYear)
+        << ", Rating: " << row.rating
+        << std::endl;
+}
+
+/**
+ * @brief Prints a movie row in the format of Movie::displayDetails().
+ *
+ * @param row The row.
+ * @param plot The movie's plot.
+ */
+static void displayMovieRow(const CatalogMovieRow& row, const char* plot) {
+    std::cout << "Movie ID: " << row.id
+        << ", Title: " << row.title
+        << ", Plot: " << plot
+        << ", Year: " << row.releaseYear
+        << ", Rating: " << row.rating
+        << std::endl;
+}
+
+/**
+ * @brief Collects every actor slot whose name matches a search name.
+ *
+ * Image records come from a binary search of the name order; overlay
+ * records are found by scanning the (small) overlay key column.
+ *
+ * @param name The search name.
+ * @param slots Receives the matching slots in slot order.
+ * @return int The number of matches.
+ */
+int MovieApp::actorSlotsNamed(const std::string& name, int*& slots) const {
+    std::string key;
+    foldCase(name.c_str(), key);
+    int first = 0;
+    int imageMatches = image.actorsWithKey(key, first);
+    int overlayCount = actorColumns.size();
+    StringHandle overlayKey;
+    bool inOverlay = findCollationKey(name.c_str(), overlayKey);
+    slots = new int[imageMatches + overlayCount > 0 ? imageMatches + overlayCount : 1];
+    int count = 0;
+    const uint32_t* order = image.getActorNameOrder();
+    for (int p = first; p < first + imageMatches; ++p) {
+        int index = static_cast<int>(order[p]);
+        if (actorTable.indexOf(image.actorAt(index).id) == -1) {
+            slots[count++] = index; // Replaced records are matched by their overlay key below.
         }
     }
-    while (i <= mid) {
-        temp[k++] = arr[i++];
-    }
-    while (j <= right) {
-        temp[k++] = arr[j++];
-    }
-    for (int p = 0; p < size; ++p) {
-        arr[left + p] = temp[p];
+    if (inOverlay) {
+        const StringHandle* nameKeys = actorColumns.getNameKeys();
+        const int* ids = actorColumns.getIds();
+        for (int i = 0; i < overlayCount; ++i) {
+            if (sameCollationKey(nameKeys[i], overlayKey)) {
+                slots[count++] = actorSlotOf(ids[i]);
+            }
+        }
     }
-    delete[] temp;
+    sortSlots(slots, count, [](int a, int b) { return a < b; });
+    return count;
 }
 
 /**
- * @brief Displays all actors sorted alphabetically by name with pagination.
+ * @brief Finds the first movie slot whose title matches a search title.
+ *
+ * @param title The search title.
+ * @return int The lowest matching slot, or -1.
  */
-void MovieApp::displayAllActors() const {
-    if (actorTable.isEmpty()) {
-        std::cout << "No actors found.\n";
-        return;
+int MovieApp::movieSlotTitled(const std::string& title) const {
+    std::string key;
+    foldCase(title.c_str(), key);
+    int found = -1;
+    int first = 0;
+    int imageMatches = image.moviesWithKey(key, first);
+    const uint32_t* order = image.getMovieTitleOrder();
+    for (int p = first; p < first + imageMatches; ++p) {
+        int index = static_cast<int>(order[p]);
+        if (movieTable.indexOf(image.movieAt(index).id) == -1 && (found == -1 || index < found)) {
+            found = index;
+        }
     }
-    int capacity = 100, count = 0;
-    Actor* arr = new Actor[capacity];
-    actorTable.forEach([&](const Actor& a) -> bool {
-        if (count >= capacity) {
-            int newCapacity = capacity * 2;
-            Actor* newArr = new Actor[newCapacity];
-            for (int i = 0; i < count; i++) {
-                newArr[i] = arr[i];
+    StringHandle overlayKey;
+    if (findCollationKey(title.c_str(), overlayKey)) {
+        int overlayCount = movieColumns.size();
+        const StringHandle* titleKeys = movieColumns.getTitleKeys();
+        const int* ids = movieColumns.getIds();
+        for (int i = 0; i < overlayCount; ++i) {
+            if (sameCollationKey(titleKeys[i], overlayKey)) {
+                int slot = movieSlotOf(ids[i]);
+                if (found == -1 || slot < found) {
+                    found = slot;
+                }
             }
-            delete[] arr;
-            arr = newArr;
-            capacity = newCapacity;
         }
-        arr[count++] = a;
+    }
+    return found;
+}
+
+/**
+ * @brief Checks whether the image links an actor to a movie.
+ *
+ * @param actorId The actor's ID.
+ * @param movieId The movie's ID.
+ * @return true if the image has the link.
+ */
+bool MovieApp::imageHasLink(int actorId, int movieId) const {
+    int actorIndex = image.findActor(actorId);
+    int movieIndex = image.findMovie(movieId);
+    if (actorIndex == -1 || movieIndex == -1) {
         return false;
-        });
-    if (count == 0) {
+    }
+    int count = 0;
+    const uint32_t* films = image.filmsOf(actorIndex, count);
+    for (int i = 0; i < count; ++i) {
+        if (films[i] == static_cast<uint32_t>(movieIndex)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Displays all actors alphabetically from the image and overlay.
+ *
+ * The image's name order is already sorted; only the overlay records are
+ * sorted here and merged in. Ties are broken by slot, which gives the same
+ * order as the in-memory display.
+ */
+void MovieApp::displayAllActorsFromImage() const {
+    int imageCount = image.getActorCount();
+    int overlayCount = actorColumns.size();
+    if (imageCount + overlayCount == 0) {
         std::cout << "No actors found.\n";
-        delete[] arr;
         return;
     }
-    mergeSortActors(arr, 0, count - 1);
+    auto before = [this](int a, int b) {
+        CatalogActorRow ra = actorRowAt(a);
+        CatalogActorRow rb = actorRowAt(b);
+        int cmp = compareKeyText(ra.key, ra.keyLength, rb.key, rb.keyLength);
+        return cmp < 0 || (cmp == 0 && a < b);
+    };
+    int* overlaySlots = new int[overlayCount > 0 ? overlayCount : 1];
+    const int* ids = actorColumns.getIds();
+    for (int i = 0; i < overlayCount; ++i) {
+        overlaySlots[i] = actorSlotOf(ids[i]);
+    }
+    sortSlots(overlaySlots, overlayCount, before);
+    const uint32_t* order = image.getActorNameOrder();
     std::cout << "All Actors (alphabetical):\n";
     const int pageSize = 8000;
     int linesPrinted = 0;
-    for (int i = 0; i < count; i++) {
-        arr[i].displayDetails();
+    int i = 0, j = 0;
+    while (true) {
+        while (i < imageCount && actorTable.indexOf(image.actorAt(static_cast<int>(order[i])).id) != -1) {
+            ++i; // Replaced by an overlay record, which is merged in at its own key.
+        }
+        if (i >= imageCount && j >= overlayCount) {
+            break;
+        }
+        int slot;
+        if (i < imageCount && (j >= overlayCount || before(static_cast<int>(order[i]), overlaySlots[j]))) {
+            slot = static_cast<int>(order[i++]);
+        }
+        else {
+            slot = overlaySlots[j++];
+        }
+        if (linesPrinted > 0 && linesPrinted % pageSize == 0) {
+            std::cout << "\n-- Press Enter to continue --";
+            std::cout.flush();
+            std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+            std::cout << "\n";
+        }
+        displayActorRow(actorRowAt(slot));
         linesPrinted++;
-        if (linesPrinted % pageSize == 0 && i < count - 1) {
+    }
+    delete[] overlaySlots;
+}
+
+/**
+ * @brief Displays all movies alphabetically from the image and overlay.
+ */
+void MovieApp::displayAllMoviesFromImage() const {
+    int imageCount = image.getMovieCount();
+    int overlayCount = movieColumns.size();
+    if (imageCount + overlayCount == 0) {
+        std::cout << "No movies found.\n";
+        return;
+    }
+    auto before = [this](int a, int b) {
+        CatalogMovieRow ra = movieRowAt(a);
+        CatalogMovieRow rb = movieRowAt(b);
+        int cmp = compareKeyText(ra.key, ra.keyLength, rb.key, rb.keyLength);
+        return cmp < 0 || (cmp == 0 && a < b);
+    };
+    int* overlaySlots = new int[overlayCount > 0 ? overlayCount : 1];
+    const int* ids = movieColumns.getIds();
+    for (int i = 0; i < overlayCount; ++i) {
+        overlaySlots[i] = movieSlotOf(ids[i]);
+    }
+    sortSlots(overlaySlots, overlayCount, before);
+    const uint32_t* order = image.getMovieTitleOrder();
+    std::cout << "All Movies (alphabetical):\n";
+    const int pageSize = 8000; // Movies per page.
+    int linesPrinted = 0;
+    int i = 0, j = 0;
+    while (true) {
+        while (i < imageCount && movieTable.indexOf(image.movieAt(static_cast<int>(order[i])).id) != -1) {
+            ++i;
+        }
+        if (i >= imageCount && j >= overlayCount) {
+            break;
+        }
+        int slot;
+        if (i < imageCount && (j >= overlayCount || before(static_cast<int>(order[i]), overlaySlots[j]))) {
+            slot = static_cast<int>(order[i++]);
+        }
+        else {
+            slot = overlaySlots[j++];
+        }
+        if (linesPrinted > 0 && linesPrinted % pageSize == 0) {
             std::cout << "\n-- Press Enter to continue --";
             std::cout.flush();
             std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
             std::cout << "\n";
         }
+        displayMovieRow(movieRowAt(slot), moviePlotAt(slot));
+        linesPrinted++;
     }
-    delete[] arr;
+    delete[] overlaySlots;
 }
 
 /**
- * @brief Displays actors whose ages fall within a given range, sorted by age.
+ * @brief Displays actors in an age range from the image and overlay, sorted by age.
  *
  * @param minAge The minimum age.
  * @param maxAge The maximum age.
  */
-void MovieApp::displayActorsByAge(int minAge, int maxAge) const {
-    int capacity = 100, count = 0;
-    Actor* actorsInRange = new Actor[capacity];
-    actorTable.forEach([&](const Actor& a) -> bool {
-        int age = a.getAge();
-        if (age >= minAge && age <= maxAge) {
-            if (count >= capacity) {
-                int newCapacity = capacity * 2;
-                Actor* newArr = new Actor[newCapacity];
-                for (int i = 0; i < count; i++) {
-                    newArr[i] = actorsInRange[i];
-                }
-                delete[] actorsInRange;
-                actorsInRange = newArr;
-                capacity = newCapacity;
-            }
-            actorsInRange[count++] = a;
+void MovieApp::displayActorsByAgeFromImage(int minAge, int maxAge) const {
+    int imageCount = image.getActorCount();
+    int slotCount = imageCount + actorColumns.size();
+    int minBirth = Actor::ageForBirthYear(0) - maxAge;
+    int maxBirth = Actor::ageForBirthYear(0) - minAge;
+    int* slots = new int[slotCount > 0 ? slotCount : 1];
+    int* ageKey = new int[slotCount > 0 ? slotCount : 1];
+    int count = 0;
+    const int* ids = actorColumns.getIds();
+    for (int slot = 0; slot < slotCount; ++slot) {
+        if (slot >= imageCount && image.findActor(ids[slot - imageCount]) != -1) {
+            continue; // Overlay copy of an image record; seen at its image slot.
         }
-        return false;
-        });
+        CatalogActorRow row = actorRowAt(slot);
+        if (row.birthYear >= minBirth && row.birthYear <= maxBirth) {
+            ageKey[slot] = Actor::ageForBirthYear(row.birthYear);
+            slots[count++] = slot;
+        }
+    }
     if (count == 0) {
         std::cout << "No actors found in age range [" << minAge << ", " << maxAge << "].\n";
-        delete[] actorsInRange;
+        delete[] ageKey;
+        delete[] slots;
         return;
     }
-    mergeSortActorsByAge(actorsInRange, 0, count - 1);
+    sortIdsByKey(slots, count, ageKey);
     std::cout << "Actors in age range [" << minAge << ", " << maxAge << "] (sorted by age):\n";
     for (int i = 0; i < count; ++i) {
-        std::cout << actorsInRange[i].getName() << " (Age=" << actorsInRange[i].getAge() << ")\n";
+        std::cout << actorRowAt(slots[i]).name << " (Age=" << ageKey[slots[i]] << ")\n";
     }
-    delete[] actorsInRange;
+    delete[] ageKey;
+    delete[] slots;
 }
 
 /**
- * @brief Merge sort helper for sorting Movie objects by release year.
+ * @brief Displays movies released since a cutoff year from the image and overlay.
  *
- * @param arr The array of Movie objects.
- * @param left The left index.
- * @param right The right index.
+ * @param cutoff The earliest release year shown.
  */
-static void mergeSortMoviesByYear(Movie* arr, int left, int right) {
-    if (left >= right) return;
-    int mid = (left + right) / 2;
-    mergeSortMoviesByYear(arr, left, mid);
-    mergeSortMoviesByYear(arr, mid + 1, right);
-    int size = right - left + 1;
-    Movie* temp = new Movie[size];
-    int i = left, j = mid + 1, k = 0;
-    while (i <= mid && j <= right) {
-        if (arr[i].getReleaseYear() <= arr[j].getReleaseYear()) {
-            temp[k++] = arr[i++];
+void MovieApp::displayRecentMoviesFromImage(int cutoff) const {
+    int imageCount = image.getMovieCount();
+    int slotCount = imageCount + movieColumns.size();
+    int* slots = new int[slotCount > 0 ? slotCount : 1];
+    int* years = new int[slotCount > 0 ? slotCount : 1];
+    int count = 0;
+    const int* ids = movieColumns.getIds();
+    for (int slot = 0; slot < slotCount; ++slot) {
+        if (slot >= imageCount && image.findMovie(ids[slot - imageCount]) != -1) {
+            continue;
         }
-        else {
-            temp[k++] = arr[j++];
+        CatalogMovieRow row = movieRowAt(slot);
+        if (row.releaseYear >= cutoff) {
+            years[slot] = row.releaseYear;
+            slots[count++] = slot;
         }
     }
-    while (i <= mid) {
-        temp[k++] = arr[i++];
-    }
-    while (j <= right) {
-        temp[k++] = arr[j++];
-    }
-    for (int p = 0; p < size; ++p) {
-        arr[left + p] = temp[p];
-    }
-    delete[] temp;
-}
-
-/**
- * @brief Displays recent movies (released within the last 3 years) sorted by release year.
- */
-void MovieApp::displayRecentMovies() const {
-    time_t now = time(0);
-    struct tm localTime;
-    localtime_s(&localTime, &now);
-    int currentYear = localTime.tm_year + 1900;
-    int cutoff = currentYear - 3;
-    int capacity = 100, count = 0;
-    Movie* recentMovies = new Movie[capacity];
-    movieTable.forEach([&](const Movie& m) -> bool {
-        if (m.getReleaseYear() >= cutoff) {
-            if (count >= capacity) {
-                int newCapacity = capacity * 2;
-                Movie* newArr = new Movie[newCapacity];
-                for (int i = 0; i < count; i++) {
-                    newArr[i] = recentMovies[i];
-                }
-                delete[] recentMovies;
-                recentMovies = newArr;
-                capacity = newCapacity;
-            }
-            recentMovies[count++] = m;
-        }
-        return false;
-        });
     if (count == 0) {
         std::cout << "No movies found in the last 3 years.\n";
-        delete[] recentMovies;
+        delete[] years;
+        delete[] slots;
         return;
     }
-    mergeSortMoviesByYear(recentMovies, 0, count - 1);
+    sortIdsByKey(slots, count, years);
     std::cout << "Recent Movies (in ascending order of release year):\n";
     for (int i = 0; i < count; ++i) {
-        std::cout << recentMovies[i].getTitle()
-            << " (" << recentMovies[i].getReleaseYear() << ")\n";
+        std::cout << movieRowAt(slots[i]).title << " (" << years[slots[i]] << ")\n";
     }
-    delete[] recentMovies;
+    delete[] years;
+    delete[] slots;
 }
 
 /**
- * @brief Displays movies featuring a given actor.
- *
- * Searches for movies in which the actor (identified by actorId) appears, sorts
- * them alphabetically by title, and displays the results.
+ * @brief Displays an actor's movies from the image and overlay.
  *
  * @param actorId The actor's ID.
  */
-void MovieApp::displayMoviesOfActor(int actorId) const {
-    Actor* actPtr = actorTable.find(actorId);
-    if (!actPtr) {
+void MovieApp::displayMoviesOfActorFromImage(int actorId) const {
+    int actorSlot = actorSlotOf(actorId);
+    if (actorSlot == -1) {
         std::cout << "Actor ID " << actorId << " not found.\n";
         return;
     }
-    int capacity = 100, count = 0;
-    Movie* arr = new Movie[capacity];
-    movieTable.forEach([&](const Movie& m) -> bool {
-        if (m.hasActor(actorId)) {
-            if (count >= capacity) {
-                int newCapacity = capacity * 2;
-                Movie* newArr = new Movie[newCapacity];
-                for (int i = 0; i < count; i++) {
-                    newArr[i] = arr[i];
-                }
-                delete[] arr;
-                arr = newArr;
-                capacity = newCapacity;
-            }
-            arr[count++] = m;
-        }
-        return false;
-        });
+    int* slots = nullptr;
+    int count = filmSlotsOf(actorSlot, slots);
     if (count == 0) {
         std::cout << "No movies found for actor ID " << actorId << ".\n";
-        delete[] arr;
+        delete[] slots;
         return;
     }
-    mergeSortMovies(arr, 0, count - 1);
+    sortSlots(slots, count, [this](int a, int b) {
+        CatalogMovieRow ra = movieRowAt(a);
+        CatalogMovieRow rb = movieRowAt(b);
+        int cmp = compareKeyText(ra.key, ra.keyLength, rb.key, rb.keyLength);
+        return cmp < 0 || (cmp == 0 && a < b);
+        });
     std::cout << "Movies for actor ID " << actorId << ":\n";
     for (int i = 0; i < count; ++i) {
-        std::cout << " - " << arr[i].getTitle()
-            << " (" << arr[i].getReleaseYear() << ")\n";
+        CatalogMovieRow row = movieRowAt(slots[i]);
+        std::cout << " - " << row.title << " (" << row.releaseYear << ")\n";
     }
-    delete[] arr;
+    delete[] slots;
 }
 
 /**
- * @brief Displays actors in a movie specified by title.
+ * @brief Displays the cast of a movie from the image and overlay.
  *
- * Searches for a movie with a matching title (case-insensitive), sorts its cast
- * alphabetically by name, and displays the actor names and ages.
- *
- * @param movieTitle The title of the movie.
+ * @param movieTitle The movie's title.
  */
-void MovieApp::displayActorsInMovie(const std::string& movieTitle) const {
-    bool foundMovie = false;
-    movieTable.forEach([&](const Movie& m) -> bool {
-        if (caseInsensitiveCompareStrings(m.getTitle(), movieTitle.c_str()) == 0) {
-            foundMovie = true;
-            int capacity = 100, count = 0;
-            Actor* actorArr = new Actor[capacity];
-            m.getActors().forEach([&](const Actor& a) -> bool {
-                if (count >= capacity) {
-                    int newCapacity = capacity * 2;
-                    Actor* newArr = new Actor[newCapacity];
-                    for (int i = 0; i < count; i++) {
-                        newArr[i] = actorArr[i];
-                    }
-                    delete[] actorArr;
-                    actorArr = newArr;
-                    capacity = newCapacity;
-                }
-                actorArr[count++] = a;
-                return false;
-                });
-            mergeSortActors(actorArr, 0, count - 1);
-            std::cout << "Actors in \"" << movieTitle << "\":\n";
-            for (int i = 0; i < count; ++i) {
-                std::cout << " - " << actorArr[i].getName()
-                    << " (Age: " << actorArr[i].getAge() << ")\n";
-            }
-            delete[] actorArr;
-            return true; // Stop iteration after matching movie is found.
-        }
-        return false;
-        });
-    if (!foundMovie) {
+void MovieApp::displayActorsInMovieFromImage(const std::string& movieTitle) const {
+    int movieSlot = movieSlotTitled(movieTitle);
+    if (movieSlot == -1) {
         std::cout << "Movie \"" << movieTitle << "\" not found.\n";
+        return;
     }
+    int* slots = nullptr;
+    int count = castSlotsOf(movieSlot, slots);
+    sortSlots(slots, count, [this](int a, int b) {
+        CatalogActorRow ra = actorRowAt(a);
+        CatalogActorRow rb = actorRowAt(b);
+        int cmp = compareKeyText(ra.key, ra.keyLength, rb.key, rb.keyLength);
+        return cmp < 0 || (cmp == 0 && a < b);
+        });
+    std::cout << "Actors in \"" << movieTitle << "\":\n";
+    for (int i = 0; i < count; ++i) {
+        CatalogActorRow row = actorRowAt(slots[i]);
+        std::cout << " - " << row.name
+            << " (Age: " << Actor::ageForBirthYear(row.birthYear) << ")\n";
+    }
+    delete[] slots;
 }
 
 /**
- * @brief Displays actors known by a given actor (up to 2 levels).
+ * @brief Displays actors known by an actor (up to 2 levels) from the image and overlay.
  *
- * Finds the actor by name, builds the actor graph, and uses breadth-first search
- * to determine which actors are connected within 2 levels.
+ * No graph is built: the neighbors of each visited actor are read from the
+ * filmography and cast indexes, and the search borrows the actor graph's
+ * visit stamps, discovery order and queue.
  *
- * @param actorName The name of the starting actor.
+ * @param actorName The starting actor's name.
  */
-void MovieApp::displayActorsKnownBy(const std::string& actorName) const {
-    int startActorId = -1;
-    actorTable.forEach([&](const Actor& a) -> bool {
-        if (caseInsensitiveCompareStrings(a.getName(), actorName.c_str()) == 0) {
-            startActorId = a.getId();
-            return true; // Stop once found.
-        }
-        return false;
-        });
-    if (startActorId == -1) {
+void MovieApp::displayActorsKnownByFromImage(const std::string& actorName) const {
+    int* matches = nullptr;
+    int matchCount = actorSlotsNamed(actorName, matches);
+    int startSlot = (matchCount > 0) ? matches[0] : -1;
+    delete[] matches;
+    if (startSlot == -1) {
         std::cout << "[Error] Actor \"" << actorName << "\" not found.\n";
         return;
     }
-    int* actorIds = nullptr;
-    List<int>* adjacencyLists = nullptr;
-    int totalActors = 0;
-    ActorGraph::buildActorGraph(actorTable, movieTable, actorIds, totalActors, adjacencyLists);
-    int startIndex = ActorGraph::findActorIndexInArray(startActorId, actorIds, totalActors);
-    if (startIndex == -1) {
-        std::cout << "[Error] Could not map actor to index.\n";
-        delete[] adjacencyLists;
-        delete[] actorIds;
-        return;
-    }
-    List<int> discovered = ActorGraph::findConnectedActors(startIndex, adjacencyLists, totalActors, 2);
+    int slotCount = image.getActorCount() + actorColumns.size();
+    List<int> discovered = actorGraph.findConnectedActors(startSlot, slotCount, 2,
+        [this](int actorSlot, const std::function<void(int)>& adjacent) {
+            int* films = nullptr;
+            int filmCount = filmSlotsOf(actorSlot, films);
+            for (int f = 0; f < filmCount; ++f) {
+                int* cast = nullptr;
+                int castCount = castSlotsOf(films[f], cast);
+                for (int c = 0; c < castCount; ++c) {
+                    if (cast[c] != actorSlot) {
+                        adjacent(cast[c]);
+                    }
+                }
+                delete[] cast;
+            }
+            delete[] films;
+        });
     if (discovered.isEmpty()) {
         std::cout << "No actors found that \"" << actorName << "\" knows (up to 2 levels).\n";
-        delete[] adjacencyLists;
-        delete[] actorIds;
         return;
     }
     std::cout << "Actors known by \"" << actorName << "\" (up to 2 levels):\n";
-    discovered.forEach([&](int idx) {
-        if (idx < 0 || idx >= totalActors) return false;
-        int realActorId = actorIds[idx];
-        Actor* aPtr = actorTable.find(realActorId);
-        if (aPtr) {
-            std::cout << " - " << aPtr->getName() << "\n";
-        }
+    discovered.forEach([&](int slot) {
+        std::cout << " - " << actorRowAt(slot).name << "\n";
         return false;
         });
-    delete[] adjacencyLists;
-    delete[] actorIds;
 }
 
-// ---------------------------------------------------------------------------
-// Rating and Recommendation Methods
-// ---------------------------------------------------------------------------
-
 /**
- * @brief Sets the rating for an actor.
+ * @brief Displays movies in a rating range from the image and overlay.
  *
- * Validates the rating value, updates the actor's rating, and re-inserts the
- * updated actor into the hash table.
+ * For each rating, image movies come first (in dense ID order), then the
+ * overlay's rating tree, matching the in-memory tree's insertion order.
  *
- * @param actorId The actor's ID.
- * @param rating The new rating (1-10).
+ * @param minRating The minimum rating.
+ * @param maxRating The maximum rating.
  */
-void MovieApp::setActorRating(int actorId, int rating) {
-    if (rating < 1 || rating > 10) {
-        std::cout << "[Error] Invalid rating. Must be between 1 and 10.\n";
-        return;
-    }
-    Actor* a = actorTable.find(actorId);
-    if (!a) {
-        std::cout << "[Error] Actor ID " << actorId << " not found.\n";
-        return;
+void MovieApp::recommendMoviesFromImage(int minRating, int maxRating) const {
+    // Ratings are always 1-10 (see setMovieRating).
+    int low = (minRating > 1) ? minRating : 1;
+    int high = (maxRating < 10) ? maxRating : 10;
+    for (int rating = low; rating <= high; ++rating) {
+        int count = 0;
+        const uint32_t* rated = image.moviesWithRating(rating, count);
+        for (int i = 0; i < count; ++i) {
+            int slot = static_cast<int>(rated[i]);
+            if (movieTable.indexOf(image.movieAt(slot).id) == -1) {
+                displayMovieRow(movieRowAt(slot), moviePlotAt(slot));
+            }
+        }
+        movieRatings.displayMoviesInRange(rating, rating);
     }
-    a->setRating(rating);
-    actorRatings.insert(*a);
-    actorTable.insert(*a);
-    std::cout << "[Success] Actor (ID=" << actorId << ") rating updated to " << rating << "\n";
 }
 
 /**
- * @brief Sets the rating for a movie.
+ * @brief Displays actors in a rating range from the image and overlay.
  *
- * Validates the rating value, updates the movie's rating, and re-inserts the
- * updated movie into the hash table.
- *
- * @param movieId The movie's ID.
- * @param rating The new rating (1-10).
+ * @param minRating The minimum rating.
+ * @param maxRating The maximum rating.
  */
-void MovieApp::setMovieRating(int movieId, int rating) {
-    if (rating < 1 || rating > 10) {
-        std::cout << "[Error] Invalid rating. Must be between 1 and 10.\n";
-        return;
-    }
-    Movie* m = movieTable.find(movieId);
-    if (!m) {
-        std::cout << "[Error] Movie ID " << movieId << " not found.\n";
-        return;
+void MovieApp::recommendActorsFromImage(int minRating, int maxRating) const {
+    // Ratings are always 1-10 (see setActorRating).
+    int low = (minRating > 1) ? minRating : 1;
+    int high = (maxRating < 10) ? maxRating : 10;
+    for (int rating = low; rating <= high; ++rating) {
+        int count = 0;
+        const uint32_t* rated = image.actorsWithRating(rating, count);
+        for (int i = 0; i < count; ++i) {
+            int slot = static_cast<int>(rated[i]);
+            if (actorTable.indexOf(image.actorAt(slot).id) == -1) {
+                displayActorRow(actorRowAt(slot));
+            }
+        }
+        actorRatings.displayActorsInRange(rating, rating);
     }
-    m->setRating(rating);
-    movieRatings.insert(*m);
-    movieTable.insert(*m);
-    std::cout << "[Success] Movie (ID=" << movieId << ") rating updated to " << rating << "\n";
 }
 
+// ---------------------------------------------------------------------------
+// Archive Mode Helpers
+// ---------------------------------------------------------------------------
+//
+// Archive rows are in dense ID order, so the same stable sorts as the table
+// scans give the same output. Only the year column is decoded in full; names
+// and titles are decoded for the matching rows only.
+
 /**
- * @brief Recommends movies within a specified rating range.
+ * @brief Displays actors in an age range from the archive, sorted by age.
  *
- * Displays movies from the movieRatings hash table that have ratings between
- * minRating and maxRating.
- *
- * @param minRating The minimum rating.
- * @param maxRating The maximum rating.
+ * @param minAge The minimum age.
+ * @param maxAge The maximum age.
  */
-void MovieApp::recommendMoviesByRating(int minRating, int maxRating) const {
-    std::cout << "Movies with rating between " << minRating << " and " << maxRating << ":\n";
-    movieRatings.displayMoviesInRange(minRating, maxRating);
+void MovieApp::displayActorsByAgeFromArchive(int minAge, int maxAge) const {
+    int total = archive.getActorCount();
+    int* birthYears = new int[total > 0 ? total : 1];
+    archive.decodeColumn(ARCHIVE_ACTOR_BIRTH_YEARS, birthYears);
+    int minBirth = Actor::ageForBirthYear(0) - maxAge;
+    int maxBirth = Actor::ageForBirthYear(0) - minAge;
+    int count = 0;
+    int* rows = new int[total > 0 ? total : 1];
+    for (int i = 0; i < total; ++i) {
+        if (birthYears[i] >= minBirth && birthYears[i] <= maxBirth) {
+            rows[count++] = i;
+        }
+    }
+    if (count == 0) {
+        std::cout << "No actors found in age range [" << minAge << ", " << maxAge << "].\n";
+        delete[] rows;
+        delete[] birthYears;
+        return;
+    }
+    // The birth year column is reused as the age key.
+    for (int i = 0; i < count; ++i) {
+        birthYears[rows[i]] = Actor::ageForBirthYear(birthYears[rows[i]]);
+    }
+    sortIdsByKey(rows, count, birthYears);
+    std::cout << "Actors in age range [" << minAge << ", " << maxAge << "] (sorted by age):\n";
+    for (int i = 0; i < count; ++i) {
+        std::cout << archive.textAt(ARCHIVE_ACTOR_NAMES, rows[i]) << " (Age=" << birthYears[rows[i]] << ")\n";
+    }
+    delete[] rows;
+    delete[] birthYears;
 }
 
 /**
- * @brief Recommends actors within a specified rating range.
- *
- * Displays actors from the actorRatings hash table that have ratings between
- * minRating and maxRating.
+ * @brief Displays movies released since a cutoff year from the archive.
  *
- * @param minRating The minimum rating.
- * @param maxRating The maximum rating.
+ * @param cutoff The earliest release year shown.
  */
-void MovieApp::recommendActorsByRating(int minRating, int maxRating) const {
-    std::cout << "Actors with rating between " << minRating << " and " << maxRating << ":\n";
-    actorRatings.displayActorsInRange(minRating, maxRating);
+void MovieApp::displayRecentMoviesFromArchive(int cutoff) const {
+    int total = archive.getMovieCount();
+    int* years = new int[total > 0 ? total : 1];
+    archive.decodeColumn(ARCHIVE_MOVIE_YEARS, years);
+    int count = 0;
+    int* rows = new int[total > 0 ? total : 1];
+    for (int i = 0; i < total; ++i) {
+        if (years[i] >= cutoff) {
+            rows[count++] = i;
+        }
+    }
+    if (count == 0) {
+        std::cout << "No movies found in the last 3 years.\n";
+        delete[] rows;
+        delete[] years;
+        return;
+    }
+    sortIdsByKey(rows, count, years);
+    std::cout << "Recent Movies (in ascending order of release year):\n";
+    for (int i = 0; i < count; ++i) {
+        std::cout << archive.textAt(ARCHIVE_MOVIE_TITLES, rows[i]) << " (" << years[rows[i]] << ")\n";
+    }
+    delete[] rows;
+    delete[] years;
 }
-
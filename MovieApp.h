@@ -3,8 +3,16 @@
 
 #include "Actor.h"
 #include "Movie.h"
-#include "HashTable.h"
+#include "DenseTable.h"
 #include "RatingBST.h"
+#include "Filmography.h"
+#include "ColumnStore.h"
+#include "CatalogImage.h"
+#include "CatalogArchive.h"
+#include "ActorGraph.h"
+#include "ChunkedCsv.h"
+#include "MutationLog.h"
+#include "LoadReport.h"
 #include <string>
 
 /***************************************************************************
@@ -15,49 +23,359 @@
  * Student IDs:     S10241866, S10241549
  *
  * Features Highlight:
- *   - Manages collections of movies and actors using hash tables.
- *   - Supports reading data from CSV files, performing CRUD operations,
+ *   - Manages collections of movies and actors in dense tables, where each
+ *     record is addressed by a dense internal ID (0..n-1) assigned at load time.
+ *   - Supports reading data from CSV files (as a pipeline that parses all
+ *     three files at once, see loadCsvFiles) and following them afterwards,
+ *     ingesting only rows appended since (see ingestAppendedRows),
+ *     performing CRUD operations,
  *     building an actor graph using BFS, and recommending movies and actors
  *     based on ratings.
+ *   - Saves and restores its whole state as a binary snapshot (Snapshot.h),
+ *     so a restart does not have to re-parse the CSV files.
+ *   - Can serve queries straight from a memory-mapped CatalogImage; changes
+ *     made while serving an image go to the in-memory tables, which act as
+ *     an overlay on top of the image.
+ *   - Can run the year and age scans on a compressed CatalogArchive without
+ *     loading the catalogue, for deployments where most data stays cold.
+ *   - Every admin change goes through one applyMutation() path and, once
+ *     openLog() has been called, is synced to a write-ahead MutationLog
+ *     before it is reported. Large logs are checkpointed into a change
+ *     history, which outlives any CSV reload, and into the snapshot.
  *
  ***************************************************************************/
 
  /**
-  * @brief The MovieApp class manages movies and actors.
+  * @brief How far a CSV file has been read, for ingesting rows appended later.
+  */
+struct FeedCursor {
+    std::string filename;  ///< The CSV file (empty if not followed).
+    size_t offset;         ///< Offset just past the last row read.
+};
+
+/**
+ * @brief What one call to MovieApp::ingestAppendedRows() did.
+ */
+struct IngestStats {
+    int actorRows;              ///< Actor rows applied.
+    int movieRows;              ///< Movie rows applied.
+    int castRows;               ///< Cast rows read.
+    unsigned long long bytes;   ///< Bytes of new rows read.
+    double millis;              ///< Wall-clock time spent ingesting.
+    double rowsPerSecond;       ///< Rows read per second of ingest time.
+    double lagMillis;           ///< Freshness lag: time from the newest append to the file until its rows were applied.
+};
+
+/**
+ * @brief The MovieApp class manages movies and actors.
   *
-  * This class uses hash tables to store and manage collections of movies and actors.
+  * This class uses dense tables to store and manage collections of movies and actors.
   * It supports reading data from CSV files, performing CRUD operations, building
   * an actor graph via BFS, and recommending movies and actors based on ratings.
   */
 class MovieApp {
 private:
-    HashTable<Actor> actorTable;  ///< Hash table storing actors by ID.
-    HashTable<Movie> movieTable;  ///< Hash table storing movies by ID.
+    DenseTable<Actor> actorTable; ///< Actors indexed by dense actor ID.
+    DenseTable<Movie> movieTable; ///< Movies indexed by dense movie ID.
+    ActorColumns actorColumns;    ///< Column copies of actor fields for scans.
+    MovieColumns movieColumns;    ///< Column copies of movie fields for scans.
     RatingBST movieRatings;       ///< Binary search tree for storing movies by rating.
     RatingBST actorRatings;       ///< Binary search tree for storing actors by rating.
+    Filmography* filmographies;   ///< Reverse index: dense actor ID -> dense movie IDs.
+    int filmographyCapacity;      ///< Allocated size of the filmographies array.
+    mutable ActorGraph actorGraph; ///< Co-star graph, built by the first displayActorsKnownBy() and kept up to date.
+    mutable bool actorGraphReady;  ///< True while actorGraph matches the tables.
     int nextActorId;              ///< Next available actor ID.
     int nextMovieId;              ///< Next available movie ID.
     bool isAdmin;                 ///< Flag indicating whether admin mode is active.
+    CatalogImage image;           ///< Read-only catalogue being served, if any (see openImage).
+    CatalogArchive archive;       ///< Compressed catalogue being scanned, if any (see openArchive).
+    MutationLog mutationLog;      ///< Write-ahead log of admin changes (see openLog).
+    uint64_t logSequence;         ///< Sequence of the last logged change applied.
+    std::string snapshotPath;     ///< Snapshot that checkpoints fold the log into.
+    std::string historyPath;      ///< Change history that checkpoints append the log to.
+    FeedCursor actorsFeed;        ///< Read position in the actors file (see ingestAppendedRows).
+    FeedCursor moviesFeed;        ///< Read position in the movies file.
+    FeedCursor castFeed;          ///< Read position in the cast file.
+
+    /**
+     * @brief Returns the filmography for a dense actor ID, growing the index if needed.
+     *
+     * @param actorDenseId The actor's dense ID.
+     * @return Filmography& The actor's filmography.
+     */
+    Filmography& filmographyOf(int actorDenseId);
+
+    /**
+     * @brief Adds an actor to a movie's cast and records the movie in the actor's filmography.
+     *
+     * @param actorDenseId The dense ID of the actor to link.
+     * @param movieDenseId The dense ID of the movie to link the actor to.
+     * @return true if a new link was created, false if the actor was already in the cast.
+     */
+    bool linkActorToMovie(int actorDenseId, int movieDenseId);
+
+    /**
+     * @brief Checks whether an actor is already in a movie's cast (overlay or image).
+     *
+     * @param actorDenseId The dense ID of the actor.
+     * @param movieDenseId The dense ID of the movie.
+     * @return true if they are linked.
+     */
+    bool isCastMember(int actorDenseId, int movieDenseId) const;
+
+    /**
+     * @brief Copies an actor's current name and birth year into the casts it appears in.
+     *
+     * @param actorDenseId The actor's dense ID.
+     */
+    void refreshCastCopies(int actorDenseId);
+
+    /**
+     * @brief Inserts the rows of a parsed actors file, in file order.
+     *
+     * @param stage The parsed file.
+     * @param stats Receives the rows parsed, loaded and rejected.
+     */
+    void mergeActors(const CsvStage<StagedActorRow>& stage, FileLoadStats& stats);
+
+    /**
+     * @brief Inserts the rows of a parsed movies file, in file order.
+     *
+     * @param stage The parsed file.
+     * @param filename The file's path, which lazily loaded plots are read from.
+     * @param stats Receives the rows parsed, loaded and rejected.
+     */
+    void mergeMovies(const CsvStage<StagedMovieRow>& stage, const std::string& filename,
+        FileLoadStats& stats);
+
+    /**
+     * @brief Links the pairs of a tokenized cast file, in file order.
+     *
+     * @param stage The tokenized file.
+     * @param stats Receives the rows parsed, linked and rejected.
+     */
+    void linkCast(const CsvStage<StagedCastRow>& stage, FileLoadStats& stats);
+
+    // --------------------------
+    // Mutation Helpers
+    // --------------------------
+
+    /**
+     * @brief Applies one change to the tables.
+     *
+     * Used both for live changes and for log replay. Records hold final
+     * values, and adds of an existing ID are skipped, so applying a record
+     * twice leaves the same state.
+     *
+     * @param record The change.
+     */
+    void applyMutation(const MutationRecord& record);
+
+    /**
+     * @brief Logs a validated change (if the log is open), applies it and waits until it is synced.
+     *
+     * @param record The change; receives its sequence number.
+     * @return true if the change may be reported as saved.
+     */
+    bool commitMutation(MutationRecord& record);
+
+    /**
+     * @brief Appends the log to the change history, folds it into the snapshot and empties it.
+     *
+     * @return true on success.
+     */
+    bool checkpoint();
+
+    // --------------------------
+    // Image Mode Helpers
+    // --------------------------
+    //
+    // While an image is open, actors and movies are addressed by "slots":
+    // slot i < image record count is image record i (or the overlay record
+    // that replaced it), and later slots are overlay records that are not in
+    // the image. When no image is open, the helpers are not used.
+
+    /**
+     * @brief Copies an image actor into the overlay tables before it is changed.
+     *
+     * @param actorId The actor's ID.
+     * @return int The actor's dense ID in actorTable, or -1 if the actor does not exist.
+     */
+    int overlayActor(int actorId);
+
+    /**
+     * @brief Copies an image movie into the overlay tables before it is changed.
+     *
+     * @param movieId The movie's ID.
+     * @return int The movie's dense ID in movieTable, or -1 if the movie does not exist.
+     */
+    int overlayMovie(int movieId);
+
+    /**
+     * @brief Returns the slot of an actor.
+     *
+     * @param actorId The actor's ID.
+     * @return int The slot, or -1 if the actor does not exist.
+     */
+    int actorSlotOf(int actorId) const;
+
+    /**
+     * @brief Returns the slot of a movie.
+     *
+     * @param movieId The movie's ID.
+     * @return int The slot, or -1 if the movie does not exist.
+     */
+    int movieSlotOf(int movieId) const;
+
+    /**
+     * @brief Returns the current fields of an actor slot.
+     *
+     * @param slot The slot.
+     * @return CatalogActorRow The overlay record if there is one, else the image record.
+     */
+    CatalogActorRow actorRowAt(int slot) const;
+
+    /**
+     * @brief Returns the current fields of a movie slot.
+     *
+     * @param slot The slot.
+     * @return CatalogMovieRow The overlay record if there is one, else the image record.
+     */
+    CatalogMovieRow movieRowAt(int slot) const;
+
+    /**
+     * @brief Returns the plot of a movie slot.
+     *
+     * @param slot The slot.
+     * @return const char* The plot text.
+     */
+    const char* moviePlotAt(int slot) const;
+
+    /**
+     * @brief Collects the actor slots of a movie's cast (image links, then overlay links).
+     *
+     * @param movieSlot The movie slot.
+     * @param slots Receives a new[] array the caller must delete[].
+     * @return int The number of actors.
+     */
+    int castSlotsOf(int movieSlot, int*& slots) const;
+
+    /**
+     * @brief Collects the movie slots of an actor's filmography (image links, then overlay links).
+     *
+     * @param actorSlot The actor slot.
+     * @param slots Receives a new[] array the caller must delete[].
+     * @return int The number of movies.
+     */
+    int filmSlotsOf(int actorSlot, int*& slots) const;
+
+    /**
+     * @brief Collects every actor slot whose name folds to the same key as a search name.
+     *
+     * @param name The search name.
+     * @param slots Receives a new[] array in slot order that the caller must delete[].
+     * @return int The number of matches.
+     */
+    int actorSlotsNamed(const std::string& name, int*& slots) const;
+
+    /**
+     * @brief Finds the first movie slot whose title folds to the same key as a search title.
+     *
+     * @param title The search title.
+     * @return int The slot, or -1 if there is none.
+     */
+    int movieSlotTitled(const std::string& title) const;
+
+    /**
+     * @brief Checks whether the image already links an actor to a movie.
+     *
+     * @param actorId The actor's ID.
+     * @param movieId The movie's ID.
+     * @return true if the image has the link.
+     */
+    bool imageHasLink(int actorId, int movieId) const;
+
+    /**
+     * @brief Image mode version of displayAllActors().
+     */
+    void displayAllActorsFromImage() const;
+
+    /**
+     * @brief Image mode version of displayAllMovies().
+     */
+    void displayAllMoviesFromImage() const;
+
+    /**
+     * @brief Image mode version of displayActorsByAge().
+     *
+     * @param minAge The minimum age (inclusive).
+     * @param maxAge The maximum age (inclusive).
+     */
+    void displayActorsByAgeFromImage(int minAge, int maxAge) const;
+
+    /**
+     * @brief Image mode version of displayRecentMovies().
+     *
+     * @param cutoff The earliest release year shown.
+     */
+    void displayRecentMoviesFromImage(int cutoff) const;
+
+    /**
+     * @brief Image mode version of displayMoviesOfActor().
+     *
+     * @param actorId The ID of the actor.
+     */
+    void displayMoviesOfActorFromImage(int actorId) const;
+
+    /**
+     * @brief Image mode version of displayActorsInMovie().
+     *
+     * @param movieTitle The title of the movie.
+     */
+    void displayActorsInMovieFromImage(const std::string& movieTitle) const;
+
+    /**
+     * @brief Image mode version of displayActorsKnownBy().
+     *
+     * @param actorName The name of the actor.
+     */
+    void displayActorsKnownByFromImage(const std::string& actorName) const;
+
+    /**
+     * @brief Image mode version of recommendMoviesByRating().
+     *
+     * @param minRating The minimum rating (inclusive).
+     * @param maxRating The maximum rating (inclusive).
+     */
+    void recommendMoviesFromImage(int minRating, int maxRating) const;
 
     /**
-     * @brief Builds the actor graph using adjacency lists.
+     * @brief Image mode version of recommendActorsByRating().
      *
-     * @param actorIds An array to store actor IDs.
-     * @param actorCount Reference to an integer to hold the total number of actors.
-     * @param adjacencyLists An array of adjacency lists representing the actor graph.
-     * @param MAX_ACTORS Maximum number of actors expected.
+     * @param minRating The minimum rating (inclusive).
+     * @param maxRating The maximum rating (inclusive).
      */
-    void buildActorGraph(int actorIds[], int& actorCount, List<int>* adjacencyLists, const int MAX_ACTORS) const;
+    void recommendActorsFromImage(int minRating, int maxRating) const;
+
+    // --------------------------
+    // Archive Mode Helpers
+    // --------------------------
 
     /**
-     * @brief Finds the index of an actor in the actorIds array.
+     * @brief Archive mode version of displayActorsByAge().
      *
-     * @param actorId The actor's ID to search for.
-     * @param actorIds The array of actor IDs.
-     * @param count Total number of actor IDs in the array.
-     * @return int The index of the actor if found; otherwise, -1.
+     * @param minAge The minimum age.
+     * @param maxAge The maximum age.
      */
-    int findActorIndexInArray(int actorId, const int actorIds[], int count) const;
+    void displayActorsByAgeFromArchive(int minAge, int maxAge) const;
+
+    /**
+     * @brief Archive mode version of displayRecentMovies().
+     *
+     * @param cutoff The earliest release year shown.
+     */
+    void displayRecentMoviesFromArchive(int cutoff) const;
 
 public:
     // --------------------------
@@ -67,10 +385,19 @@ public:
     /**
      * @brief Constructs a new MovieApp object.
      *
-     * Initializes hash tables, next IDs, and sets the default mode.
+     * Initializes the tables, next IDs, and sets the default mode.
      */
     MovieApp();
 
+    /**
+     * @brief Destroys the MovieApp object and releases the filmography index.
+     */
+    ~MovieApp();
+
+    // Copy constructor and assignment operator are disabled for simplicity.
+    MovieApp(const MovieApp&) = delete;
+    MovieApp& operator=(const MovieApp&) = delete;
+
     // --------------------------
     // Admin Mode Functions
     // --------------------------
@@ -114,6 +441,173 @@ public:
      */
     void readCast(const std::string& filename);
 
+    /**
+     * @brief Reads actors, movies and cast as a pipeline.
+     *
+     * Gives the same result as readActors(), readMovies() and readCast() in
+     * sequence, but the three files are parsed concurrently and the cast is
+     * linked as soon as both tables are complete.
+     *
+     * @param actorsFile The actors CSV file.
+     * @param moviesFile The movies CSV file.
+     * @param castFile The cast CSV file.
+     * @param report Receives per-file row counts, stage timings and table sizes.
+     */
+    void loadCsvFiles(const std::string& actorsFile, const std::string& moviesFile,
+        const std::string& castFile, LoadReport& report);
+
+    /**
+     * @brief Adds the size, capacity and resize count of each table to a load report.
+     *
+     * @param report The report to fill.
+     */
+    void describeTables(LoadReport& report) const;
+
+    // --------------------------
+    // Tail Mode Functions
+    // --------------------------
+
+    /**
+     * @brief Starts following the CSV files for appended rows.
+     *
+     * Files read by loadCsvFiles() are followed from where that load ended;
+     * other files (for example after a snapshot load) from their current end.
+     *
+     * @param actorsFile The actors CSV file.
+     * @param moviesFile The movies CSV file.
+     * @param castFile The cast CSV file.
+     */
+    void followCsvFiles(const std::string& actorsFile, const std::string& moviesFile,
+        const std::string& castFile);
+
+    /**
+     * @brief Reads and applies the rows appended to the followed files since the last call.
+     *
+     * Actors and movies are upserted as the CSV loaders do, keeping ratings
+     * and casts, and cast rows are linked afterwards, so a batch may refer to
+     * actors and movies appended in the same batch. Filmographies, and with
+     * them the actor graph, are updated as part of linking. A row still
+     * being written (no newline yet) is left for the next call.
+     *
+     * @param stats Receives the row counts, throughput and freshness lag.
+     * @return true if any rows were read.
+     */
+    bool ingestAppendedRows(IngestStats& stats);
+
+    // --------------------------
+    // Snapshot Functions
+    // --------------------------
+
+    /**
+     * @brief Writes actors, movies, cast links and ratings to a binary snapshot.
+     *
+     * @param path The snapshot file to create or overwrite.
+     * @return true if the snapshot was written completely.
+     */
+    bool saveSnapshot(const std::string& path) const;
+
+    /**
+     * @brief Loads actors, movies, cast links and ratings from a binary snapshot.
+     *
+     * Records are upserted exactly as the CSV loaders do. Nothing is changed
+     * if the file is missing, of another version, or fails validation.
+     *
+     * @param path The snapshot file written by saveSnapshot().
+     * @return true if the snapshot was loaded.
+     */
+    bool loadSnapshot(const std::string& path);
+
+    // --------------------------
+    // Catalogue Image Functions
+    // --------------------------
+
+    /**
+     * @brief Writes the catalogue as an image that openImage() can serve in place.
+     *
+     * @param path The image file to create or overwrite.
+     * @return true if the image was written completely.
+     */
+    bool writeImage(const std::string& path) const;
+
+    /**
+     * @brief Serves queries from a catalogue image without loading it.
+     *
+     * Only the header is read, so this takes constant time. The image is
+     * never modified: added or changed actors, movies, links and ratings are
+     * kept in the in-memory tables, which take precedence over the image.
+     * Must be called before any data is loaded.
+     *
+     * @param path The image file written by writeImage().
+     * @return true if the image was opened.
+     */
+    bool openImage(const std::string& path);
+
+    /**
+     * @brief Checks whether queries are being served from a catalogue image.
+     *
+     * @return true if an image is open.
+     */
+    bool isServingImage() const;
+
+    // --------------------------
+    // Catalogue Archive Functions
+    // --------------------------
+
+    /**
+     * @brief Writes the actor and movie records as a compressed CatalogArchive.
+     *
+     * Rows keep their dense ID order, so scans of the archive list ties in
+     * the same order as scans of the tables. Cast links are not archived.
+     *
+     * @param path The archive file to create or overwrite.
+     * @return true if the archive was written completely.
+     */
+    bool writeArchive(const std::string& path) const;
+
+    /**
+     * @brief Serves displayActorsByAge() and displayRecentMovies() from an archive.
+     *
+     * Nothing else is available until closeArchive() is called and the
+     * catalogue is loaded. Must be called before any data is loaded.
+     *
+     * @param path The archive file written by writeArchive().
+     * @return true if the archive was opened.
+     */
+    bool openArchive(const std::string& path);
+
+    /**
+     * @brief Stops serving scans from the archive.
+     */
+    void closeArchive();
+
+    /**
+     * @brief Checks whether scans are being served from an archive.
+     *
+     * @return true if an archive is open.
+     */
+    bool isServingArchive() const;
+
+    // --------------------------
+    // Mutation Log Functions
+    // --------------------------
+
+    /**
+     * @brief Opens the write-ahead log and replays the changes it and the change history hold.
+     *
+     * Call once the data is loaded (or the image is open). Changes the
+     * loaded snapshot or image already contains are skipped. From then on
+     * every admin change is logged before it is applied, and once the log
+     * grows past LOG_CHECKPOINT_BYTES it is appended to historyFile, folded
+     * into snapshotFile and emptied.
+     *
+     * @param logFile The log file, created if missing.
+     * @param historyFile The change history, created by the first checkpoint.
+     * @param snapshotFile The snapshot used for checkpoints.
+     * @return int The number of changes replayed, or -1 if either file cannot be read.
+     */
+    int openLog(const std::string& logFile, const std::string& historyFile,
+        const std::string& snapshotFile);
+
     // --------------------------
     // Next ID Functions
     // --------------------------
@@ -243,6 +737,8 @@ public:
     /**
      * @brief Displays movies associated with the specified actor.
      *
+     * Uses the actor's filmography so only the actor's own movies are visited.
+     *
      * @param actorId The ID of the actor.
      */
     void displayMoviesOfActor(int actorId) const;
@@ -261,6 +757,19 @@ public:
      */
     void displayActorsKnownBy(const std::string& actorName) const;
 
+    /**
+     * @brief Times the actor ID lookups, actor graph builds and searches behind displayActorsKnownBy().
+     *
+     * Resolves every cast member's actor ID, then builds the graph a number
+     * of times into a scratch graph, then runs the top-down and the
+     * direction-optimizing depth-2 search from the highest- and
+     * lowest-degree actors, printing one "[Bench]" line per measurement.
+     * The graph the app keeps is not touched.
+     *
+     * @param rounds Number of graph builds, and of each search, to time (the best is reported).
+     */
+    void benchmarkActorGraph(int rounds) const;
+
     // --------------------------
     // Ratings Functions
     // --------------------------
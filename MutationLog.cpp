@@ -0,0 +1,642 @@
+/***************************************************************************
+ * MutationLog.cpp
+ *
+ * Team:            Gearoid, Cedric
+ * Group:           1
+ * Student IDs:     S10241866, S10241549
+ *
+ * Features Highlight:
+ *   - Checksummed binary records with torn-tail recovery on replay.
+ *   - Background group commit: one write and one fsync per batch.
+ *   - Change history appended from the log, skipping records it already holds.
+ *   - Log reset in place, on the descriptor the flusher writes to.
+ ***************************************************************************/
+
+#include "MutationLog.h"
+#include "DurableFile.h"
+#include "MappedFile.h"
+#include <chrono>
+#include <cstring>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#include <share.h>
+#include <sys/stat.h>
+#else
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/// "DSAW" read as a little-endian 32-bit integer.
+static const uint32_t MUTATION_LOG_MAGIC = 0x57415344u;
+
+/// Bumped whenever the record layout changes.
+static const uint32_t MUTATION_LOG_VERSION = 1;
+
+/// Size of the file header.
+static const size_t LOG_HEADER_BYTES = 16;
+
+/// Size of a payload with empty text and plot.
+static const uint32_t MIN_PAYLOAD_BYTES = 8 + 1 + 4 * 3 + 4 + 4;
+
+ // ---------------------------------------------------------------------------
+ // File Helpers
+ // ---------------------------------------------------------------------------
+
+/**
+ * @brief Opens a file for appending, creating it if needed.
+ *
+ * @param path The file.
+ * @return int The descriptor, or -1.
+ */
+static int openForAppend(const std::string& path) {
+#ifdef _WIN32
+    int fd = -1;
+    _sopen_s(&fd, path.c_str(), _O_WRONLY | _O_CREAT | _O_APPEND | _O_BINARY, _SH_DENYNO,
+        _S_IREAD | _S_IWRITE);
+    return fd;
+#else
+    return ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+#endif
+}
+
+/**
+ * @brief Writes a whole buffer.
+ *
+ * @param fd The descriptor.
+ * @param data The bytes.
+ * @param size Number of bytes.
+ * @return bool True if everything was written.
+ */
+static bool writeFully(int fd, const char* data, size_t size) {
+    while (size > 0) {
+        unsigned int chunk = (size > (1u << 30)) ? (1u << 30) : static_cast<unsigned int>(size);
+#ifdef _WIN32
+        int written = _write(fd, data, chunk);
+#else
+        ssize_t written = ::write(fd, data, chunk);
+#endif
+        if (written <= 0) {
+            return false;
+        }
+        data += written;
+        size -= static_cast<size_t>(written);
+    }
+    return true;
+}
+
+/**
+ * @brief Flushes a file to stable storage.
+ *
+ * @param fd The descriptor.
+ * @return bool True on success.
+ */
+static bool syncFile(int fd) {
+#ifdef _WIN32
+    return _commit(fd) == 0;
+#else
+    return ::fsync(fd) == 0;
+#endif
+}
+
+/**
+ * @brief Cuts a file to a given size.
+ *
+ * @param fd The descriptor.
+ * @param size The new size.
+ * @return bool True on success.
+ */
+static bool truncateFile(int fd, uint64_t size) {
+#ifdef _WIN32
+    return _chsize_s(fd, static_cast<long long>(size)) == 0;
+#else
+    return ::ftruncate(fd, static_cast<off_t>(size)) == 0;
+#endif
+}
+
+/**
+ * @brief Closes a descriptor.
+ *
+ * @param fd The descriptor.
+ */
+static void closeFile(int fd) {
+#ifdef _WIN32
+    _close(fd);
+#else
+    ::close(fd);
+#endif
+}
+
+// ---------------------------------------------------------------------------
+// Record Encoding
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief FNV-1a checksum of a byte range.
+ *
+ * @param data The bytes.
+ * @param size Number of bytes.
+ * @return uint32_t The checksum.
+ */
+static uint32_t checksumOf(const char* data, size_t size) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/**
+ * @brief Appends a value's bytes to a buffer.
+ *
+ * @param out The buffer.
+ * @param value The value.
+ */
+template <typename T>
+static void putValue(std::string& out, T value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+/**
+ * @brief Reads a value and advances the cursor.
+ *
+ * @param p The cursor.
+ * @return T The value.
+ */
+template <typename T>
+static T takeValue(const char*& p) {
+    T value;
+    std::memcpy(&value, p, sizeof(T));
+    p += sizeof(T);
+    return value;
+}
+
+/**
+ * @brief Builds the file header.
+ *
+ * @param baseSequence Last sequence already contained in the snapshot.
+ * @return std::string The header bytes.
+ */
+static std::string encodeHeader(uint64_t baseSequence) {
+    std::string header;
+    putValue<uint32_t>(header, MUTATION_LOG_MAGIC);
+    putValue<uint32_t>(header, MUTATION_LOG_VERSION);
+    putValue<uint64_t>(header, baseSequence);
+    return header;
+}
+
+/**
+ * @brief Appends a framed record to a buffer.
+ *
+ * @param out The buffer.
+ * @param record The record.
+ */
+static void encodeRecord(std::string& out, const MutationRecord& record) {
+    std::string payload;
+    payload.reserve(MIN_PAYLOAD_BYTES + record.text.size() + record.plot.size());
+    putValue<uint64_t>(payload, record.sequence);
+    putValue<uint8_t>(payload, static_cast<uint8_t>(record.type));
+    putValue<int32_t>(payload, record.id);
+    putValue<int32_t>(payload, record.otherId);
+    putValue<int32_t>(payload, record.value);
+    putValue<uint32_t>(payload, static_cast<uint32_t>(record.text.size()));
+    payload += record.text;
+    putValue<uint32_t>(payload, static_cast<uint32_t>(record.plot.size()));
+    payload += record.plot;
+    putValue<uint32_t>(out, static_cast<uint32_t>(payload.size()));
+    putValue<uint32_t>(out, checksumOf(payload.data(), payload.size()));
+    out += payload;
+}
+
+/**
+ * @brief Decodes a record payload whose checksum has been verified.
+ *
+ * @param p The payload.
+ * @param size The payload size.
+ * @param record Receives the record.
+ * @return bool False if the lengths inside the payload do not add up.
+ */
+static bool decodeRecord(const char* p, uint32_t size, MutationRecord& record) {
+    const char* end = p + size;
+    record.sequence = takeValue<uint64_t>(p);
+    uint8_t type = takeValue<uint8_t>(p);
+    if (type < MUTATION_ADD_ACTOR || type > MUTATION_RATE_MOVIE) {
+        return false;
+    }
+    record.type = static_cast<MutationType>(type);
+    record.id = takeValue<int32_t>(p);
+    record.otherId = takeValue<int32_t>(p);
+    record.value = takeValue<int32_t>(p);
+    uint32_t textLength = takeValue<uint32_t>(p);
+    if (textLength > static_cast<size_t>(end - p) - 4) {
+        return false;
+    }
+    record.text.assign(p, textLength);
+    p += textLength;
+    uint32_t plotLength = takeValue<uint32_t>(p);
+    if (plotLength != static_cast<size_t>(end - p)) {
+        return false;
+    }
+    record.plot.assign(p, plotLength);
+    return true;
+}
+
+/**
+ * @brief Walks the valid records of a mapped log file.
+ *
+ * A file shorter than the header holds no records; it is what a crash
+ * while a header was being written leaves behind. A record that is cut
+ * short or fails its checksum ends the walk.
+ *
+ * @param data The file contents.
+ * @param size The file size.
+ * @param lastSequence Raised to the header's base sequence and each record's sequence.
+ * @param validBytes Receives the offset just past the last valid record (0 if there is no header).
+ * @param visit Called with each record and its framed bytes.
+ * @return bool False if the file is not a log.
+ */
+static bool scanLog(const char* data, uint64_t size, uint64_t& lastSequence, uint64_t& validBytes,
+    const std::function<void(const MutationRecord&, const char*, uint64_t)>& visit) {
+    validBytes = 0;
+    if (size < LOG_HEADER_BYTES) {
+        return true;
+    }
+    const char* p = data;
+    uint32_t magic = takeValue<uint32_t>(p);
+    uint32_t version = takeValue<uint32_t>(p);
+    uint64_t headerBase = takeValue<uint64_t>(p);
+    if (magic != MUTATION_LOG_MAGIC || version != MUTATION_LOG_VERSION) {
+        return false;
+    }
+    if (headerBase > lastSequence) {
+        lastSequence = headerBase;
+    }
+    uint64_t pos = LOG_HEADER_BYTES;
+    MutationRecord record;
+    while (size - pos >= 8) {
+        p = data + pos;
+        uint32_t length = takeValue<uint32_t>(p);
+        uint32_t checksum = takeValue<uint32_t>(p);
+        if (length < MIN_PAYLOAD_BYTES || length > size - pos - 8
+            || checksumOf(p, length) != checksum || !decodeRecord(p, length, record)) {
+            break;
+        }
+        visit(record, data + pos, 8 + static_cast<uint64_t>(length));
+        if (record.sequence > lastSequence) {
+            lastSequence = record.sequence;
+        }
+        pos += 8 + length;
+    }
+    validBytes = pos;
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// MutationLog
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Constructs a closed log.
+ */
+MutationLog::MutationLog()
+    : fd(-1),
+    nextSequence(1),
+    bytesOnDisk(0),
+    queuedRecords(0),
+    queuedThrough(0),
+    durableThrough(0),
+    stopping(false),
+    failed(false),
+    syncWaiters(0)
+{
+}
+
+/**
+ * @brief Destructor.
+ */
+MutationLog::~MutationLog() {
+    close();
+}
+
+/**
+ * @brief Opens a log and replays it.
+ *
+ * The whole file is mapped and scanned once. A record that is cut short or
+ * fails its checksum marks the end of the log (a crash during a write), and
+ * the file is truncated there before new records are appended.
+ *
+ * @param filename Path of the log file.
+ * @param baseSequence Last sequence contained in the loaded data.
+ * @param replay Applies one record.
+ * @return int Records replayed, or -1 on error.
+ */
+int MutationLog::open(const std::string& filename, uint64_t baseSequence,
+    const std::function<void(const MutationRecord&)>& replay) {
+    close();
+    path = filename;
+    uint64_t lastSequence = baseSequence;
+    uint64_t validBytes = 0;
+    uint64_t fileBytes = 0;
+    int replayed = 0;
+    {
+        MappedFile file;
+        if (file.open(path) && file.size() > 0) {
+            bool isLog = scanLog(file.data(), file.size(), lastSequence, validBytes,
+                [&](const MutationRecord& record, const char*, uint64_t) {
+                    if (record.sequence > baseSequence) {
+                        replay(record);
+                        ++replayed;
+                    }
+                });
+            if (!isLog) {
+                return -1;
+            }
+            fileBytes = file.size();
+        }
+    }
+
+    fd = openForAppend(path);
+    if (fd == -1) {
+        return -1;
+    }
+    if (validBytes == 0) {
+        std::string header = encodeHeader(baseSequence);
+        if (!truncateFile(fd, 0) || !writeFully(fd, header.data(), header.size()) || !syncFile(fd)) {
+            closeFile(fd);
+            fd = -1;
+            return -1;
+        }
+        validBytes = header.size();
+    }
+    // Only a torn tail is cut off: truncating to the same size would still
+    // touch the file, and main() compares modification times.
+    else if (validBytes < fileBytes && !truncateFile(fd, validBytes)) {
+        closeFile(fd);
+        fd = -1;
+        return -1;
+    }
+    nextSequence = lastSequence + 1;
+    queuedThrough = lastSequence;
+    durableThrough = lastSequence;
+    bytesOnDisk = validBytes;
+    queuedRecords = 0;
+    queued.clear();
+    stopping = false;
+    failed = false;
+    flusher = std::thread(&MutationLog::flushLoop, this);
+    return replayed;
+}
+
+/**
+ * @brief Replays a log file read-only.
+ *
+ * @param filename Path of the log file.
+ * @param baseSequence Records at or below this sequence are skipped.
+ * @param replay Applies one record.
+ * @return int Records replayed, or -1 if the file is not a log.
+ */
+int MutationLog::replayFile(const std::string& filename, uint64_t baseSequence,
+    const std::function<void(const MutationRecord&)>& replay) {
+    MappedFile file;
+    if (!file.open(filename) || file.size() == 0) {
+        return 0;
+    }
+    int replayed = 0;
+    uint64_t lastSequence = 0;
+    uint64_t validBytes = 0;
+    bool isLog = scanLog(file.data(), file.size(), lastSequence, validBytes,
+        [&](const MutationRecord& record, const char*, uint64_t) {
+            if (record.sequence > baseSequence) {
+                replay(record);
+                ++replayed;
+            }
+        });
+    return isLog ? replayed : -1;
+}
+
+/**
+ * @brief Flushes and closes the log.
+ */
+void MutationLog::close() {
+    if (fd == -1) {
+        return;
+    }
+    sync();
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        stopping = true;
+    }
+    wakeFlusher.notify_one();
+    flusher.join();
+    closeFile(fd);
+    fd = -1;
+}
+
+/**
+ * @brief Checks whether the log is open.
+ *
+ * @return bool True if open.
+ */
+bool MutationLog::isOpen() const {
+    return fd != -1;
+}
+
+/**
+ * @brief Queues a record for the next group commit.
+ *
+ * @param record The record; receives its sequence number.
+ */
+void MutationLog::append(MutationRecord& record) {
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        record.sequence = nextSequence++;
+        size_t before = queued.size();
+        encodeRecord(queued, record);
+        bytesOnDisk += queued.size() - before;
+        ++queuedRecords;
+        queuedThrough = record.sequence;
+    }
+    wakeFlusher.notify_one();
+}
+
+/**
+ * @brief Waits for the flusher to sync a sequence, asking it not to hold its batch open.
+ *
+ * @param guard Holds lock.
+ * @param sequence The sequence to wait for.
+ */
+void MutationLog::waitDurable(std::unique_lock<std::mutex>& guard, uint64_t sequence) {
+    ++syncWaiters;
+    wakeFlusher.notify_one();
+    flushDone.wait(guard, [this, sequence] { return durableThrough >= sequence; });
+    --syncWaiters;
+}
+
+/**
+ * @brief Waits for one record to be durable.
+ *
+ * @param sequence The record's sequence number.
+ * @return bool False if any write or fsync failed.
+ */
+bool MutationLog::waitFor(uint64_t sequence) {
+    std::unique_lock<std::mutex> guard(lock);
+    if (fd == -1) {
+        return !failed;
+    }
+    waitDurable(guard, sequence);
+    return !failed;
+}
+
+/**
+ * @brief Waits for every queued record to be durable.
+ *
+ * @return bool False if any write or fsync failed.
+ */
+bool MutationLog::sync() {
+    std::unique_lock<std::mutex> guard(lock);
+    if (fd == -1) {
+        return !failed;
+    }
+    waitDurable(guard, queuedThrough);
+    return !failed;
+}
+
+/**
+ * @brief Copies the log's records that the history lacks into it.
+ *
+ * The history is scanned first to find its last sequence and to cut off a
+ * torn tail; then the synced log is mapped and every later record is
+ * appended as it is framed in the log, so nothing is re-encoded.
+ *
+ * @param historyFile Path of the history.
+ * @return bool True once the history holds every record and is synced.
+ */
+bool MutationLog::saveToHistory(const std::string& historyFile) {
+    if (fd == -1 || !sync()) {
+        return false;
+    }
+    uint64_t historyLast = 0;
+    uint64_t historyBytes = 0;
+    uint64_t historySize = 0;
+    {
+        MappedFile history;
+        if (history.open(historyFile) && history.size() > 0) {
+            if (!scanLog(history.data(), history.size(), historyLast, historyBytes,
+                [](const MutationRecord&, const char*, uint64_t) {})) {
+                return false;
+            }
+            historySize = history.size();
+        }
+    }
+    std::string bytes;
+    if (historyBytes == 0) {
+        bytes = encodeHeader(0);
+    }
+    {
+        MappedFile log;
+        uint64_t logLast = 0;
+        uint64_t logBytes = 0;
+        if (!log.open(path) || !scanLog(log.data(), log.size(), logLast, logBytes,
+            [&](const MutationRecord& record, const char* framed, uint64_t framedBytes) {
+                if (record.sequence > historyLast) {
+                    bytes.append(framed, static_cast<size_t>(framedBytes));
+                }
+            })) {
+            return false;
+        }
+    }
+    if (bytes.empty()) {
+        return true;
+    }
+    int historyFd = openForAppend(historyFile);
+    if (historyFd == -1) {
+        return false;
+    }
+    bool ok = (historyBytes == historySize || truncateFile(historyFd, historyBytes))
+        && writeFully(historyFd, bytes.data(), bytes.size()) && syncFile(historyFd);
+    closeFile(historyFd);
+    // A new history is only durable once its directory entry is.
+    return ok && (historySize > 0 || syncParentDirectory(historyFile));
+}
+
+/**
+ * @brief Group-commit loop.
+ *
+ * After the first record of a batch arrives the thread waits up to
+ * GROUP_COMMIT_MILLIS for more, then writes and syncs the whole batch.
+ * A full batch, a sync() call or close() ends the wait early.
+ */
+void MutationLog::flushLoop() {
+    std::unique_lock<std::mutex> guard(lock);
+    while (true) {
+        wakeFlusher.wait(guard, [this] { return stopping || queuedRecords > 0; });
+        if (queuedRecords == 0) {
+            break; // Stopping with nothing left to write.
+        }
+        wakeFlusher.wait_for(guard, std::chrono::milliseconds(GROUP_COMMIT_MILLIS), [this] {
+            return stopping || syncWaiters > 0 || queuedRecords >= GROUP_COMMIT_RECORDS;
+            });
+        std::string batch;
+        batch.swap(queued);
+        uint64_t through = queuedThrough;
+        queuedRecords = 0;
+        guard.unlock();
+        bool ok = writeBatch(batch);
+        guard.lock();
+        if (!ok) {
+            failed = true;
+        }
+        durableThrough = through;
+        flushDone.notify_all();
+    }
+}
+
+/**
+ * @brief Writes and syncs one batch.
+ *
+ * @param bytes The encoded records.
+ * @return bool True on success.
+ */
+bool MutationLog::writeBatch(const std::string& bytes) {
+    return writeFully(fd, bytes.data(), bytes.size()) && syncFile(fd);
+}
+
+/**
+ * @brief Empties the log in place.
+ *
+ * Any batch still being written is waited out while holding the lock, so
+ * nothing lands after the truncation. A crash part-way leaves the old log,
+ * an empty file or a torn header; open() accepts all three, and the old
+ * records are skipped because the snapshot contains them.
+ *
+ * @param baseSequence Last sequence contained in the new snapshot.
+ * @return bool True on success.
+ */
+bool MutationLog::reset(uint64_t baseSequence) {
+    std::unique_lock<std::mutex> guard(lock);
+    if (fd == -1) {
+        return false;
+    }
+    waitDurable(guard, queuedThrough);
+    std::string header = encodeHeader(baseSequence);
+    bool ok = !failed && truncateFile(fd, 0) && writeFully(fd, header.data(), header.size()) && syncFile(fd);
+    if (!ok) {
+        failed = true;
+        return false;
+    }
+    bytesOnDisk = header.size();
+    return true;
+}
+
+/**
+ * @brief Returns the size of the log.
+ *
+ * @return uint64_t Bytes on disk plus queued bytes.
+ */
+uint64_t MutationLog::getSize() {
+    std::lock_guard<std::mutex> guard(lock);
+    return bytesOnDisk;
+}
@@ -0,0 +1,227 @@
+#ifndef MUTATION_LOG_H
+#define MUTATION_LOG_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+/***************************************************************************
+ * MutationLog.h
+ *
+ * Team:            Gearoid, Cedric
+ * Group:           1
+ * Student IDs:     S10241866, S10241549
+ *
+ * Features Highlight:
+ *   - Append-only binary write-ahead log of admin changes (new actors and
+ *     movies, cast links, detail updates and ratings), so they survive a
+ *     restart without rewriting the CSV files.
+ *   - Group commit: appends are queued and a background thread writes and
+ *     fsyncs them in batches, at most GROUP_COMMIT_MILLIS after the first
+ *     record of a batch (or sooner once GROUP_COMMIT_RECORDS are queued).
+ *   - Every record carries a sequence number and a checksum. Replay stops
+ *     at the first torn or corrupt record and cuts the file there.
+ *   - saveToHistory() appends the log's records to a change history in the
+ *     same format. The history is never regenerated from the CSV files, so
+ *     checkpointed changes are replayed from it after a CSV reload.
+ *   - reset() empties the log, in place, once a checkpoint has saved its
+ *     records to the history and a snapshot; the snapshot remembers the
+ *     last sequence it contains.
+ *
+ *   File layout:
+ *     uint32 magic, uint32 version, uint64 baseSequence
+ *     records: uint32 payloadLength, uint32 checksum, payload
+ *     payload: uint64 sequence, uint8 type, int32 id, int32 otherId,
+ *              int32 value, uint32 textLength, text, uint32 plotLength, plot
+ *
+ ***************************************************************************/
+
+ /**
+  * @brief Kinds of change recorded in the log.
+  */
+enum MutationType {
+    MUTATION_ADD_ACTOR = 1,     ///< id, value = birth year, text = name.
+    MUTATION_ADD_MOVIE = 2,     ///< id, value = release year, text = title, plot.
+    MUTATION_LINK = 3,          ///< id = actor ID, otherId = movie ID.
+    MUTATION_UPDATE_ACTOR = 4,  ///< id, value = birth year, text = name.
+    MUTATION_UPDATE_MOVIE = 5,  ///< id, value = release year, text = title, plot.
+    MUTATION_RATE_ACTOR = 6,    ///< id, value = rating.
+    MUTATION_RATE_MOVIE = 7     ///< id, value = rating.
+};
+
+/**
+ * @brief One logged change, holding final values so replaying it twice is harmless.
+ */
+struct MutationRecord {
+    uint64_t sequence;   ///< Assigned by MutationLog::append().
+    MutationType type;   ///< Kind of change.
+    int id;              ///< Actor or movie ID.
+    int otherId;         ///< Movie ID of a link (0 otherwise).
+    int value;           ///< Birth year, release year or rating.
+    std::string text;    ///< Name or title.
+    std::string plot;    ///< Plot of a movie.
+};
+
+/**
+ * @brief Append-only write-ahead log with group commit.
+ */
+class MutationLog {
+public:
+    static const int GROUP_COMMIT_MILLIS = 20;   ///< Longest a queued record waits for fsync.
+    static const int GROUP_COMMIT_RECORDS = 64;  ///< Queue length that triggers an early flush.
+
+private:
+    std::string path;                  ///< Log file path.
+    int fd;                            ///< File descriptor open for appending, or -1.
+    uint64_t nextSequence;             ///< Sequence number of the next record.
+    uint64_t bytesOnDisk;              ///< Size of the file including queued records.
+    std::string queued;                ///< Encoded records waiting for the flusher.
+    int queuedRecords;                 ///< Number of records in queued.
+    uint64_t queuedThrough;            ///< Last sequence in queued.
+    uint64_t durableThrough;           ///< Last sequence written and synced.
+    bool stopping;                     ///< Tells the flusher to exit.
+    bool failed;                       ///< Set once a write or fsync fails.
+    int syncWaiters;                   ///< Threads blocked in sync(); the flusher skips its wait.
+    std::mutex lock;                   ///< Guards the fields above.
+    std::condition_variable wakeFlusher;  ///< Signalled when records are queued or on close.
+    std::condition_variable flushDone;    ///< Signalled after each batch is synced.
+    std::thread flusher;               ///< Background group-commit thread.
+
+    /**
+     * @brief Waits until every record up to a sequence has been written and synced.
+     *
+     * @param guard Holds lock.
+     * @param sequence The sequence to wait for.
+     */
+    void waitDurable(std::unique_lock<std::mutex>& guard, uint64_t sequence);
+
+    /**
+     * @brief Body of the flusher thread.
+     */
+    void flushLoop();
+
+    /**
+     * @brief Writes a batch to the file and syncs it.
+     *
+     * @param bytes The encoded records.
+     * @return bool True on success.
+     */
+    bool writeBatch(const std::string& bytes);
+
+public:
+    /**
+     * @brief Constructs a closed log.
+     */
+    MutationLog();
+
+    /**
+     * @brief Destructor. Flushes and closes the log.
+     */
+    ~MutationLog();
+
+    // Copy constructor and assignment operator are disabled for simplicity.
+    MutationLog(const MutationLog&) = delete;
+    MutationLog& operator=(const MutationLog&) = delete;
+
+    /**
+     * @brief Opens (or creates) a log, replaying the records it holds.
+     *
+     * Records with a sequence number at or below baseSequence are already
+     * part of the loaded data and are skipped.
+     *
+     * @param filename Path of the log file.
+     * @param baseSequence Last sequence contained in the loaded snapshot.
+     * @param replay Called for each record to apply, in log order.
+     * @return int The number of records replayed, or -1 if the log cannot be opened.
+     */
+    int open(const std::string& filename, uint64_t baseSequence,
+        const std::function<void(const MutationRecord&)>& replay);
+
+    /**
+     * @brief Replays a log file without opening it for appending.
+     *
+     * Used for the change history. A missing file holds no records.
+     *
+     * @param filename Path of the log file.
+     * @param baseSequence Records at or below this sequence are skipped.
+     * @param replay Called for each record to apply, in log order.
+     * @return int The number of records replayed, or -1 if the file is not a log.
+     */
+    static int replayFile(const std::string& filename, uint64_t baseSequence,
+        const std::function<void(const MutationRecord&)>& replay);
+
+    /**
+     * @brief Flushes queued records, stops the flusher and closes the file.
+     */
+    void close();
+
+    /**
+     * @brief Checks whether the log is open.
+     *
+     * @return bool True if open.
+     */
+    bool isOpen() const;
+
+    /**
+     * @brief Assigns the next sequence number to a record and queues it.
+     *
+     * Returns without waiting for the disk; the record is durable once the
+     * flusher's next batch has been synced (see waitFor()).
+     *
+     * @param record The record; its sequence field is set.
+     */
+    void append(MutationRecord& record);
+
+    /**
+     * @brief Waits until a record has been written and synced.
+     *
+     * The flusher starts its batch at once instead of waiting for more
+     * records, and records queued meanwhile by other threads share it.
+     *
+     * @param sequence The record's sequence number.
+     * @return bool False if a write or fsync has failed.
+     */
+    bool waitFor(uint64_t sequence);
+
+    /**
+     * @brief Waits until every queued record has been written and synced.
+     *
+     * @return bool False if a write or fsync has failed.
+     */
+    bool sync();
+
+    /**
+     * @brief Appends the records a change history does not hold yet to it, and syncs it.
+     *
+     * Records at or below the history's last sequence are not copied
+     * again, so a save cut short by a crash can simply be repeated. A torn
+     * tail left by such a crash is cut off first.
+     *
+     * @param historyFile Path of the history, created if missing.
+     * @return bool True once every record of this log is durable in the history.
+     */
+    bool saveToHistory(const std::string& historyFile);
+
+    /**
+     * @brief Empties the log after its records were saved to the history and a snapshot.
+     *
+     * The file is truncated and rewritten through the descriptor already
+     * open, so the log is never left without one.
+     *
+     * @param baseSequence Last sequence contained in the new snapshot.
+     * @return bool True on success.
+     */
+    bool reset(uint64_t baseSequence);
+
+    /**
+     * @brief Returns the size of the log, including queued records.
+     *
+     * @return uint64_t The size in bytes.
+     */
+    uint64_t getSize();
+};
+
+#endif // MUTATION_LOG_H
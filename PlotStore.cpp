@@ -0,0 +1,274 @@
+/***************************************************************************
+ * PlotStore.cpp
+ *
+ * Team:            Gearoid, Cedric
+ * Group:           1
+ * Student IDs:     S10241866, S10241549
+ *
+ * Features Highlight:
+ *   - Deferred plot entries that point at a byte range in movies.csv.
+ *   - On-demand reads through a single cached file stream.
+ *   - Bulk copies of deferred plots through a mapping of the source file.
+ *   - Separate cold StringArena for plot text.
+ ***************************************************************************/
+
+#include "PlotStore.h"
+#include "CsvScanner.h"
+#include <iostream>
+
+ /**
+  * @brief Constructs a store whose reference 0 is the empty plot.
+  */
+PlotStore::PlotStore()
+    : entries(new Entry[2000]),
+    count(0),
+    capacity(2000),
+    sources(new std::string[4]),
+    sourceCount(0),
+    sourceCapacity(4),
+    readerSource(-1),
+    loadedFromDisk(0),
+    copySource(-1)
+{
+    Entry empty = { 0, 0, -1, true, false, coldArena.intern("") };
+    addEntry(empty);
+}
+
+/**
+ * @brief Destructor.
+ */
+PlotStore::~PlotStore() {
+    delete[] entries;
+    delete[] sources;
+}
+
+/**
+ * @brief Returns the process-wide plot store.
+ *
+ * @return PlotStore& The shared store.
+ */
+PlotStore& PlotStore::shared() {
+    static PlotStore store;
+    return store;
+}
+
+/**
+ * @brief Appends an entry, doubling the entry array when it is full.
+ *
+ * @param e The entry to append.
+ * @return int The new plot reference.
+ */
+int PlotStore::addEntry(const Entry& e) {
+    if (count >= capacity) {
+        int newCapacity = capacity * 2;
+        Entry* newArr = new Entry[newCapacity];
+        for (int i = 0; i < count; ++i) {
+            newArr[i] = entries[i];
+        }
+        delete[] entries;
+        entries = newArr;
+        capacity = newCapacity;
+    }
+    entries[count] = e;
+    return count++;
+}
+
+/**
+ * @brief Registers a source file for deferred plots.
+ *
+ * @param filename Path of the file.
+ * @return int The source index.
+ */
+int PlotStore::addSource(const std::string& filename) {
+    for (int i = 0; i < sourceCount; ++i) {
+        if (sources[i] == filename) {
+            return i;
+        }
+    }
+    if (sourceCount >= sourceCapacity) {
+        int newCapacity = sourceCapacity * 2;
+        std::string* newArr = new std::string[newCapacity];
+        for (int i = 0; i < sourceCount; ++i) {
+            newArr[i] = sources[i];
+        }
+        delete[] sources;
+        sources = newArr;
+        sourceCapacity = newCapacity;
+    }
+    sources[sourceCount] = filename;
+    return sourceCount++;
+}
+
+/**
+ * @brief Records the location of a plot without reading it.
+ *
+ * @param source Source file index.
+ * @param offset Byte offset of the plot.
+ * @param length Plot length in bytes.
+ * @param escaped Whether "" escapes must be collapsed on load.
+ * @return int The plot reference.
+ */
+int PlotStore::addDeferred(int source, long long offset, int length, bool escaped) {
+    if (length <= 0) {
+        return 0;
+    }
+    Entry e = { offset, length, static_cast<short>(source), false, escaped, { 0, 0 } };
+    return addEntry(e);
+}
+
+/**
+ * @brief Stores plot text in the cold arena right away.
+ *
+ * @param text The plot text.
+ * @return int The plot reference.
+ */
+int PlotStore::addText(const char* text) {
+    if (!text || text[0] == '\0') {
+        return 0;
+    }
+    Entry e = { 0, 0, -1, true, false, coldArena.intern(text) };
+    e.length = static_cast<int>(e.text.length);
+    return addEntry(e);
+}
+
+/**
+ * @brief Returns plot text, loading deferred plots from their source file.
+ *
+ * The reader stays open on the last file used, so displaying many plots from
+ * movies.csv costs one seek and one read each.
+ *
+ * @param ref The plot reference.
+ * @return const char* The plot text, or "" if it is unknown or unreadable.
+ */
+const char* PlotStore::get(int ref) {
+    if (ref <= 0 || ref >= count) {
+        return "";
+    }
+    Entry& e = entries[ref];
+    if (!e.loaded) {
+        if (readerSource != e.source) {
+            if (reader.is_open()) {
+                reader.close();
+            }
+            reader.clear();
+            reader.open(sources[e.source].c_str(), std::ios::binary);
+            readerSource = e.source;
+        }
+        char* buffer = new char[e.length];
+        reader.clear();
+        reader.seekg(e.offset);
+        reader.read(buffer, e.length);
+        if (!reader) {
+            std::cerr << "[Error] Could not read plot from " << sources[e.source] << "\n";
+            delete[] buffer;
+            return "";
+        }
+        if (e.escaped) {
+            std::string unescaped;
+            CsvScanner::unescape(std::string_view(buffer, static_cast<size_t>(e.length)), unescaped);
+            e.text = coldArena.intern(unescaped.c_str(), unescaped.size());
+        }
+        else {
+            e.text = coldArena.intern(buffer, static_cast<size_t>(e.length));
+        }
+        e.loaded = true;
+        ++loadedFromDisk;
+        delete[] buffer;
+    }
+    return coldArena.resolve(e.text);
+}
+
+/**
+ * @brief Appends plot text to a string, copying deferred plots from their mapped source.
+ *
+ * @param ref The plot reference.
+ * @param out Receives the text.
+ * @return bool True on success; false if the source cannot be read.
+ */
+bool PlotStore::appendTo(int ref, std::string& out) {
+    if (ref <= 0 || ref >= count) {
+        return true;
+    }
+    const Entry& e = entries[ref];
+    if (e.loaded) {
+        out.append(coldArena.resolve(e.text), e.text.length);
+        return true;
+    }
+    if (copySource != e.source) {
+        copyFile.close();
+        copySource = copyFile.open(sources[e.source]) ? e.source : -1;
+    }
+    if (copySource == -1 || static_cast<unsigned long long>(e.offset) + e.length > copyFile.size()) {
+        std::cerr << "[Error] Could not read plot from " << sources[e.source] << "\n";
+        return false;
+    }
+    std::string_view bytes(copyFile.data() + e.offset, static_cast<size_t>(e.length));
+    if (e.escaped) {
+        CsvScanner::unescape(bytes, out);
+    }
+    else {
+        out.append(bytes.data(), bytes.size());
+    }
+    return true;
+}
+
+/**
+ * @brief Points a deferred plot at a new, unescaped copy of its text.
+ *
+ * Empty plots are moved as well, so no entry keeps an offset into the
+ * file that was replaced.
+ *
+ * @param ref The plot reference.
+ * @param source The new source index.
+ * @param offset Byte offset of the text in the new source.
+ * @param length Length of the text in the new source.
+ */
+void PlotStore::relocate(int ref, int source, long long offset, int length) {
+    if (ref <= 0 || ref >= count || entries[ref].loaded || length < 0) {
+        return;
+    }
+    Entry& e = entries[ref];
+    e.source = static_cast<short>(source);
+    e.offset = offset;
+    e.length = length;
+    e.escaped = false;
+}
+
+/**
+ * @brief Closes the reader and the copy mapping so their source file can be replaced.
+ */
+void PlotStore::closeReader() {
+    if (reader.is_open()) {
+        reader.close();
+    }
+    readerSource = -1;
+    copyFile.close();
+    copySource = -1;
+}
+
+/**
+ * @brief Returns the number of plot references handed out.
+ *
+ * @return int The entry count.
+ */
+int PlotStore::size() const {
+    return count;
+}
+
+/**
+ * @brief Returns how many deferred plots have been read from disk.
+ *
+ * @return int The lazy load count.
+ */
+int PlotStore::getLoadedCount() const {
+    return loadedFromDisk;
+}
+
+/**
+ * @brief Returns the bytes of plot text held in memory.
+ *
+ * @return unsigned long long The cold arena's used bytes.
+ */
+unsigned long long PlotStore::getBytesInMemory() const {
+    return coldArena.getBytesUsed();
+}
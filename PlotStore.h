@@ -0,0 +1,185 @@
+#ifndef PLOT_STORE_H
+#define PLOT_STORE_H
+
+#include "StringArena.h"
+#include "MappedFile.h"
+#include <fstream>
+#include <string>
+
+/***************************************************************************
+ * PlotStore.h
+ *
+ * Team:            Gearoid, Cedric
+ * Group:           1
+ * Student IDs:     S10241866, S10241549
+ *
+ * Features Highlight:
+ *   - Cold storage for movie plots, kept apart from the hot Movie record.
+ *   - Plots loaded from a CSV file are remembered as a byte range in that file
+ *     and only read from disk the first time they are displayed.
+ *   - Plots entered through the admin menu go straight into a separate cold
+ *     StringArena, so plot text never mixes with names and titles.
+ *   - Writers of the snapshot, image and archive copy plots straight from
+ *     the source file (appendTo()) without loading them, and a new snapshot
+ *     becomes the source of every plot that is still on disk (relocate()).
+ *
+ ***************************************************************************/
+
+ /**
+  * @brief Lazily loaded store of movie plots, addressed by an integer plot reference.
+  *
+  * Movie records hold only the reference. Reference 0 is always the empty plot.
+  * References are immutable: changing a movie's plot creates a new reference.
+  */
+class PlotStore {
+private:
+    /**
+     * @brief Location and load state of a single plot.
+     */
+    struct Entry {
+        long long offset;      ///< Byte offset of the plot in its source file.
+        int length;            ///< Length in bytes.
+        short source;          ///< Index into sources, or -1 for text added directly.
+        bool loaded;           ///< True once the text is in the cold arena.
+        bool escaped;          ///< True if the source bytes contain CSV "" escapes.
+        StringHandle text;     ///< Handle into coldArena (valid when loaded).
+    };
+
+    Entry* entries;            ///< Plot entries indexed by plot reference.
+    int count;                 ///< Number of entries.
+    int capacity;              ///< Allocated size of entries.
+
+    std::string* sources;      ///< Source file names.
+    int sourceCount;           ///< Number of registered source files.
+    int sourceCapacity;        ///< Allocated size of sources.
+
+    StringArena coldArena;     ///< Storage for plots that have been loaded or entered.
+    std::ifstream reader;      ///< Reader kept open on the most recently used source.
+    int readerSource;          ///< Source index the reader is open on, or -1.
+    int loadedFromDisk;        ///< Number of deferred plots read so far.
+    MappedFile copyFile;       ///< Mapping of the source appendTo() last copied from.
+    int copySource;            ///< Source index copyFile maps, or -1.
+
+    /**
+     * @brief Appends an entry and returns its reference.
+     *
+     * @param e The entry to append.
+     * @return int The new plot reference.
+     */
+    int addEntry(const Entry& e);
+
+public:
+    /**
+     * @brief Constructs a store holding only the empty plot.
+     */
+    PlotStore();
+
+    /**
+     * @brief Destructor.
+     */
+    ~PlotStore();
+
+    // Copying is disabled; references are only meaningful in their own store.
+    PlotStore(const PlotStore&) = delete;
+    PlotStore& operator=(const PlotStore&) = delete;
+
+    /**
+     * @brief Returns the store shared by all Movie records.
+     *
+     * @return PlotStore& The process-wide plot store.
+     */
+    static PlotStore& shared();
+
+    /**
+     * @brief Registers a file that deferred plots can be read from.
+     *
+     * Registering the same file twice returns the same index.
+     *
+     * @param filename Path of the file.
+     * @return int The source index.
+     */
+    int addSource(const std::string& filename);
+
+    /**
+     * @brief Records a plot that lives in a source file without reading it.
+     *
+     * @param source Index returned by addSource().
+     * @param offset Byte offset of the first plot character.
+     * @param length Number of bytes.
+     * @param escaped True if the bytes are quoted CSV text with "" escapes.
+     * @return int The plot reference (0 if length is 0).
+     */
+    int addDeferred(int source, long long offset, int length, bool escaped = false);
+
+    /**
+     * @brief Stores plot text directly in the cold arena.
+     *
+     * @param text The plot (nullptr or "" gives reference 0).
+     * @return int The plot reference.
+     */
+    int addText(const char* text);
+
+    /**
+     * @brief Returns the text of a plot, reading it from disk on first use.
+     *
+     * @param ref The plot reference.
+     * @return const char* The plot text ("" if it cannot be read).
+     */
+    const char* get(int ref);
+
+    /**
+     * @brief Appends the text of a plot to a string without loading it into the store.
+     *
+     * A deferred plot is copied from its mapped source file (with CSV
+     * escapes collapsed) and stays deferred, so writing a whole catalogue
+     * does not make every plot resident.
+     *
+     * @param ref The plot reference.
+     * @param out Receives the text.
+     * @return bool True unless the plot could not be read.
+     */
+    bool appendTo(int ref, std::string& out);
+
+    /**
+     * @brief Points a plot that is still on disk at a new copy of its text.
+     *
+     * Used once a snapshot holding the text has replaced the file. Plots
+     * already in memory are left alone.
+     *
+     * @param ref The plot reference.
+     * @param source Index returned by addSource() for the new file.
+     * @param offset Byte offset of the text in the new file.
+     * @param length Length of the text in the new file (it holds no CSV escapes).
+     */
+    void relocate(int ref, int source, long long offset, int length);
+
+    /**
+     * @brief Closes the reader and the copy mapping kept open on source files.
+     *
+     * Call before replacing a source file; the next deferred load reopens it.
+     */
+    void closeReader();
+
+    /**
+     * @brief Returns the number of plot references handed out.
+     *
+     * @return int The entry count.
+     */
+    int size() const;
+
+    /**
+     * @brief Returns how many deferred plots have been read from disk.
+     *
+     * @return int The number of lazy loads performed.
+     */
+    int getLoadedCount() const;
+
+    /**
+     * @brief Returns the bytes of plot text currently held in memory.
+     *
+     * @return unsigned long long The cold arena's used bytes.
+     */
+    unsigned long long getBytesInMemory() const;
+};
+
+#endif // PLOT_STORE_H
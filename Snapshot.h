@@ -0,0 +1,95 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <cstdint>
+
+/***************************************************************************
+ * Snapshot.h
+ *
+ * Team:            Gearoid, Cedric
+ * Group:           1
+ * Student IDs:     S10241866, S10241549
+ *
+ * Features Highlight:
+ *   - On-disk layout of a MovieApp snapshot (see MovieApp::saveSnapshot).
+ *   - Fixed-size records and a single text section addressed by offsets,
+ *     so the file contains no pointers and can be mapped and read in place.
+ *   - A magic number and version let loadSnapshot reject foreign or older
+ *     files; the CSV files remain the interchange format.
+ *   - Records the last MutationLog sequence folded into it, so replaying
+ *     the log on top of the snapshot skips changes it already contains.
+ *
+ *   File layout (native little-endian, every section 8-byte aligned):
+ *     SnapshotHeader
+ *     SnapshotActor[actorCount]     in dense ID order
+ *     SnapshotMovie[movieCount]     in dense ID order
+ *     SnapshotLink[linkCount]       movie by movie, in cast order
+ *     text                          names, keys, titles and plots
+ *
+ ***************************************************************************/
+
+/// "DSAS" read as a little-endian 32-bit integer.
+static const uint32_t SNAPSHOT_MAGIC = 0x53415344u;
+
+/// Bumped whenever a record layout or the collation key folding changes.
+static const uint32_t SNAPSHOT_VERSION = 3;
+
+/**
+ * @brief Fixed-size header at offset 0 of a snapshot file.
+ */
+struct SnapshotHeader {
+    uint32_t magic;          ///< SNAPSHOT_MAGIC.
+    uint32_t version;        ///< SNAPSHOT_VERSION.
+    uint32_t actorCount;     ///< Number of SnapshotActor records.
+    uint32_t movieCount;     ///< Number of SnapshotMovie records.
+    uint32_t linkCount;      ///< Number of SnapshotLink records.
+    int32_t nextActorId;     ///< MovieApp::nextActorId at save time.
+    int32_t nextMovieId;     ///< MovieApp::nextMovieId at save time.
+    uint32_t reserved;       ///< Zero; keeps the offsets 8-byte aligned.
+    uint64_t actorsOffset;   ///< File offset of the actor records.
+    uint64_t moviesOffset;   ///< File offset of the movie records.
+    uint64_t linksOffset;    ///< File offset of the cast links.
+    uint64_t textOffset;     ///< File offset of the text section.
+    uint64_t textBytes;      ///< Size of the text section.
+    uint64_t logSequence;    ///< Last mutation log sequence contained in the snapshot.
+};
+
+/**
+ * @brief One actor. Text offsets are relative to the text section.
+ */
+struct SnapshotActor {
+    int32_t id;              ///< Actor ID.
+    int32_t birthYear;       ///< Birth year.
+    int32_t rating;          ///< Rating (0 = unrated).
+    uint32_t nameOffset;     ///< Offset of the name.
+    uint32_t nameLength;     ///< Length of the name.
+    uint32_t keyOffset;      ///< Offset of the name's collation key.
+    uint32_t keyLength;      ///< Length of the collation key.
+    uint32_t reserved;       ///< Zero; pads the record to 32 bytes.
+};
+
+/**
+ * @brief One movie. Text offsets are relative to the text section.
+ */
+struct SnapshotMovie {
+    int32_t id;              ///< Movie ID.
+    int32_t releaseYear;     ///< Release year.
+    int32_t rating;          ///< Rating (0 = unrated).
+    uint32_t titleOffset;    ///< Offset of the title.
+    uint32_t titleLength;    ///< Length of the title.
+    uint32_t keyOffset;      ///< Offset of the title's collation key.
+    uint32_t keyLength;      ///< Length of the collation key.
+    uint32_t plotOffset;     ///< Offset of the plot.
+    uint32_t plotLength;     ///< Length of the plot.
+    uint32_t reserved;       ///< Zero; pads the record to 40 bytes.
+};
+
+/**
+ * @brief One cast link, as positions in the actor and movie record arrays.
+ */
+struct SnapshotLink {
+    int32_t actorIndex;      ///< Index into the actor records.
+    int32_t movieIndex;      ///< Index into the movie records.
+};
+
+#endif // SNAPSHOT_H
@@ -0,0 +1,305 @@
+/***************************************************************************
+ * StringArena.cpp
+ *
+ * Team:            Gearoid, Cedric
+ * Group:           1
+ * Student IDs:     S10241866, S10241549
+ *
+ * Features Highlight:
+ *   - Chunked append-only text storage with stable pointers.
+ *   - FNV-1a hashed open-addressing intern table.
+ *   - Footprint counters for memory reporting.
+ ***************************************************************************/
+
+#include "StringArena.h"
+#include <cstring>
+#include <iostream>
+
+ /**
+  * @brief Constructs an empty arena with one chunk and a 1024-slot intern table.
+  */
+StringArena::StringArena()
+    : chunks(new char* [16]),
+    chunkCount(1),
+    chunkCapacity(16),
+    chunkUsed(0),
+    slots(new StringHandle[1024]),
+    slotHashes(new unsigned int[1024]),
+    slotCapacity(1024),
+    stringCount(0),
+    slotGrowCount(0),
+    usedBytes(0),
+    requestedBytes(0)
+{
+    chunks[0] = new char[CHUNK_SIZE];
+    for (int i = 0; i < slotCapacity; ++i) {
+        slots[i].offset = 0;
+        slots[i].length = 0;
+    }
+}
+
+/**
+ * @brief Destructor.
+ */
+StringArena::~StringArena() {
+    for (int i = 0; i < chunkCount; ++i) {
+        delete[] chunks[i];
+    }
+    delete[] chunks;
+    delete[] slots;
+    delete[] slotHashes;
+}
+
+/**
+ * @brief Returns the process-wide arena used by Actor and Movie.
+ *
+ * @return StringArena& The shared arena.
+ */
+StringArena& StringArena::shared() {
+    static StringArena arena;
+    return arena;
+}
+
+/**
+ * @brief Computes the FNV-1a hash of a byte range.
+ *
+ * @param s Pointer to the first byte.
+ * @param len Number of bytes.
+ * @return unsigned int The hash value.
+ */
+unsigned int StringArena::hashBytes(const char* s, unsigned int len) {
+    unsigned int h = 2166136261u;
+    for (unsigned int i = 0; i < len; ++i) {
+        h ^= static_cast<unsigned char>(s[i]);
+        h *= 16777619u;
+    }
+    return h;
+}
+
+/**
+ * @brief Copies text (plus a terminator) into the arena.
+ *
+ * Strings never straddle two chunks; when the current chunk cannot hold the
+ * text a fresh chunk is started and the tail of the old one is left unused.
+ * No chunk is started past MAX_CHUNKS, because its offsets would wrap.
+ *
+ * @param s Pointer to the text.
+ * @param len Number of bytes.
+ * @return StringHandle Handle to the stored copy, or the empty handle if the arena is full.
+ */
+StringHandle StringArena::append(const char* s, unsigned int len) {
+    if (chunkUsed + len + 1 > CHUNK_SIZE) {
+        if (chunkCount >= MAX_CHUNKS) {
+            StringHandle full = { 0, 0 };
+            return full;
+        }
+        if (chunkCount >= chunkCapacity) {
+            int newCapacity = chunkCapacity * 2;
+            char** newChunks = new char* [newCapacity];
+            for (int i = 0; i < chunkCount; ++i) {
+                newChunks[i] = chunks[i];
+            }
+            delete[] chunks;
+            chunks = newChunks;
+            chunkCapacity = newCapacity;
+        }
+        chunks[chunkCount++] = new char[CHUNK_SIZE];
+        chunkUsed = 0;
+    }
+    char* dest = chunks[chunkCount - 1] + chunkUsed;
+    std::memcpy(dest, s, len);
+    dest[len] = '\0';
+
+    StringHandle h;
+    h.offset = static_cast<unsigned int>(chunkCount - 1) * CHUNK_SIZE + chunkUsed;
+    h.length = len;
+    chunkUsed += len + 1;
+    usedBytes += len + 1;
+    return h;
+}
+
+/**
+ * @brief Doubles the intern table and reinserts every stored handle.
+ */
+void StringArena::growSlots() {
+    int newCapacity = slotCapacity * 2;
+    StringHandle* newSlots = new StringHandle[newCapacity];
+    unsigned int* newHashes = new unsigned int[newCapacity];
+    for (int i = 0; i < newCapacity; ++i) {
+        newSlots[i].offset = 0;
+        newSlots[i].length = 0;
+    }
+    unsigned int mask = static_cast<unsigned int>(newCapacity - 1);
+    for (int i = 0; i < slotCapacity; ++i) {
+        if (slots[i].length == 0) continue;
+        unsigned int pos = slotHashes[i] & mask;
+        while (newSlots[pos].length != 0) {
+            pos = (pos + 1) & mask;
+        }
+        newSlots[pos] = slots[i];
+        newHashes[pos] = slotHashes[i];
+    }
+    delete[] slots;
+    delete[] slotHashes;
+    slots = newSlots;
+    slotHashes = newHashes;
+    slotCapacity = newCapacity;
+    ++slotGrowCount;
+}
+
+/**
+ * @brief Interns a null-terminated string.
+ *
+ * @param s The text (nullptr is treated as empty).
+ * @return StringHandle Handle to the interned text.
+ */
+StringHandle StringArena::intern(const char* s) {
+    return intern(s, s ? std::strlen(s) : 0);
+}
+
+/**
+ * @brief Interns a byte range.
+ *
+ * Looks the text up in the intern table first and only appends it to the
+ * arena if no identical string has been stored before.
+ *
+ * @param s Pointer to the text.
+ * @param len Number of bytes.
+ * @return StringHandle Handle to the interned text.
+ */
+StringHandle StringArena::intern(const char* s, size_t len) {
+    StringHandle empty = { 0, 0 };
+    if (!s || len == 0) {
+        return empty;
+    }
+    if (len > CHUNK_SIZE - 1) {
+        len = CHUNK_SIZE - 1;
+    }
+    unsigned int n = static_cast<unsigned int>(len);
+    requestedBytes += n + 1;
+
+    unsigned int h = hashBytes(s, n);
+    unsigned int mask = static_cast<unsigned int>(slotCapacity - 1);
+    unsigned int pos = h & mask;
+    while (slots[pos].length != 0) {
+        if (slotHashes[pos] == h && slots[pos].length == n &&
+            std::memcmp(resolve(slots[pos]), s, n) == 0) {
+            return slots[pos];
+        }
+        pos = (pos + 1) & mask;
+    }
+
+    StringHandle stored = append(s, n);
+    if (stored.length == 0) {
+        std::cerr << "[Error] String storage is full (4 GiB); text was not stored.\n";
+        return empty;
+    }
+    slots[pos] = stored;
+    slotHashes[pos] = h;
+    ++stringCount;
+    // Keep the load factor at or below one half.
+    if (stringCount * 2 > slotCapacity) {
+        growSlots();
+    }
+    return stored;
+}
+
+/**
+ * @brief Looks up a byte range in the intern table without appending it.
+ *
+ * @param s Pointer to the text.
+ * @param len Number of bytes.
+ * @param out Receives the stored handle on success.
+ * @return bool True if the text has been interned before.
+ */
+bool StringArena::find(const char* s, size_t len, StringHandle& out) const {
+    if (!s || len == 0) {
+        out.offset = 0;
+        out.length = 0;
+        return true;
+    }
+    if (len > CHUNK_SIZE - 1) {
+        len = CHUNK_SIZE - 1;
+    }
+    unsigned int n = static_cast<unsigned int>(len);
+    unsigned int h = hashBytes(s, n);
+    unsigned int mask = static_cast<unsigned int>(slotCapacity - 1);
+    unsigned int pos = h & mask;
+    while (slots[pos].length != 0) {
+        if (slotHashes[pos] == h && slots[pos].length == n &&
+            std::memcmp(resolve(slots[pos]), s, n) == 0) {
+            out = slots[pos];
+            return true;
+        }
+        pos = (pos + 1) & mask;
+    }
+    return false;
+}
+
+/**
+ * @brief Converts a handle into a C-string.
+ *
+ * @param h The handle.
+ * @return const char* The stored text, or "" for an empty handle.
+ */
+const char* StringArena::resolve(StringHandle h) const {
+    if (h.length == 0) {
+        return "";
+    }
+    return chunks[h.offset / CHUNK_SIZE] + (h.offset % CHUNK_SIZE);
+}
+
+/**
+ * @brief Returns the number of distinct strings stored.
+ *
+ * @return int The distinct string count.
+ */
+int StringArena::getStringCount() const {
+    return stringCount;
+}
+
+/**
+ * @brief Returns the bytes of text stored, including terminators.
+ *
+ * @return unsigned long long The used byte count.
+ */
+unsigned long long StringArena::getBytesUsed() const {
+    return usedBytes;
+}
+
+/**
+ * @brief Returns the bytes reserved by chunks and the intern table.
+ *
+ * @return unsigned long long The reserved byte count.
+ */
+unsigned long long StringArena::getBytesReserved() const {
+    return static_cast<unsigned long long>(chunkCount) * CHUNK_SIZE
+        + static_cast<unsigned long long>(slotCapacity) * (sizeof(StringHandle) + sizeof(unsigned int));
+}
+
+/**
+ * @brief Returns the bytes that callers asked to store, before interning.
+ *
+ * @return unsigned long long The requested byte count.
+ */
+unsigned long long StringArena::getBytesRequested() const {
+    return requestedBytes;
+}
+
+/**
+ * @brief Returns the number of slots in the intern table.
+ *
+ * @return int The slot count.
+ */
+int StringArena::getSlotCapacity() const {
+    return slotCapacity;
+}
+
+/**
+ * @brief Returns how many times the intern table has been doubled.
+ *
+ * @return int The grow count.
+ */
+int StringArena::getSlotGrowCount() const {
+    return slotGrowCount;
+}
@@ -0,0 +1,190 @@
+#ifndef STRING_ARENA_H
+#define STRING_ARENA_H
+
+#include <cstddef>
+
+/***************************************************************************
+ * StringArena.h
+ *
+ * Team:            Gearoid, Cedric
+ * Group:           1
+ * Student IDs:     S10241866, S10241549
+ *
+ * Features Highlight:
+ *   - Append-only storage for actor names and movie titles/plots.
+ *   - Strings are interned: identical text is stored once and shared.
+ *   - Records hold an 8-byte StringHandle (offset + length) instead of a
+ *     fixed-size char buffer, so copying a record copies a handle only.
+ *   - The 32-bit offset caps the arena at 4 GiB (MAX_CHUNKS chunks); text
+ *     that does not fit is refused with an error instead of wrapping.
+ *
+ ***************************************************************************/
+
+ /**
+  * @brief A reference to a string stored in a StringArena.
+  *
+  * A zero length handle always refers to the empty string.
+  */
+struct StringHandle {
+    unsigned int offset;  ///< Byte offset of the first character in the arena.
+    unsigned int length;  ///< Number of characters (excluding the terminator).
+};
+
+/**
+ * @brief Append-only, interning string storage.
+ *
+ * Text is packed into fixed-size chunks that are never moved or freed while
+ * the arena is alive, so pointers returned by resolve() stay valid. Each string
+ * is stored with a trailing '\0' and can therefore be used as a C-string.
+ */
+class StringArena {
+public:
+    static const unsigned int CHUNK_SIZE = 65536;  ///< Bytes per chunk.
+    static const int MAX_CHUNKS = 65536;           ///< Chunks a 32-bit offset can address (4 GiB).
+
+private:
+    char** chunks;              ///< Array of chunk buffers.
+    int chunkCount;             ///< Number of chunks in use.
+    int chunkCapacity;          ///< Allocated size of the chunks array.
+    unsigned int chunkUsed;     ///< Bytes used in the last chunk.
+
+    StringHandle* slots;        ///< Open-addressing intern table (length 0 = empty).
+    unsigned int* slotHashes;   ///< Cached hash of each occupied slot.
+    int slotCapacity;           ///< Number of slots (power of two).
+    int stringCount;            ///< Number of distinct strings stored.
+    int slotGrowCount;          ///< Number of times the intern table has been doubled.
+
+    unsigned long long usedBytes;       ///< Bytes of text stored, terminators included.
+    unsigned long long requestedBytes;  ///< Total bytes passed to intern(), duplicates included.
+
+    /**
+     * @brief Computes the FNV-1a hash of a byte range.
+     *
+     * @param s Pointer to the first byte.
+     * @param len Number of bytes.
+     * @return unsigned int The hash value.
+     */
+    static unsigned int hashBytes(const char* s, unsigned int len);
+
+    /**
+     * @brief Copies a string into the current chunk, starting a new chunk if needed.
+     *
+     * @param s Pointer to the text.
+     * @param len Number of bytes (at least 1).
+     * @return StringHandle Handle to the stored copy, or the empty handle if
+     *         the arena is full.
+     */
+    StringHandle append(const char* s, unsigned int len);
+
+    /**
+     * @brief Doubles the intern table and reinserts every handle.
+     */
+    void growSlots();
+
+public:
+    /**
+     * @brief Constructs an empty arena.
+     */
+    StringArena();
+
+    /**
+     * @brief Destructor.
+     *
+     * Releases every chunk and the intern table.
+     */
+    ~StringArena();
+
+    // Copying is disabled; handles are only meaningful in their own arena.
+    StringArena(const StringArena&) = delete;
+    StringArena& operator=(const StringArena&) = delete;
+
+    /**
+     * @brief Returns the arena shared by all Actor and Movie records.
+     *
+     * @return StringArena& The process-wide arena.
+     */
+    static StringArena& shared();
+
+    /**
+     * @brief Stores a C-string, or returns the handle of an identical stored string.
+     *
+     * @param s The null-terminated text (nullptr is treated as empty).
+     * @return StringHandle Handle to the interned text.
+     */
+    StringHandle intern(const char* s);
+
+    /**
+     * @brief Stores a byte range, or returns the handle of an identical stored string.
+     *
+     * Text longer than CHUNK_SIZE - 1 bytes is truncated. Once the arena
+     * holds 4 GiB, new text is not stored: an error is printed and the
+     * empty handle is returned.
+     *
+     * @param s Pointer to the text.
+     * @param len Number of bytes.
+     * @return StringHandle Handle to the interned text.
+     */
+    StringHandle intern(const char* s, size_t len);
+
+    /**
+     * @brief Looks up text without storing it.
+     *
+     * @param s Pointer to the text.
+     * @param len Number of bytes.
+     * @param out Receives the handle when the text is already interned.
+     * @return bool True if an identical string is stored in the arena.
+     */
+    bool find(const char* s, size_t len, StringHandle& out) const;
+
+    /**
+     * @brief Converts a handle into a null-terminated C-string.
+     *
+     * @param h The handle to resolve.
+     * @return const char* Pointer to the text (never nullptr).
+     */
+    const char* resolve(StringHandle h) const;
+
+    /**
+     * @brief Returns the number of distinct strings stored.
+     *
+     * @return int The distinct string count.
+     */
+    int getStringCount() const;
+
+    /**
+     * @brief Returns the bytes of text stored, including terminators.
+     *
+     * @return unsigned long long The used byte count.
+     */
+    unsigned long long getBytesUsed() const;
+
+    /**
+     * @brief Returns the bytes reserved by chunks and the intern table.
+     *
+     * @return unsigned long long The reserved byte count.
+     */
+    unsigned long long getBytesReserved() const;
+
+    /**
+     * @brief Returns the bytes that callers asked to store, before interning.
+     *
+     * @return unsigned long long The requested byte count.
+     */
+    unsigned long long getBytesRequested() const;
+
+    /**
+     * @brief Returns the number of slots in the intern table.
+     *
+     * @return int The slot count.
+     */
+    int getSlotCapacity() const;
+
+    /**
+     * @brief Returns how many times the intern table has been doubled.
+     *
+     * @return int The grow count.
+     */
+    int getSlotGrowCount() const;
+};
+
+#endif // STRING_ARENA_H
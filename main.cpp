@@ -16,6 +16,32 @@
 #include <limits>
 #include <string>
 #include <cctype>
+#include <cstdlib>     // For atoi
+#include <filesystem>
+#include <iomanip>
+#include <system_error>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+/// Binary snapshot written after a CSV load (see MovieApp::saveSnapshot).
+static const char* SNAPSHOT_FILE = "movies.snapshot";
+
+/// Catalogue image served in place when started with --image (see MovieApp::openImage).
+static const char* IMAGE_FILE = "movies.image";
+
+/// Compressed catalogue scanned when started with --archive (see MovieApp::openArchive).
+static const char* ARCHIVE_FILE = "movies.archive";
+
+/// Write-ahead log of admin changes, replayed at startup (see MovieApp::openLog).
+static const char* LOG_FILE = "movies.wal";
+
+/// Every checkpointed change, replayed after the CSV files are reloaded (see MovieApp::checkpoint).
+static const char* HISTORY_FILE = "movies.history";
+
+/// How often tail mode checks the CSV files for appended rows (see MovieApp::ingestAppendedRows).
+static const int TAIL_POLL_MILLIS = 1000;
 
  /**
   * @brief Removes leading and trailing whitespace from a string.
@@ -138,22 +164,285 @@ void displayMenu(bool isAdmin) {
     std::cout << "Enter your choice: ";
 }
 
+/**
+ * @brief Checks whether a file derived from the CSV files is newer than all of them.
+ *
+ * @param derived The snapshot, image or archive file.
+ * @param extraSource Another file the derived file is built from, or nullptr.
+ * @param logSource The change log if the derived file includes its changes, or nullptr.
+ * @return true if the file exists and no source file was modified after it.
+ */
+static bool isNewerThanCsv(const char* derived, const char* extraSource = nullptr,
+    const char* logSource = nullptr) {
+    std::error_code ec;
+    std::filesystem::file_time_type saved = std::filesystem::last_write_time(derived, ec);
+    if (ec) {
+        return false;
+    }
+    const char* sources[] = { "actors.csv", "movies.csv", "cast.csv", extraSource, logSource };
+    for (const char* source : sources) {
+        if (source == nullptr) {
+            continue;
+        }
+        std::filesystem::file_time_type modified = std::filesystem::last_write_time(source, ec);
+        if (!ec && modified > saved) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Fills in a load report for a load that did not read the CSV files.
+ *
+ * @param report The report to fill.
+ * @param source Where the data came from ("snapshot", "image" or "archive").
+ * @param timer Started when the load began.
+ * @param startCpu Process CPU time when the load began.
+ * @param startAllocations Allocation count when the load began.
+ * @param app The loaded application.
+ */
+static void finishLoadReport(LoadReport& report, const char* source, const PhaseTimer& timer,
+    double startCpu, unsigned long long startAllocations, const MovieApp& app) {
+    report = LoadReport();
+    report.source = source;
+    timer.stop(report.total);
+    report.total.cpuMillis = processCpuMillis() - startCpu;
+    report.allocations = allocationCount() - startAllocations;
+    report.peakResidentBytes = peakResidentBytes();
+    app.describeTables(report);
+}
+
+/**
+ * @brief Loads the catalogue into memory.
+ *
+ * Uses the snapshot when it is up to date; otherwise reads the CSV files
+ * and saves a new snapshot.
+ *
+ * @param app The application to load.
+ * @param report Receives what the load did.
+ */
+static void loadCatalogue(MovieApp& app, LoadReport& report) {
+    PhaseTimer timer;
+    double startCpu = processCpuMillis();
+    unsigned long long startAllocations = allocationCount();
+    bool loaded = false;
+    if (isNewerThanCsv(SNAPSHOT_FILE)) {
+        std::cout << "Loading data from snapshot...\n";
+        loaded = app.loadSnapshot(SNAPSHOT_FILE);
+    }
+    if (loaded) {
+        finishLoadReport(report, "snapshot", timer, startCpu, startAllocations, app);
+    }
+    else {
+        std::cout << "Loading data from CSV files...\n";
+        app.loadCsvFiles("actors.csv", "movies.csv", "cast.csv", report);
+        app.saveSnapshot(SNAPSHOT_FILE);
+    }
+}
+
+/**
+ * @brief Checks whether a menu option can run while only the archive is open.
+ *
+ * @param choice The menu choice.
+ * @return true for the age and year scans, exit and the mode toggle.
+ */
+static bool servedFromArchive(int choice) {
+    return choice == 8 || choice == 9 || choice == 13 || choice == 19;
+}
+
+/**
+ * @brief Switches an application from scanning the archive to the full catalogue.
+ *
+ * Called the first time an option needs more than the archive has.
+ *
+ * @param app The application serving the archive.
+ */
+static void leaveArchive(MovieApp& app) {
+    std::cout << "Loading the full catalogue for this option...\n";
+    app.closeArchive();
+    LoadReport report;
+    loadCatalogue(app, report);
+    app.openLog(LOG_FILE, HISTORY_FILE, SNAPSHOT_FILE);
+}
+
+/**
+ * @brief State shared between the menu loop and the tail thread.
+ */
+struct TailState {
+    std::mutex appLock;                ///< Held while the tail thread or a menu call uses the app.
+    std::condition_variable wake;      ///< Signalled to stop the tail thread.
+    bool stopping = false;             ///< Tells the tail thread to exit.
+};
+
+/**
+ * @brief Makes one MovieApp call while holding the app lock.
+ *
+ * The menu holds the lock only for the call itself, never while waiting
+ * for input, so the tail thread is not blocked by an open prompt. Names
+ * and titles resolve through the shared StringArena, which the tail thread
+ * can reallocate, so anything that reads them must run inside the call.
+ *
+ * @param state The shared lock.
+ * @param call The call to make.
+ */
+template <typename Call>
+static void whileLocked(TailState& state, Call call) {
+    std::lock_guard<std::mutex> guard(state.appLock);
+    call();
+}
+
+/**
+ * @brief Body of the tail thread: ingests appended CSV rows until stopped.
+ *
+ * @param app The application to update.
+ * @param state The shared lock and stop flag.
+ */
+static void tailLoop(MovieApp& app, TailState& state) {
+    std::unique_lock<std::mutex> guard(state.appLock);
+    while (!state.stopping) {
+        state.wake.wait_for(guard, std::chrono::milliseconds(TAIL_POLL_MILLIS));
+        if (state.stopping) {
+            break;
+        }
+        IngestStats stats;
+        if (app.ingestAppendedRows(stats)) {
+            std::cout << std::fixed << std::setprecision(0)
+                << "\n[Tail] Ingested " << (stats.actorRows + stats.movieRows + stats.castRows)
+                << " rows (" << stats.actorRows << " actors, " << stats.movieRows << " movies, "
+                << stats.castRows << " cast) at " << stats.rowsPerSecond << " rows/s, lag "
+                << stats.lagMillis << " ms\n";
+            std::cout.unsetf(std::ios::floatfield);
+            std::cout << std::setprecision(6) << std::flush;
+        }
+    }
+}
+
 /**
  * @brief Main function to run the Movie Management System.
  *
- * Initializes the application, loads data from CSV files, sets the mode (admin/user),
- * and continuously displays the menu to handle user inputs until exit.
+ * Initializes the application and loads the catalogue. With --image, queries
+ * are served from the memory-mapped catalogue image instead (it is rebuilt
+ * first if any CSV file is newer). With --archive, the age and year scans
+ * run on the compressed catalogue archive and the full catalogue is only
+ * loaded once another option is chosen. Then sets the mode (admin/user) and
+ * continuously displays the menu to handle user inputs until exit. With
+ * --tail, a background thread ingests rows appended to the CSV files while
+ * the menu runs.
  *
+ * @param argc Number of command-line arguments.
+ * @param argv Command-line arguments; "--image" selects image mode,
+ *             "--archive" selects archive mode (ignored with "--image" or
+ *             "--tail"),
+ *             "--load-report" prints what the load did (rows, rejects,
+ *             stage timings, memory and table sizes), "--load-report-json
+ *             FILE" writes the same report as JSON and "--tail" follows the
+ *             CSV files for appended rows. "--timings" is an older name for
+ *             "--load-report". "--bench-graph [ROUNDS]" loads the
+ *             catalogue, times the actor graph build (see
+ *             MovieApp::benchmarkActorGraph) and exits.
  * @return Exit status of the application.
  */
-int main() {
+int main(int argc, char* argv[]) {
     MovieApp app;
-    std::cout << "Loading data from CSV files...\n";
-    app.readActors("actors.csv");
-    app.readMovies("movies.csv");
-    app.readCast("cast.csv");
+    bool serveImage = false;
+    bool serveArchive = false;
+    bool showReport = false;
+    std::string reportJsonPath;
+    bool followCsv = false;
+    int benchRounds = 0;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--image") {
+            serveImage = true;
+        }
+        else if (arg == "--archive") {
+            serveArchive = true;
+        }
+        else if (arg == "--load-report" || arg == "--timings") {
+            showReport = true;
+        }
+        else if (arg == "--load-report-json" && i + 1 < argc) {
+            reportJsonPath = argv[++i];
+        }
+        else if (arg == "--tail") {
+            followCsv = true;
+        }
+        else if (arg == "--bench-graph") {
+            benchRounds = 3;
+            if (i + 1 < argc && std::atoi(argv[i + 1]) > 0) {
+                benchRounds = std::atoi(argv[++i]);
+            }
+        }
+    }
+    if (benchRounds > 0) {
+        // The benchmark needs the tables, so the other serving modes are ignored.
+        LoadReport report;
+        loadCatalogue(app, report);
+        app.benchmarkActorGraph(benchRounds);
+        return 0;
+    }
+    LoadReport report;
+    if (serveImage) {
+        // A checkpoint may have folded logged changes into a newer snapshot.
+        if (!isNewerThanCsv(IMAGE_FILE, SNAPSHOT_FILE)) {
+            MovieApp builder;
+            loadCatalogue(builder, report);
+            std::cout << "Writing catalogue image...\n";
+            builder.writeImage(IMAGE_FILE);
+        }
+        std::cout << "Serving data from catalogue image...\n";
+        PhaseTimer timer;
+        double startCpu = processCpuMillis();
+        unsigned long long startAllocations = allocationCount();
+        serveImage = app.openImage(IMAGE_FILE);
+        if (serveImage && report.source.empty()) {
+            finishLoadReport(report, "image", timer, startCpu, startAllocations, app);
+        }
+    }
+    serveArchive = serveArchive && !serveImage && !followCsv;
+    if (serveArchive) {
+        // The archive has no overlay, so it must already include the logged changes.
+        if (!isNewerThanCsv(ARCHIVE_FILE, SNAPSHOT_FILE, LOG_FILE)) {
+            MovieApp builder;
+            loadCatalogue(builder, report);
+            builder.openLog(LOG_FILE, HISTORY_FILE, SNAPSHOT_FILE);
+            std::cout << "Writing catalogue archive...\n";
+            builder.writeArchive(ARCHIVE_FILE);
+        }
+        std::cout << "Scanning data from catalogue archive...\n";
+        PhaseTimer timer;
+        double startCpu = processCpuMillis();
+        unsigned long long startAllocations = allocationCount();
+        serveArchive = app.openArchive(ARCHIVE_FILE);
+        if (serveArchive && report.source.empty()) {
+            finishLoadReport(report, "archive", timer, startCpu, startAllocations, app);
+        }
+    }
+    if (!serveImage && !serveArchive) {
+        loadCatalogue(app, report);
+    }
+    if (showReport) {
+        report.print(std::cout);
+    }
+    if (!reportJsonPath.empty()) {
+        report.writeJson(reportJsonPath);
+    }
+    // In archive mode the log is opened when the full catalogue is loaded.
+    int replayed = serveArchive ? 0 : app.openLog(LOG_FILE, HISTORY_FILE, SNAPSHOT_FILE);
+    if (replayed > 0) {
+        std::cout << "Replayed " << replayed << " logged changes.\n";
+    }
     std::cout << "Data loaded successfully.\n";
 
+    TailState tail;
+    std::thread tailThread;
+    if (followCsv) {
+        app.followCsvFiles("actors.csv", "movies.csv", "cast.csv");
+        tailThread = std::thread(tailLoop, std::ref(app), std::ref(tail));
+        std::cout << "Following CSV files for appended rows.\n";
+    }
+
     // Admin Mode Setup
     std::cout << "Enter admin mode? (y/n): ";
     char adminChoice;
@@ -193,6 +482,11 @@ int main() {
         }
         std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
 
+        // The app lock is taken around each MovieApp call below, not while
+        // prompting, so the tail thread keeps ingesting during a prompt.
+        if (app.isServingArchive() && !servedFromArchive(choice)) {
+            whileLocked(tail, [&] { leaveArchive(app); });
+        }
         if (app.isAdminMode()) {
             // Admin-specific options.
             switch (choice) {
@@ -207,7 +501,7 @@ int main() {
                     std::cout << "[Cancelled] Returning to main menu.\n";
                     break;
                 }
-                app.addNewActor(name, yearOfBirth);
+                whileLocked(tail, [&] { app.addNewActor(name, yearOfBirth); });
                 std::cout << "[Success] Actor added successfully.\n";
                 break;
             }
@@ -230,7 +524,7 @@ int main() {
                     std::cout << "[Cancelled] Returning to main menu.\n";
                     break;
                 }
-                app.addNewMovie(title, plot, releaseYear);
+                whileLocked(tail, [&] { app.addNewMovie(title, plot, releaseYear); });
                 std::cout << "[Success] Movie added successfully.\n";
                 break;
             }
@@ -245,7 +539,7 @@ int main() {
                     std::cout << "[Cancelled] Returning to main menu.\n";
                     break;
                 }
-                app.addActorToMovieById(actorId, movieId, true);
+                whileLocked(tail, [&] { app.addActorToMovieById(actorId, movieId, true); });
                 break;
             }
             case 4: {
@@ -264,7 +558,7 @@ int main() {
                     std::cout << "[Cancelled] Returning to main menu.\n";
                     break;
                 }
-                app.updateActorDetails(actorId, newName, newYOB);
+                whileLocked(tail, [&] { app.updateActorDetails(actorId, newName, newYOB); });
                 break;
             }
             case 5: {
@@ -291,7 +585,7 @@ int main() {
                     std::cout << "[Cancelled] Returning to main menu.\n";
                     break;
                 }
-                app.updateMovieDetails(movieId, newTitle, newPlot, newYear);
+                whileLocked(tail, [&] { app.updateMovieDetails(movieId, newTitle, newPlot, newYear); });
                 break;
             }
             case 19: {
@@ -312,10 +606,10 @@ int main() {
             // User-specific options.
             switch (choice) {
             case 6:
-                app.displayAllActors();
+                whileLocked(tail, [&] { app.displayAllActors(); });
                 break;
             case 7:
-                app.displayAllMovies();
+                whileLocked(tail, [&] { app.displayAllMovies(); });
                 break;
             case 8: {
                 int minAge = promptForInt("Enter minimum age (1-120, '0' to cancel): ", 1, 120, true);
@@ -328,11 +622,11 @@ int main() {
                     std::cout << "[Cancelled] Returning to main menu.\n";
                     break;
                 }
-                app.displayActorsByAge(minAge, maxAge);
+                whileLocked(tail, [&] { app.displayActorsByAge(minAge, maxAge); });
                 break;
             }
             case 9:
-                app.displayRecentMovies();
+                whileLocked(tail, [&] { app.displayRecentMovies(); });
                 break;
             case 10: {
                 std::string inputName = promptForString("Enter actor name (type 'exit' to cancel): ");
@@ -340,13 +634,34 @@ int main() {
                     std::cout << "[Cancelled] Returning to main menu.\n";
                     break;
                 }
-                List<Actor> matchedActors;
-                app.findActorsByName(inputName, matchedActors);
-
+                // Names resolve through the shared StringArena, which the tail
+                // thread grows, so the matches are read and printed under the
+                // lock and only their IDs are kept for the prompt.
+                static const int MAX_ACTORS = 50;
+                int candidateIds[MAX_ACTORS];
                 int matchCount = 0;
-                matchedActors.forEach([&](const Actor& a) {
-                    matchCount++;
-                    return false;
+                int idx = 0;
+                whileLocked(tail, [&] {
+                    List<Actor> matchedActors;
+                    app.findActorsByName(inputName, matchedActors);
+                    matchedActors.forEach([&](const Actor& a) {
+                        matchCount++;
+                        if (idx < MAX_ACTORS) {
+                            candidateIds[idx++] = a.getId();
+                        }
+                        return false;
+                        });
+                    if (matchCount > 1) {
+                        std::cout << "[Info] Multiple actors found with the name \"" << inputName << "\":\n";
+                        int listed = 0;
+                        matchedActors.forEach([&](const Actor& a) {
+                            std::cout << "  ID=" << a.getId()
+                                << ", Name=" << a.getName()
+                                << ", BirthYear=" << a.getBirthYear()
+                                << ", Rating=" << a.getRating() << "\n";
+                            return ++listed >= MAX_ACTORS;
+                            });
+                    }
                     });
 
                 if (matchCount == 0) {
@@ -354,30 +669,10 @@ int main() {
                     break;
                 }
                 else if (matchCount == 1) {
-                    int actorId = 0;
-                    matchedActors.forEach([&](const Actor& a) {
-                        actorId = a.getId();
-                        return true;
-                        });
-                    app.displayMoviesOfActor(actorId);
+                    int actorId = candidateIds[0];
+                    whileLocked(tail, [&] { app.displayMoviesOfActor(actorId); });
                 }
                 else {
-                    std::cout << "[Info] Multiple actors found with the name \"" << inputName << "\":\n";
-                    static const int MAX_ACTORS = 50;
-                    Actor actorArray[MAX_ACTORS];
-                    int idx = 0;
-                    matchedActors.forEach([&](const Actor& a) {
-                        if (idx < MAX_ACTORS) {
-                            actorArray[idx++] = a;
-                        }
-                        return false;
-                        });
-                    for (int i = 0; i < idx; i++) {
-                        std::cout << "  ID=" << actorArray[i].getId()
-                            << ", Name=" << actorArray[i].getName()
-                            << ", BirthYear=" << actorArray[i].getBirthYear()
-                            << ", Rating=" << actorArray[i].getRating() << "\n";
-                    }
                     int chosenId = promptForInt("Enter the correct Actor ID (or '0' to cancel): ", 1, 999999999, true);
                     if (chosenId == 0) {
                         std::cout << "[Cancelled] Returning to main menu.\n";
@@ -385,7 +680,7 @@ int main() {
                     }
                     bool found = false;
                     for (int i = 0; i < idx; i++) {
-                        if (actorArray[i].getId() == chosenId) {
+                        if (candidateIds[i] == chosenId) {
                             found = true;
                             break;
                         }
@@ -394,7 +689,7 @@ int main() {
                         std::cout << "[Error] Invalid Actor ID selected. Returning to main menu.\n";
                         break;
                     }
-                    app.displayMoviesOfActor(chosenId);
+                    whileLocked(tail, [&] { app.displayMoviesOfActor(chosenId); });
                 }
                 break;
             }
@@ -404,7 +699,7 @@ int main() {
                     std::cout << "[Cancelled] Returning to main menu.\n";
                     break;
                 }
-                app.displayActorsInMovie(inputTitle);
+                whileLocked(tail, [&] { app.displayActorsInMovie(inputTitle); });
                 break;
             }
             case 12: {
@@ -413,7 +708,7 @@ int main() {
                     std::cout << "[Cancelled] Returning to main menu.\n";
                     break;
                 }
-                app.displayActorsKnownBy(inputName);
+                whileLocked(tail, [&] { app.displayActorsKnownBy(inputName); });
                 break;
             }
             case 15: {
@@ -427,7 +722,7 @@ int main() {
                     std::cout << "[Cancelled]\n";
                     break;
                 }
-                app.setActorRating(actorId, newRating);
+                whileLocked(tail, [&] { app.setActorRating(actorId, newRating); });
                 break;
             }
             case 16: {
@@ -441,7 +736,7 @@ int main() {
                     std::cout << "[Cancelled]\n";
                     break;
                 }
-                app.setMovieRating(movieId, newRating);
+                whileLocked(tail, [&] { app.setMovieRating(movieId, newRating); });
                 break;
             }
             case 17: {
@@ -455,7 +750,7 @@ int main() {
                     std::cout << "[Cancelled]\n";
                     break;
                 }
-                app.recommendMoviesByRating(minRating, maxRating);
+                whileLocked(tail, [&] { app.recommendMoviesByRating(minRating, maxRating); });
                 break;
             }
             case 18: {
@@ -469,7 +764,7 @@ int main() {
                     std::cout << "[Cancelled]\n";
                     break;
                 }
-                app.recommendActorsByRating(minRating, maxRating);
+                whileLocked(tail, [&] { app.recommendActorsByRating(minRating, maxRating); });
                 break;
             }
             case 13:
@@ -497,5 +792,13 @@ int main() {
         std::cout << std::endl;
     } while (choice != 13);
 
+    if (tailThread.joinable()) {
+        {
+            std::lock_guard<std::mutex> guard(tail.appLock);
+            tail.stopping = true;
+        }
+        tail.wake.notify_all();
+        tailThread.join();
+    }
     return 0;
 }